@@ -1,6 +1,7 @@
 #include <hana/archive/format.hpp>
 
 #include <stdexcept>
+#include <functional>
 
 namespace hana::fmt
 {
@@ -10,10 +11,10 @@ namespace hana::fmt
 	appender write(appender out, T value);
 
 	template<std::integral T> requires(!is_any_of_v<T, char8_t, bool>)
-	appender write(appender out, T value, const basic_format_specs& specs, const std::locale* loc);
+	appender write(appender out, T value, const basic_format_specs& specs, const locale_type* loc);
 
 	template<std::floating_point T>
-	appender write(appender out, T value, const basic_format_specs& specs, const std::locale* loc);
+	appender write(appender out, T value, const basic_format_specs& specs, const locale_type* loc);
 
 	appender write(appender, std::monostate);
 	appender write(appender out, bool value);
@@ -21,12 +22,12 @@ namespace hana::fmt
 	appender write(appender out, const void* value);
 	appender write(appender out, const char8_t* value);
 	appender write(appender out, HStringView value);
-	appender write(appender, std::monostate, const basic_format_specs&, const std::locale*);
-	appender write(appender out, bool value, basic_format_specs specs, const std::locale* loc);
-	appender write(appender out, char8_t value, const basic_format_specs& specs, const std::locale* loc);
-	appender write(appender out, const void* value, const basic_format_specs& specs, const std::locale*);
-	appender write(appender out, const char8_t* value, const basic_format_specs& specs, const std::locale* loc);
-	appender write(appender out, HStringView value, const basic_format_specs& specs, const std::locale*);
+	appender write(appender, std::monostate, const basic_format_specs&, const locale_type*);
+	appender write(appender out, bool value, basic_format_specs specs, const locale_type* loc);
+	appender write(appender out, char8_t value, const basic_format_specs& specs, const locale_type* loc);
+	appender write(appender out, const void* value, const basic_format_specs& specs, const locale_type*);
+	appender write(appender out, const char8_t* value, const basic_format_specs& specs, const locale_type* loc);
+	appender write(appender out, HStringView value, const basic_format_specs& specs, const locale_type*);
 }
 
 namespace hana::fmt
@@ -139,7 +140,7 @@ namespace hana::fmt
 	struct default_arg_formatter {
 		context::iterator out_;
 		format_args args_;
-		const std::locale* loc_;
+		const locale_type* loc_;
 
 		template<typename T>
 		context::iterator operator()(T value) && {
@@ -178,7 +179,7 @@ namespace hana::fmt
 		explicit format_handler(context::iterator out, HStringView str, format_args format_args)
 			: parse_context_(str), ctx_(out, format_args) {}
 
-		explicit format_handler(context::iterator out, HStringView str, format_args format_args, const std::locale* loc)
+		explicit format_handler(context::iterator out, HStringView str, format_args format_args, const locale_type* loc)
 			: parse_context_(str), ctx_(out, format_args, loc) {}
 
 		void on_text(const char8_t* first, const char8_t* last) {
@@ -285,20 +286,81 @@ namespace hana::fmt
 		return format_arg(static_cast<erased_type>(value)).visit(arg_formatter{std::addressof(ctx), std::addressof(format_specs)});
 	}
 
-	HString vformat(HStringView fmt, format_args args, const std::locale* loc) {
+	HString vformat(HStringView fmt, format_args args, const locale_type* loc) {
 		HString out;
 		out.reserve(args.estimate_required_capacity());
-		vformat_to(std::back_inserter(out), *static_cast<const std::locale*>(loc), fmt, args);
+		{
+			auto buf = container_buffer(out);
+			vformat_to(buf, fmt, args, loc);
+		}
 		return out;
 	}
 
-	void vformat_to(buffer& buf, HStringView fmt, format_args args, const std::locale* loc) {
+	// whether the format string or a string argument points into the storage of buf
+	static bool aliases_scratch(const memory_buffer<>& buf, HStringView fmt, const format_args& args) {
+		const char8_t* first = buf.data();
+		const char8_t* last = first + buf.capacity();
+		const auto inside = [&](const char8_t* ptr) {
+			return ptr && !std::less<const char8_t*>{}(ptr, first) && std::less<const char8_t*>{}(ptr, last);
+		};
+
+		if (!fmt.empty() && inside(fmt.data())) {
+			return true;
+		}
+		for (size_t i = 0;; ++i) {
+			const format_arg arg = args.get(i);
+			if (!arg) {
+				return false;
+			}
+			if (arg.active_state_ == Type::string_type && !arg.value_.string_state_.empty() && inside(arg.value_.string_state_.data())) {
+				return true;
+			}
+			if (arg.active_state_ == Type::cstring_type && inside(arg.value_.cstring_state_)) {
+				return true;
+			}
+		}
+	}
+
+	HStringView vformat_scratch(HStringView fmt, format_args args, const locale_type* loc) {
+		// a one-off huge message shouldn't pin its memory to the thread forever
+		constexpr size_t retain_limit = 64 * 1024;
+		// the second buffer is only used when the arguments point into the first, e.g. a view from the previous call
+		thread_local memory_buffer<> scratches[2];
+		thread_local bool busy = false;
+
+		if (busy) {
+			report_error(u8"format_scratch re-entered while the scratch buffer is in use.");
+		}
+
+		struct busy_guard {
+			busy_guard() { busy = true; }
+			~busy_guard() { busy = false; }
+		} guard;
+
+		memory_buffer<>* target = &scratches[0];
+		if (aliases_scratch(scratches[0], fmt, args)) {
+			target = &scratches[1];
+			if (aliases_scratch(scratches[1], fmt, args)) {
+				report_error(u8"format_scratch arguments point into both scratch buffers.");
+			}
+		}
+
+		memory_buffer<>& scratch = *target;
+		if (scratch.capacity() > retain_limit) {
+			scratch = memory_buffer<>();
+		}
+		scratch.clear();
+		vformat_to(scratch, fmt, args, loc);
+		return {scratch.data(), scratch.size()};
+	}
+
+	void vformat_to(buffer& buf, HStringView fmt, format_args args, const locale_type* loc) {
 		auto out = appender{buf};
 		format_handler handler(out, fmt, args, loc);
 		parse_format_string(fmt, handler);
 	}
 
-	std::remove_cvref_t<char8_t*> vformat_to(char8_t* out, HStringView fmt, format_args args, const std::locale* loc) {
+	std::remove_cvref_t<char8_t*> vformat_to(char8_t* out, HStringView fmt, format_args args, const locale_type* loc) {
 		struct char_buffer : buffer {
 			explicit char_buffer(char8_t* out) : buffer([](buffer*, size_t) {}, out, 0, ~size_t()) {}
 		} buf{out};
@@ -307,7 +369,7 @@ namespace hana::fmt
 		return out;
 	}
 
-	format_to_n_result<char8_t*> vformat_to_n(char8_t* out, size_t n, HStringView fmt, format_args args, const std::locale* loc) {
+	format_to_n_result<char8_t*> vformat_to_n(char8_t* out, size_t n, HStringView fmt, format_args args, const locale_type* loc) {
 		struct char_buffer : fixed_buffer_traits, buffer {
 			enum { buffer_size = 256 };
 			char8_t data_[buffer_size] = {};
@@ -355,7 +417,7 @@ namespace hana::fmt
 		return {buf.out(), static_cast<std::iter_difference_t<char8_t*>>(buf.count())};
 	}
 
-	size_t vformatted_size(HStringView fmt, format_args args, const std::locale* loc) {
+	size_t vformatted_size(HStringView fmt, format_args args, const locale_type* loc) {
 		// A buffer that counts the number of code units written discarding the output.
 		struct counting_buffer : buffer {
 			enum { buffer_size = 256 };
@@ -394,3 +456,4 @@ namespace hana::fmt
 }
 
 #include "format/write.hpp"
+#include "format/chrono.hpp"
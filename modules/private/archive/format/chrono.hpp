@@ -0,0 +1,324 @@
+#pragma once
+
+#include <chrono>
+
+namespace hana::fmt
+{
+	// Broken-down calendar fields of the last second rendered on this thread.
+	struct calendar_cache {
+		int64_t day_ = std::numeric_limits<int64_t>::min();
+		int64_t second_ = std::numeric_limits<int64_t>::min();
+		int year_ = 0;
+		unsigned month_ = 0;
+		unsigned mday_ = 0;
+		unsigned wday_ = 0;
+		unsigned yday_ = 0;
+		int64_t hour_ = 0;
+		unsigned minute_ = 0;
+		unsigned sec_ = 0;
+		// "YYYY-MM-DD HH:MM:SS", only valid for years in [0, 9999]
+		char8_t text_[19] = {};
+		bool text_valid_ = false;
+	};
+
+	inline void render_2digits(char8_t* out, unsigned value) {
+		out[0] = static_cast<char8_t>(u8'0' + value / 10);
+		out[1] = static_cast<char8_t>(u8'0' + value % 10);
+	}
+
+	// Monotonic timestamps mostly land in the cached second or day, so only the sub-second digits are new work.
+	inline const calendar_cache& update_calendar_cache(int64_t seconds) {
+		thread_local calendar_cache cache;
+		if (seconds == cache.second_) {
+			return cache;
+		}
+
+		const int64_t day = seconds >= 0 ? seconds / 86400 : (seconds - 86399) / 86400;
+		if (day != cache.day_) {
+			using namespace std::chrono;
+			const sys_days sd{days{day}};
+			const year_month_day ymd{sd};
+			cache.day_ = day;
+			cache.year_ = static_cast<int>(ymd.year());
+			cache.month_ = static_cast<unsigned>(ymd.month());
+			cache.mday_ = static_cast<unsigned>(ymd.day());
+			cache.wday_ = weekday{sd}.c_encoding();
+			cache.yday_ = static_cast<unsigned>((sd - sys_days{ymd.year() / January / 1}).count()) + 1;
+
+			cache.text_valid_ = cache.year_ >= 0 && cache.year_ <= 9999;
+			if (cache.text_valid_) {
+				render_2digits(cache.text_ + 0, static_cast<unsigned>(cache.year_) / 100);
+				render_2digits(cache.text_ + 2, static_cast<unsigned>(cache.year_) % 100);
+				cache.text_[4] = u8'-';
+				render_2digits(cache.text_ + 5, cache.month_);
+				cache.text_[7] = u8'-';
+				render_2digits(cache.text_ + 8, cache.mday_);
+				cache.text_[10] = u8' ';
+			}
+		}
+
+		const int64_t sod = seconds - day * 86400;
+		cache.second_ = seconds;
+		cache.hour_ = sod / 3600;
+		cache.minute_ = static_cast<unsigned>(sod / 60 % 60);
+		cache.sec_ = static_cast<unsigned>(sod % 60);
+		render_2digits(cache.text_ + 11, static_cast<unsigned>(cache.hour_));
+		cache.text_[13] = u8':';
+		render_2digits(cache.text_ + 14, cache.minute_);
+		cache.text_[16] = u8':';
+		render_2digits(cache.text_ + 17, cache.sec_);
+		return cache;
+	}
+
+	inline appender write_padded(appender out, uint64_t value, int width, char8_t pad = u8'0') {
+		char8_t digits[20];
+		int n = 0;
+		do {
+			digits[n++] = static_cast<char8_t>(u8'0' + value % 10);
+			value /= 10;
+		} while (value != 0);
+
+		for (int i = n; i < width; ++i) *out++ = pad;
+		while (n > 0) *out++ = digits[--n];
+		return out;
+	}
+
+	inline appender write_subseconds(appender out, const chrono_value& value) {
+		if (value.digits_ == 0) return out;
+		*out++ = u8'.';
+		return write_padded(out, static_cast<uint64_t>(value.subseconds_), value.digits_);
+	}
+
+	inline appender write_unit_suffix(appender out, intmax_t num, intmax_t den) {
+		const char8_t* suffix = nullptr;
+		if (den == 1) {
+			switch (num) {
+				case 1: suffix = u8"s"; break;
+				case 60: suffix = u8"min"; break;
+				case 3600: suffix = u8"h"; break;
+				case 86400: suffix = u8"d"; break;
+				case 10: suffix = u8"das"; break;
+				case 100: suffix = u8"hs"; break;
+				case 1000: suffix = u8"ks"; break;
+				case 1000000: suffix = u8"Ms"; break;
+				case 1000000000: suffix = u8"Gs"; break;
+				case 1000000000000: suffix = u8"Ts"; break;
+				case 1000000000000000: suffix = u8"Ps"; break;
+				case 1000000000000000000: suffix = u8"Es"; break;
+				default: break;
+			}
+		} else if (num == 1) {
+			switch (den) {
+				case 10: suffix = u8"ds"; break;
+				case 100: suffix = u8"cs"; break;
+				case 1000: suffix = u8"ms"; break;
+				case 1000000: suffix = u8"µs"; break;
+				case 1000000000: suffix = u8"ns"; break;
+				case 1000000000000: suffix = u8"ps"; break;
+				case 1000000000000000: suffix = u8"fs"; break;
+				case 1000000000000000000: suffix = u8"as"; break;
+				default: break;
+			}
+		}
+
+		if (suffix) {
+			return write(out, HStringView{suffix});
+		}
+
+		*out++ = u8'[';
+		out = write(out, num);
+		if (den != 1) {
+			*out++ = u8'/';
+			out = write(out, den);
+		}
+		*out++ = u8']';
+		*out++ = u8's';
+		return out;
+	}
+
+	inline appender write_chrono(appender out, HStringView specs, const chrono_value& value) {
+		static constexpr const char8_t* weekday_names[] = {u8"Sunday", u8"Monday", u8"Tuesday", u8"Wednesday", u8"Thursday", u8"Friday", u8"Saturday"};
+		static constexpr const char8_t* month_names[] = {
+			u8"January", u8"February", u8"March", u8"April", u8"May", u8"June",
+			u8"July", u8"August", u8"September", u8"October", u8"November", u8"December"
+		};
+
+		if (specs.empty()) {
+			switch (value.kind_) {
+				case ChronoKind::duration:
+					out = value.floating_ ? write(out, value.fcount_) : write(out, value.count_);
+					return write_unit_suffix(out, value.num_, value.den_);
+				case ChronoKind::time_of_day:
+					specs = u8"%T";
+					break;
+				case ChronoKind::time_point: {
+					const auto& cache = update_calendar_cache(value.seconds_);
+					if (!cache.text_valid_) {
+						specs = u8"%F %T";
+						break;
+					}
+					out = std::ranges::copy(cache.text_, out).out;
+					return write_subseconds(out, value);
+				}
+			}
+		}
+
+		calendar_cache fields;
+		if (value.kind_ == ChronoKind::time_point) {
+			fields = update_calendar_cache(value.seconds_);
+		} else {
+			fields.hour_ = value.seconds_ / 3600;
+			fields.minute_ = static_cast<unsigned>(value.seconds_ / 60 % 60);
+			fields.sec_ = static_cast<unsigned>(value.seconds_ % 60);
+			if (value.negative_) {
+				*out++ = u8'-';
+			}
+		}
+
+		const auto write_year = [&fields](appender out_) {
+			if (fields.year_ < 0) *out_++ = u8'-';
+			return write_padded(out_, static_cast<uint64_t>(std::abs(fields.year_)), 4);
+		};
+
+		auto first = specs.data();
+		const auto last = first + specs.size();
+		while (first != last) {
+			const auto percent = std::find(first, last, u8'%');
+			out = std::ranges::copy(first, percent, out).out;
+			if (percent == last) break;
+
+			first = percent + 1;
+			assert(first != last);
+			switch (*first++) {
+				case 'n': *out++ = u8'\n'; break;
+				case 't': *out++ = u8'\t'; break;
+				case '%': *out++ = u8'%'; break;
+				case 'Y': out = write_year(out); break;
+				case 'y': out = write_padded(out, static_cast<uint64_t>(std::abs(fields.year_ % 100)), 2); break;
+				case 'C': out = write_padded(out, static_cast<uint64_t>(std::abs(fields.year_ / 100)), 2); break;
+				case 'm': out = write_padded(out, fields.month_, 2); break;
+				case 'd': out = write_padded(out, fields.mday_, 2); break;
+				case 'e': out = write_padded(out, fields.mday_, 2, u8' '); break;
+				case 'j': out = write_padded(out, fields.yday_, 3); break;
+				case 'H': out = write_padded(out, static_cast<uint64_t>(fields.hour_), 2); break;
+				case 'I': out = write_padded(out, static_cast<uint64_t>(fields.hour_ % 12 == 0 ? 12 : fields.hour_ % 12), 2); break;
+				case 'M': out = write_padded(out, fields.minute_, 2); break;
+				case 'S':
+					out = write_padded(out, fields.sec_, 2);
+					out = write_subseconds(out, value);
+					break;
+				case 'p': out = write(out, HStringView{fields.hour_ < 12 ? u8"AM" : u8"PM"}); break;
+				case 'R':
+					out = write_padded(out, static_cast<uint64_t>(fields.hour_), 2);
+					*out++ = u8':';
+					out = write_padded(out, fields.minute_, 2);
+					break;
+				case 'T':
+					out = write_padded(out, static_cast<uint64_t>(fields.hour_), 2);
+					*out++ = u8':';
+					out = write_padded(out, fields.minute_, 2);
+					*out++ = u8':';
+					out = write_padded(out, fields.sec_, 2);
+					out = write_subseconds(out, value);
+					break;
+				case 'F':
+					out = write_year(out);
+					*out++ = u8'-';
+					out = write_padded(out, fields.month_, 2);
+					*out++ = u8'-';
+					out = write_padded(out, fields.mday_, 2);
+					break;
+				case 'D':
+					out = write_padded(out, fields.month_, 2);
+					*out++ = u8'/';
+					out = write_padded(out, fields.mday_, 2);
+					*out++ = u8'/';
+					out = write_padded(out, static_cast<uint64_t>(std::abs(fields.year_ % 100)), 2);
+					break;
+				case 'a': out = write(out, HStringView{weekday_names[fields.wday_], 3}); break;
+				case 'A': out = write(out, HStringView{weekday_names[fields.wday_]}); break;
+				case 'b': out = write(out, HStringView{month_names[fields.month_ - 1], 3}); break;
+				case 'B': out = write(out, HStringView{month_names[fields.month_ - 1]}); break;
+				case 'u': *out++ = static_cast<char8_t>(u8'0' + (fields.wday_ == 0 ? 7 : fields.wday_)); break;
+				case 'w': *out++ = static_cast<char8_t>(u8'0' + fields.wday_); break;
+				case 'z': out = write(out, HStringView{u8"+0000"}); break;
+				case 'Z': out = write(out, HStringView{u8"UTC"}); break;
+				case 'Q': out = value.floating_ ? write(out, value.fcount_) : write(out, value.count_); break;
+				case 'q': out = write_unit_suffix(out, value.num_, value.den_); break;
+				default: report_error(u8"invalid chrono conversion specifier.");
+			}
+		}
+
+		return out;
+	}
+
+	context::iterator chrono_formatter::format(const chrono_value& value, context& ctx) const {
+		basic_format_specs specs = specs_;
+		if (specs_.dynamic_width_index_ >= 0) {
+			specs.width_ = get_dynamic_specs<width_checker>(ctx.arg(static_cast<size_t>(specs_.dynamic_width_index_)));
+		}
+
+		if (specs.width_ <= 0) {
+			return write_chrono(ctx.out(), chrono_specs_, value);
+		}
+
+		// Measure in a discarding pass so padding never needs a scratch string.
+		struct width_counting_buffer : buffer {
+			enum { buffer_size = 64 };
+			char8_t data_[buffer_size] = {};
+			int width_ = 0;
+
+			static void grow(buffer* buf, size_t) {
+				if (buf->size() != buffer_size) return;
+				static_cast<width_counting_buffer*>(buf)->flush(false);
+			}
+
+			// Uses the same width estimate as string padding. Unless this is the last flush,
+			// a trailing partial code point and the grapheme cluster before it are kept
+			// since the next write may extend them.
+			void flush(const bool last) {
+				const char8_t* end = data_ + this->size();
+				const char8_t* cut = end;
+				if (!last) {
+					const char8_t* lead = end;
+					while (lead != data_ && end - lead < 4 && (lead[-1] & 0xC0) == 0x80) --lead;
+					if (lead != data_) {
+						--lead;
+						const int length = (*lead & 0x80) == 0 ? 1 : (*lead & 0xE0) == 0xC0 ? 2 : (*lead & 0xF0) == 0xE0 ? 3 : 4;
+						if (end - lead < length) cut = lead;
+					}
+				}
+
+				msvc::_Measure_string_prefix_iterator_utf iter(data_, cut);
+				const char8_t* tail = cut;
+				int tail_width = 0;
+				for (; iter != std::default_sentinel; ++iter) {
+					tail = iter.position();
+					tail_width = *iter;
+					width_ += tail_width;
+				}
+
+				if (last) {
+					this->clear();
+					return;
+				}
+				if (tail != data_) {
+					width_ -= tail_width;
+				} else {
+					tail = cut; // a single cluster fills the buffer
+				}
+				std::copy(tail, end, data_);
+				this->try_resize(static_cast<size_t>(end - tail));
+			}
+
+			width_counting_buffer() : buffer(grow, data_, 0, buffer_size) {}
+		} counter;
+
+		write_chrono(appender{counter}, chrono_specs_, value);
+		counter.flush(true);
+
+		return write_aligned(ctx.out(), counter.width_, specs, Align::left, [this, &value](appender out) {
+			return write_chrono(out, chrono_specs_, value);
+		});
+	}
+}
@@ -157,7 +157,7 @@ namespace hana::fmt
 	}
 
 	template<std::integral T>
-	appender write_integral(appender out, const T value, basic_format_specs specs, const std::locale* loc) {
+	appender write_integral(appender out, const T value, basic_format_specs specs, const locale_type* loc) {
 		if (specs.type_ == 'c') {
 			if (!msvc::_In_bounds<char8_t, T>(value)) {
 				report_error(u8"integral cannot be stored in char8_t");
@@ -217,6 +217,7 @@ namespace hana::fmt
 			width += static_cast<int>(prefix.size());
 		}
 
+#ifndef HANA_FMT_NO_LOCALE
 		auto separators = 0;
 		std::string groups;
 		if (specs.localized_) {
@@ -225,6 +226,7 @@ namespace hana::fmt
 			// TRANSITION, separators may be wider for wide chars
 			width += separators;
 		}
+#endif
 
 		const bool write_leading_zeroes = specs.leading_zero_ && specs.alignment_ == Align::none;
 		auto writer = [&, end = end](appender out_) {
@@ -234,6 +236,7 @@ namespace hana::fmt
 				out_ = std::ranges::fill_n(out_, specs.width_ - width, '0');
 			}
 
+#ifndef HANA_FMT_NO_LOCALE
 			if (separators > 0) {
 				return fmt::write_separated_integer(
 					buffer_start,
@@ -244,6 +247,7 @@ namespace hana::fmt
 					out_
 				);
 			}
+#endif
 			return msvc::_Widen_and_copy<char8_t>(buffer_start, end, out_);
 		};
 
@@ -323,31 +327,31 @@ namespace hana::fmt
 		return std::ranges::copy(value, out).out;
 	}
 
-	inline appender write(appender, std::monostate, const basic_format_specs&, const std::locale*) {
+	inline appender write(appender, std::monostate, const basic_format_specs&, const locale_type*) {
 		abort();
 	}
 
 	template<std::integral T> requires(!is_any_of_v<T, char8_t, bool>)
-	appender write(appender out, const T value, const basic_format_specs& specs, const std::locale* loc) {
+	appender write(appender out, const T value, const basic_format_specs& specs, const locale_type* loc) {
 		return fmt::write_integral(out, value, specs, loc);
 	}
 
-	inline appender write(appender out, const bool value, basic_format_specs specs, const std::locale* loc) {
+	inline appender write(appender out, const bool value, basic_format_specs specs, const locale_type* loc) {
 		if (specs.type_ != '\0' && specs.type_ != 's') {
 			return write_integral(out, static_cast<unsigned char>(value), specs, loc);
 		}
 
 		assert(specs.precision_ == -1);
 
+#ifndef HANA_FMT_NO_LOCALE
 		if (specs.localized_) {
 			specs.localized_ = false;
 
 			const auto& facet = std::use_facet<std::numpunct<char>>(loc ? *loc : std::locale{});
-			auto sv = value
-						? static_cast<std::string_view>(facet.truename())
-						: static_cast<std::string_view>(facet.falsename());
-			return write(out, HStringView(reinterpret_cast<const char8_t*>(sv.data()), sv.size()), specs, loc);
+			const std::string name = value ? facet.truename() : facet.falsename();
+			return write(out, HStringView(reinterpret_cast<const char8_t*>(name.data()), name.size()), specs, loc);
 		}
+#endif
 
 		return write(out, value ? u8"true" : u8"false", specs, loc);
 	}
@@ -450,7 +454,7 @@ namespace hana::fmt
 		});
 	}
 
-	inline appender write(appender out, const char8_t value, const basic_format_specs& specs, const std::locale* loc) {
+	inline appender write(appender out, const char8_t value, const basic_format_specs& specs, const locale_type* loc) {
 		if (specs.type_ != '\0' && specs.type_ != 'c' && specs.type_ != '?') {
 			return write_integral(out, value, specs, loc);
 		}
@@ -465,7 +469,7 @@ namespace hana::fmt
 	}
 
 	template<std::floating_point T>
-	appender write(appender out, const T value, const basic_format_specs& specs, const std::locale* loc) {
+	appender write(appender out, const T value, const basic_format_specs& specs, const locale_type* loc) {
 		auto sgn = specs.sgn_;
 		if (sgn == Sign::none) {
 			sgn = Sign::minus;
@@ -584,10 +588,12 @@ namespace hana::fmt
 		auto append_decimal = false;
 		auto exponent_start = result.ptr;
 		auto radix_point = result.ptr;
-		auto integral_end = result.ptr;
 		auto zeroes_to_append = 0;
+#ifndef HANA_FMT_NO_LOCALE
+		auto integral_end = result.ptr;
 		auto separators = 0;
 		std::string groups;
+#endif
 
 		if (is_finite) {
 			if (specs.alt_ || specs.localized_) {
@@ -598,7 +604,9 @@ namespace hana::fmt
 						exponent_start = iter;
 					}
 				}
+#ifndef HANA_FMT_NO_LOCALE
 				integral_end = std::min(radix_point, exponent_start);
+#endif
 
 				if (specs.alt_ && radix_point == result.ptr) {
 					// TRANSITION, decimal point may be wider
@@ -606,10 +614,12 @@ namespace hana::fmt
 					append_decimal = true;
 				}
 
+#ifndef HANA_FMT_NO_LOCALE
 				if (specs.localized_) {
 					groups = std::use_facet<std::numpunct<char>>(loc ? *loc : std::locale{}).grouping();
 					separators = msvc::_Count_separators(static_cast<size_t>(integral_end - buffer_start), groups);
 				}
+#endif
 			}
 
 			switch (format) {
@@ -661,6 +671,7 @@ namespace hana::fmt
 				out_ = std::ranges::fill_n(out_, specs.width_ - width, '0');
 			}
 
+#ifndef HANA_FMT_NO_LOCALE
 			if (specs.localized_) {
 				const auto& facet = std::use_facet<std::numpunct<char>>(loc ? *loc : std::locale{});
 
@@ -674,6 +685,7 @@ namespace hana::fmt
 					++buffer_start;
 				}
 			}
+#endif
 
 			out_ = msvc::_Widen_and_copy<char8_t>(buffer_start, exponent_start, out_);
 			if (specs.alt_ && append_decimal) {
@@ -694,7 +706,7 @@ namespace hana::fmt
 		return fmt::write_aligned(out, width, specs, Align::right, writer);
 	}
 
-	appender write(appender out, const void* const value, const basic_format_specs& specs, const std::locale*) {
+	appender write(appender out, const void* const value, const basic_format_specs& specs, const locale_type*) {
 		assert(specs.type_ == '\0' || specs.type_ == 'p');
 		assert(specs.sgn_ == Sign::none);
 		assert(!specs.alt_);
@@ -717,11 +729,11 @@ namespace hana::fmt
 		});
 	}
 
-	appender write(appender out, const char8_t* value, const basic_format_specs& specs, const std::locale* loc) {
+	appender write(appender out, const char8_t* value, const basic_format_specs& specs, const locale_type* loc) {
 		return write(out, HStringView{value}, specs, loc);
 	}
 
-	appender write(appender out, const HStringView value, const basic_format_specs& specs, const std::locale*) {
+	appender write(appender out, const HStringView value, const basic_format_specs& specs, const locale_type*) {
 		assert(specs.type_ == '\0' || specs.type_ == 'c' || specs.type_ == 's' || specs.type_ == '?');
 		assert(specs.sgn_ == Sign::none);
 		assert(!specs.alt_);
@@ -124,8 +124,9 @@ namespace hana
 		}
 
 		[[nodiscard]] HString dump() const {
-			auto str = yyjson_mut_write(document, 0, nullptr);
-			HString ret = str;
+			size_t len = 0;
+			auto str = yyjson_mut_write(document, 0, &len);
+			HString ret{str, len};
 			free(str);
 			return ret;
 		}
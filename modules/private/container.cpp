@@ -1 +1,6 @@
-#include "container/string.cpp"
\ No newline at end of file
+#include "container/string.cpp"
+#include "container/text_index.cpp"
+#include "container/find.cpp"
+#include "container/shared_string.cpp"
+#include "container/name.cpp"
+#include "container/rope.cpp"
\ No newline at end of file
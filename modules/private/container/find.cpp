@@ -0,0 +1,296 @@
+#include <hana/container/string_view.hpp>
+
+#include "unicode/simd.hpp"
+
+namespace hana::internal
+{
+	using find_fn = size_t (*)(const char8_t* str, size_t size, const char8_t* pattern, size_t count, size_t pos) noexcept;
+
+	static constexpr size_t npos = HStringView::npos;
+
+	static constexpr size_t kFindScalarThreshold = 128;
+
+	// Set of code units as a 16x16 bit matrix: bit h of low_[l] (h < 8) or high_[l] (h >= 8) is set for unit (h << 4 | l).
+	// The rows are indexed by low nibble so the vector kernels can look them up with a byte shuffle.
+	struct unit_set {
+		alignas(16) uint8_t low_[16] = {};
+		alignas(16) uint8_t high_[16] = {};
+
+		unit_set(const char8_t* set, size_t count) {
+			for (size_t i = 0; i < count; ++i) {
+				const uint8_t l = set[i] & 0x0F;
+				const uint8_t h = set[i] >> 4;
+				(h < 8 ? low_ : high_)[l] |= static_cast<uint8_t>(1 << (h & 7));
+			}
+		}
+
+		bool contains(char8_t ch) const {
+			const uint8_t l = ch & 0x0F;
+			const uint8_t h = ch >> 4;
+			return ((h < 8 ? low_ : high_)[l] >> (h & 7)) & 1;
+		}
+	};
+
+#pragma region scalar
+
+	// Candidates in [pos, end) found by skipping to the first code unit with memchr.
+	static size_t find_tail(const char8_t* str, size_t pos, size_t end, const char8_t* pattern, size_t count) {
+		while (pos < end) {
+			const void* found = std::memchr(str + pos, pattern[0], end - pos);
+			if (!found) {
+				break;
+			}
+			pos = static_cast<size_t>(static_cast<const char8_t*>(found) - str);
+			if (std::memcmp(str + pos + 1, pattern + 1, count - 1) == 0) {
+				return pos;
+			}
+			++pos;
+		}
+		return npos;
+	}
+
+#if !defined(HANA_UNICODE_X64) && !defined(HANA_UNICODE_NEON)
+	static size_t find_scalar(const char8_t* str, size_t size, const char8_t* pattern, size_t count, size_t pos) noexcept {
+		return find_tail(str, pos, size - count + 1, pattern, count);
+	}
+#endif
+
+	template<bool Negate>
+	static size_t find_of_scalar(const char8_t* str, size_t size, const unit_set& set, size_t pos) {
+		for (; pos < size; ++pos) {
+			if (set.contains(str[pos]) != Negate) {
+				return pos;
+			}
+		}
+		return npos;
+	}
+
+#pragma endregion scalar
+
+#ifdef HANA_UNICODE_X64
+
+#pragma region sse2
+
+	// Candidate positions must match both the first and the last code unit of the pattern, only those are compared in full.
+	static size_t find_sse2(const char8_t* str, size_t size, const char8_t* pattern, size_t count, size_t pos) noexcept {
+		const __m128i first = _mm_set1_epi8(static_cast<char>(pattern[0]));
+		const __m128i last = _mm_set1_epi8(static_cast<char>(pattern[count - 1]));
+		const size_t end = size - count + 1;
+		for (; end - pos >= 16; pos += 16) {
+			const __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + pos));
+			const __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + pos + count - 1));
+			auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, block_first), _mm_cmpeq_epi8(last, block_last))));
+			for (; mask != 0; mask &= mask - 1) {
+				const size_t candidate = pos + static_cast<size_t>(std::countr_zero(mask));
+				if (std::memcmp(str + candidate + 1, pattern + 1, count - 2) == 0) {
+					return candidate;
+				}
+			}
+		}
+		return find_tail(str, pos, end, pattern, count);
+	}
+
+	// SSE2 has no byte shuffle, small sets compare against every member instead.
+	static constexpr size_t kSSE2SetMax = 8;
+
+	template<bool Negate>
+	static size_t find_of_sse2(const char8_t* str, size_t size, const char8_t* set, size_t count, size_t pos) {
+		__m128i members[kSSE2SetMax];
+		for (size_t i = 0; i < count; ++i) {
+			members[i] = _mm_set1_epi8(static_cast<char>(set[i]));
+		}
+
+		for (; size - pos >= 16; pos += 16) {
+			const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + pos));
+			__m128i hit = _mm_cmpeq_epi8(input, members[0]);
+			for (size_t i = 1; i < count; ++i) {
+				hit = _mm_or_si128(hit, _mm_cmpeq_epi8(input, members[i]));
+			}
+			auto mask = static_cast<uint32_t>(_mm_movemask_epi8(hit));
+			if constexpr (Negate) {
+				mask = ~mask & 0xFFFF;
+			}
+			if (mask != 0) {
+				return pos + static_cast<size_t>(std::countr_zero(mask));
+			}
+		}
+		return find_of_scalar<Negate>(str, size, unit_set{set, count}, pos);
+	}
+
+#pragma endregion sse2
+
+#pragma region avx2
+
+	HANA_UNICODE_TARGET_AVX2 static size_t find_avx2(const char8_t* str, size_t size, const char8_t* pattern, size_t count, size_t pos) noexcept {
+		const __m256i first = _mm256_set1_epi8(static_cast<char>(pattern[0]));
+		const __m256i last = _mm256_set1_epi8(static_cast<char>(pattern[count - 1]));
+		const size_t end = size - count + 1;
+		for (; end - pos >= 32; pos += 32) {
+			const __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + pos));
+			const __m256i block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + pos + count - 1));
+			auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first, block_first), _mm256_cmpeq_epi8(last, block_last))));
+			for (; mask != 0; mask &= mask - 1) {
+				const size_t candidate = pos + static_cast<size_t>(std::countr_zero(mask));
+				if (std::memcmp(str + candidate + 1, pattern + 1, count - 2) == 0) {
+					return candidate;
+				}
+			}
+		}
+		return find_sse2(str, size, pattern, count, pos);
+	}
+
+	template<bool Negate>
+	HANA_UNICODE_TARGET_AVX2 static size_t find_of_avx2(const char8_t* str, size_t size, const unit_set& set, size_t pos) {
+		const __m256i low_rows = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(set.low_)));
+		const __m256i high_rows = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(set.high_)));
+		const __m256i bits = _mm256_setr_epi8(
+			1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+			1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+		const __m256i nibble = _mm256_set1_epi8(0x0F);
+
+		for (; size - pos >= 32; pos += 32) {
+			const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + pos));
+			const __m256i low = _mm256_and_si256(input, nibble);
+			const __m256i high = _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble);
+			// the sign bit of a unit is bit 3 of its high nibble, which picks the row table
+			const __m256i rows = _mm256_blendv_epi8(_mm256_shuffle_epi8(low_rows, low), _mm256_shuffle_epi8(high_rows, low), input);
+			const __m256i column = _mm256_shuffle_epi8(bits, high);
+			auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(rows, column), column)));
+			if constexpr (Negate) {
+				mask = ~mask;
+			}
+			if (mask != 0) {
+				return pos + static_cast<size_t>(std::countr_zero(mask));
+			}
+		}
+		return find_of_scalar<Negate>(str, size, set, pos);
+	}
+
+#pragma endregion avx2
+
+#endif
+
+#ifdef HANA_UNICODE_NEON
+
+#pragma region neon
+
+	// 4 bits per code unit, NEON has no movemask
+	static inline uint64_t to_mask_neon(uint8x16_t hit) {
+		return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hit), 4)), 0);
+	}
+
+	static size_t find_neon(const char8_t* str, size_t size, const char8_t* pattern, size_t count, size_t pos) noexcept {
+		const uint8x16_t first = vdupq_n_u8(pattern[0]);
+		const uint8x16_t last = vdupq_n_u8(pattern[count - 1]);
+		const size_t end = size - count + 1;
+		for (; end - pos >= 16; pos += 16) {
+			const uint8x16_t block_first = vld1q_u8(reinterpret_cast<const uint8_t*>(str + pos));
+			const uint8x16_t block_last = vld1q_u8(reinterpret_cast<const uint8_t*>(str + pos + count - 1));
+			const uint8x16_t hit = vandq_u8(vceqq_u8(first, block_first), vceqq_u8(last, block_last));
+			for (uint64_t mask = to_mask_neon(hit) & 0x8888888888888888ull; mask != 0; mask &= mask - 1) {
+				const size_t candidate = pos + static_cast<size_t>(std::countr_zero(mask)) / 4;
+				if (std::memcmp(str + candidate + 1, pattern + 1, count - 2) == 0) {
+					return candidate;
+				}
+			}
+		}
+		return find_tail(str, pos, end, pattern, count);
+	}
+
+	template<bool Negate>
+	static size_t find_of_neon(const char8_t* str, size_t size, const unit_set& set, size_t pos) {
+		const uint8x16_t low_rows = vld1q_u8(set.low_);
+		const uint8x16_t high_rows = vld1q_u8(set.high_);
+		static constexpr uint8_t kBits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+		const uint8x16_t bits = vld1q_u8(kBits);
+		const uint8x16_t nibble = vdupq_n_u8(0x0F);
+
+		for (; size - pos >= 16; pos += 16) {
+			const uint8x16_t input = vld1q_u8(reinterpret_cast<const uint8_t*>(str + pos));
+			const uint8x16_t low = vandq_u8(input, nibble);
+			const uint8x16_t is_high = vcltq_s8(vreinterpretq_s8_u8(input), vdupq_n_s8(0));
+			const uint8x16_t rows = vbslq_u8(is_high, vqtbl1q_u8(high_rows, low), vqtbl1q_u8(low_rows, low));
+			uint8x16_t hit = vtstq_u8(rows, vqtbl1q_u8(bits, vshrq_n_u8(input, 4)));
+			if constexpr (Negate) {
+				hit = vmvnq_u8(hit);
+			}
+			if (vmaxvq_u8(hit) != 0) {
+				return pos + static_cast<size_t>(std::countr_zero(to_mask_neon(hit))) / 4;
+			}
+		}
+		return find_of_scalar<Negate>(str, size, set, pos);
+	}
+
+#pragma endregion neon
+
+#endif
+
+	static find_fn select_find() {
+#if defined(HANA_UNICODE_X64)
+		return simd::cpu_has_avx2() ? find_avx2 : find_sse2;
+#elif defined(HANA_UNICODE_NEON)
+		return find_neon;
+#else
+		return find_scalar;
+#endif
+	}
+
+	template<bool Negate>
+	static size_t find_of(const char8_t* str, size_t size, const char8_t* set, size_t count, size_t pos) {
+		if (pos >= size) {
+			return npos;
+		}
+		if constexpr (!Negate) {
+			if (count == 1) {
+				const void* found = std::memchr(str + pos, set[0], size - pos);
+				return found ? static_cast<size_t>(static_cast<const char8_t*>(found) - str) : npos;
+			}
+		}
+
+#if defined(HANA_UNICODE_X64)
+		if (simd::cpu_has_avx2()) {
+			return find_of_avx2<Negate>(str, size, unit_set{set, count}, pos);
+		}
+		if (count <= kSSE2SetMax && count > 0) {
+			return find_of_sse2<Negate>(str, size, set, count, pos);
+		}
+		return find_of_scalar<Negate>(str, size, unit_set{set, count}, pos);
+#elif defined(HANA_UNICODE_NEON)
+		return find_of_neon<Negate>(str, size, unit_set{set, count}, pos);
+#else
+		return find_of_scalar<Negate>(str, size, unit_set{set, count}, pos);
+#endif
+	}
+
+	size_t string_find(const char8_t* str, size_t size, const char8_t* pattern, size_t count, size_t pos) noexcept {
+		if (pos > size || count > size - pos) {
+			return npos;
+		}
+		if (count == 0) {
+			return pos;
+		}
+		if (count == 1) {
+			const void* found = std::memchr(str + pos, pattern[0], size - pos);
+			return found ? static_cast<size_t>(static_cast<const char8_t*>(found) - str) : npos;
+		}
+
+		// short text rarely holds a full block of candidates, memchr gets there sooner
+		if (size - pos < kFindScalarThreshold) {
+			return find_tail(str, pos, size - count + 1, pattern, count);
+		}
+
+		static const find_fn find = select_find();
+		return find(str, size, pattern, count, pos);
+	}
+
+	size_t string_find_first_of(const char8_t* str, size_t size, const char8_t* set, size_t count, size_t pos) noexcept {
+		if (count == 0) {
+			return npos;
+		}
+		return find_of<false>(str, size, set, count, pos);
+	}
+
+	size_t string_find_first_not_of(const char8_t* str, size_t size, const char8_t* set, size_t count, size_t pos) noexcept {
+		return find_of<true>(str, size, set, count, pos);
+	}
+}
\ No newline at end of file
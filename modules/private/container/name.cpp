@@ -0,0 +1,162 @@
+#include <hana/container/name.hpp>
+#include <hana/archive/format.hpp>
+#include <hana/utility/spinlock.hpp>
+
+#include <parallel_hashmap/phmap.h>
+
+#include <new>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <shared_mutex>
+
+namespace hana
+{
+	namespace
+	{
+		struct NameKey {
+			HStringView text;
+			uint64_t hash;
+
+			bool operator==(const NameKey& rhs) const noexcept {
+				return hash == rhs.hash && text == rhs.text;
+			}
+		};
+
+		struct NameKeyHash {
+			size_t operator()(const NameKey& key) const noexcept {
+				return static_cast<size_t>(key.hash);
+			}
+		};
+
+		class NamePool {
+		public:
+			static constexpr uint32_t BlockBits = 12;
+			static constexpr uint32_t BlockSize = 1u << BlockBits;
+			static constexpr uint32_t MaxBlocks = 1u << 14;
+			static constexpr size_t ChunkSize = 64 * 1024;
+
+			static NamePool& instance() {
+				// never destroyed, handles may still be read by static destructors of other modules
+				static NamePool* pool = new NamePool;
+				return *pool;
+			}
+
+			const internal::NameEntry* entry(uint32_t id) const noexcept {
+				const auto* block = blocks_[id >> BlockBits].load(std::memory_order_acquire);
+				return block[id & (BlockSize - 1)];
+			}
+
+			HStringView view(uint32_t id) const noexcept {
+				const auto* name = entry(id);
+				return {name->data(), name->size};
+			}
+
+			uint32_t find(const NameKey& key) const noexcept {
+				uint32_t id = 0;
+				names_.if_contains(key, [&](const auto& value) { id = value.second; });
+				return id;
+			}
+
+			uint32_t intern(const NameKey& key) {
+				if (const uint32_t id = find(key)) {
+					return id;
+				}
+
+				uint32_t id = 0;
+				names_.lazy_emplace_l(key, [&](const auto& value) { id = value.second; }, [&](const auto& ctor) {
+					// runs under the shard's write lock, so each text is stored once
+					id = add(key);
+					ctor(NameKey{view(id), key.hash}, id);
+				});
+				return id;
+			}
+
+		private:
+			using Slot = const internal::NameEntry*;
+
+			NamePool() {
+				// id 0 is the empty name
+				blocks_[0].store(new Slot[BlockSize]{store(u8"", XXHash::xxhash64(u8"", 0))}, std::memory_order_release);
+			}
+
+			//! copies the text into the arena and publishes it under the next id
+			uint32_t add(const NameKey& key) {
+				std::lock_guard lock{arena_lock_};
+
+				const uint32_t id = size_ + 1;
+				if (id >> BlockBits >= MaxBlocks) {
+					fmt::report_error(u8"name pool exhausted");
+				}
+
+				const internal::NameEntry* entry = store(key.text, key.hash);
+				auto& block = blocks_[id >> BlockBits];
+				if ((id & (BlockSize - 1)) == 0) {
+					block.store(new Slot[BlockSize]{}, std::memory_order_release);
+				}
+				block.load(std::memory_order_relaxed)[id & (BlockSize - 1)] = entry;
+				size_ = id;
+				return id;
+			}
+
+			const internal::NameEntry* store(HStringView text, uint64_t hash) {
+				auto* entry = static_cast<internal::NameEntry*>(allocate(sizeof(internal::NameEntry) + text.size() + 1));
+				entry->hash = hash;
+				entry->size = static_cast<uint32_t>(text.size());
+				auto* chars = reinterpret_cast<char8_t*>(entry + 1);
+				std::char_traits<char8_t>::copy(chars, text.data(), text.size());
+				chars[text.size()] = 0;
+				return entry;
+			}
+
+			void* allocate(size_t size) {
+				size = (size + alignof(internal::NameEntry) - 1) & ~(alignof(internal::NameEntry) - 1);
+				if (size > ChunkSize / 4) {
+					return chunks_.emplace_back(::operator new(size));
+				}
+				if (chunk_left_ < size) {
+					chunk_ = static_cast<std::byte*>(chunks_.emplace_back(::operator new(ChunkSize)));
+					chunk_left_ = ChunkSize;
+				}
+				void* result = chunk_;
+				chunk_ += size;
+				chunk_left_ -= size;
+				return result;
+			}
+
+			phmap::parallel_flat_hash_map<NameKey, uint32_t, NameKeyHash, phmap::EqualTo<NameKey>,
+				phmap::Allocator<std::pair<const NameKey, uint32_t>>, 4, std::shared_mutex> names_;
+
+			std::atomic<Slot*> blocks_[MaxBlocks] = {};
+
+			// guards the arena and the id counter, only taken when a new text is interned
+			spinlock arena_lock_;
+			uint32_t size_ = 0;
+			std::byte* chunk_ = nullptr;
+			size_t chunk_left_ = 0;
+			std::vector<void*> chunks_;
+		};
+
+		NameKey make_key(HStringView text) noexcept {
+			return {text, XXHash::xxhash64(text.data(), text.size())};
+		}
+	}
+
+	const internal::NameEntry* internal::name_entry(uint32_t id) noexcept {
+		return NamePool::instance().entry(id);
+	}
+
+	HName::HName(HStringView text) {
+		if (!text.empty()) {
+			id_ = NamePool::instance().intern(make_key(text));
+		}
+	}
+
+	HName HName::find(HStringView text) noexcept {
+		HName name;
+		if (!text.empty()) {
+			name.id_ = NamePool::instance().find(make_key(text));
+		}
+		return name;
+	}
+}
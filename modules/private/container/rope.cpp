@@ -0,0 +1,393 @@
+#include <hana/container/rope.hpp>
+
+#include <vector>
+#include <cassert>
+#include <algorithm>
+
+namespace hana
+{
+	struct RopeHelper {
+		using Node = HRope::Node;
+		using NodePtr = std::unique_ptr<Node>;
+		using size_type = HRope::size_type;
+
+		struct Split {
+			NodePtr left;
+			NodePtr right;
+		};
+
+		static uint8_t height(const NodePtr& node) noexcept {
+			return node ? node->height : 0;
+		}
+
+		static void update(Node& node) noexcept {
+			if (node.is_leaf()) {
+				node.size = node.text.size();
+				node.length = node.text.text_length();
+				node.height = 1;
+			} else {
+				node.size = node.left->size + node.right->size;
+				node.length = node.left->length + node.right->length;
+				node.height = std::max(node.left->height, node.right->height) + 1;
+			}
+		}
+
+		static NodePtr make_leaf(HString text) {
+			auto node = std::make_unique<Node>();
+			node->text = std::move(text);
+			update(*node);
+			return node;
+		}
+
+		static NodePtr make_node(NodePtr left, NodePtr right) {
+			auto node = std::make_unique<Node>();
+			node->left = std::move(left);
+			node->right = std::move(right);
+			update(*node);
+			return node;
+		}
+
+		static NodePtr rotate_left(NodePtr node) {
+			NodePtr pivot = std::move(node->right);
+			node->right = std::move(pivot->left);
+			update(*node);
+			pivot->left = std::move(node);
+			update(*pivot);
+			return pivot;
+		}
+
+		static NodePtr rotate_right(NodePtr node) {
+			NodePtr pivot = std::move(node->left);
+			node->left = std::move(pivot->right);
+			update(*node);
+			pivot->right = std::move(node);
+			update(*pivot);
+			return pivot;
+		}
+
+		static NodePtr rebalance(NodePtr node) {
+			update(*node);
+			const int balance = height(node->left) - height(node->right);
+			if (balance > 1) {
+				if (height(node->left->left) < height(node->left->right)) {
+					node->left = rotate_left(std::move(node->left));
+				}
+				return rotate_right(std::move(node));
+			}
+			if (balance < -1) {
+				if (height(node->right->right) < height(node->right->left)) {
+					node->right = rotate_right(std::move(node->right));
+				}
+				return rotate_left(std::move(node));
+			}
+			return node;
+		}
+
+		// concatenation, descends the spine of the taller side so the result stays balanced
+		static NodePtr join(NodePtr left, NodePtr right) {
+			if (!left) return right;
+			if (!right) return left;
+
+			if (left->is_leaf() && right->is_leaf()) {
+				if (left->size + right->size <= HRope::LeafSize) {
+					left->text.append(right->text);
+					update(*left);
+					return left;
+				}
+				return make_node(std::move(left), std::move(right));
+			}
+
+			// a lone leaf is carried down to its neighbouring leaf, so small edits merge instead of fragmenting the tree
+			if (height(left) > height(right) + 1 || right->is_leaf()) {
+				left->right = join(std::move(left->right), std::move(right));
+				return rebalance(std::move(left));
+			}
+			if (height(right) > height(left) + 1 || left->is_leaf()) {
+				right->left = join(std::move(left), std::move(right->left));
+				return rebalance(std::move(right));
+			}
+			return make_node(std::move(left), std::move(right));
+		}
+
+		static Split split(NodePtr node, size_type index) {
+			if (!node) return {};
+			if (index == 0) return {nullptr, std::move(node)};
+			if (index >= node->size) return {std::move(node), nullptr};
+
+			if (node->is_leaf()) {
+				NodePtr right = make_leaf(HString{HStringView{node->text}.subview(index)});
+				node->text.erase(index);
+				update(*node);
+				return {std::move(node), std::move(right)};
+			}
+
+			const size_type left_size = node->left->size;
+			if (index < left_size) {
+				auto [a, b] = split(std::move(node->left), index);
+				return {std::move(a), join(std::move(b), std::move(node->right))};
+			}
+			auto [a, b] = split(std::move(node->right), index - left_size);
+			return {join(std::move(node->left), std::move(a)), std::move(b)};
+		}
+
+		// leaves of at most LeafSize code units, cut on code point boundaries
+		static NodePtr build(HStringView view) {
+			std::vector<NodePtr> leaves;
+			while (!view.empty()) {
+				size_type count = std::min(view.size(), HRope::LeafSize);
+				if (count < view.size()) {
+					// step back over at most 3 continuation bytes to the start of the sequence being cut
+					size_type boundary = count;
+					while (boundary + 3 > count && boundary > 0 && (view.data()[boundary] & 0xC0) == 0x80) {
+						--boundary;
+					}
+					if (boundary > 0 && (view.data()[boundary] & 0xC0) != 0x80) {
+						count = boundary;
+					}
+				}
+				leaves.emplace_back(make_leaf(HString{view.subview(0, count)}));
+				view = view.subview(count);
+			}
+			return build(leaves, 0, leaves.size());
+		}
+
+		static NodePtr build(std::vector<NodePtr>& leaves, size_t first, size_t last) {
+			if (first == last) return nullptr;
+			if (last - first == 1) return std::move(leaves[first]);
+
+			const size_t mid = first + (last - first) / 2;
+			NodePtr left = build(leaves, first, mid);
+			return make_node(std::move(left), build(leaves, mid, last));
+		}
+
+		static NodePtr clone(const NodePtr& node) {
+			if (!node) return nullptr;
+
+			auto copy = std::make_unique<Node>();
+			copy->text = node->text;
+			copy->left = clone(node->left);
+			copy->right = clone(node->right);
+			copy->size = node->size;
+			copy->length = node->length;
+			copy->height = node->height;
+			return copy;
+		}
+
+		// leaf holding the code unit at index, index becomes the offset inside the leaf
+		static const Node* find_leaf(const Node* node, size_type& index) noexcept {
+			while (!node->is_leaf()) {
+				if (index < node->left->size) {
+					node = node->left.get();
+				} else {
+					index -= node->left->size;
+					node = node->right.get();
+				}
+			}
+			return node;
+		}
+	};
+}
+
+// ctor & dtor
+namespace hana
+{
+	HRope::HRope() noexcept = default;
+	HRope::HRope(HStringView view): root_(RopeHelper::build(view)) {}
+	HRope::HRope(const HRope& other): root_(RopeHelper::clone(other.root_)) {}
+	HRope::HRope(HRope&& other) noexcept = default;
+	HRope::~HRope() noexcept = default;
+
+	HRope& HRope::operator=(const HRope& rhs) {
+		if (this != &rhs) {
+			root_ = RopeHelper::clone(rhs.root_);
+			invalidate();
+		}
+		return *this;
+	}
+
+	HRope& HRope::operator=(HRope&& rhs) noexcept = default;
+}
+
+// compare
+namespace hana
+{
+	bool HRope::operator==(HStringView rhs) const noexcept {
+		if (size() != rhs.size()) {
+			return false;
+		}
+
+		bool equal = true;
+		for_each_chunk([&](HStringView chunk) {
+			equal = equal && rhs.starts_with(chunk);
+			rhs = rhs.subview(chunk.size());
+		});
+		return equal;
+	}
+
+	bool HRope::operator==(const HRope& rhs) const {
+		return size() == rhs.size() && *this == HStringView{rhs.str()};
+	}
+}
+
+// size & data access
+namespace hana
+{
+	bool HRope::empty() const noexcept {
+		return !root_;
+	}
+
+	HRope::size_type HRope::size() const noexcept {
+		return root_ ? root_->size : 0;
+	}
+
+	HRope::size_type HRope::text_length() const noexcept {
+		return root_ ? root_->length : 0;
+	}
+
+	HRope::value_type HRope::at(size_type index) const {
+		assert(index < size() && "undefined behavior accessing out of bounds");
+		const Node* leaf = RopeHelper::find_leaf(root_.get(), index);
+		return leaf->text[index];
+	}
+
+	unicode::UTF8Seq HRope::at_text(size_type index) const {
+		assert(index < size() && "undefined behavior accessing out of bounds");
+		const Node* leaf = RopeHelper::find_leaf(root_.get(), index);
+		return leaf->text.at_text(index);
+	}
+
+	HRope::size_type HRope::buffer_index_to_text(size_type index) const noexcept {
+		if (index >= size()) {
+			return text_length();
+		}
+
+		size_type text_index = 0;
+		const Node* node = root_.get();
+		while (!node->is_leaf()) {
+			if (index < node->left->size) {
+				node = node->left.get();
+			} else {
+				index -= node->left->size;
+				text_index += node->left->length;
+				node = node->right.get();
+			}
+		}
+		return text_index + node->text.buffer_index_to_text(index);
+	}
+
+	HRope::size_type HRope::text_index_to_buffer(size_type index) const noexcept {
+		if (index >= text_length()) {
+			return size();
+		}
+
+		size_type buffer_index = 0;
+		const Node* node = root_.get();
+		while (!node->is_leaf()) {
+			if (index < node->left->length) {
+				node = node->left.get();
+			} else {
+				index -= node->left->length;
+				buffer_index += node->left->size;
+				node = node->right.get();
+			}
+		}
+		return buffer_index + node->text.text_index_to_buffer(index);
+	}
+}
+
+// modify
+namespace hana
+{
+	HRope& HRope::append(HStringView view) {
+		invalidate();
+		root_ = RopeHelper::join(std::move(root_), RopeHelper::build(view));
+		return *this;
+	}
+
+	HRope& HRope::append(HRope&& rope) {
+		invalidate();
+		rope.invalidate();
+		root_ = RopeHelper::join(std::move(root_), std::move(rope.root_));
+		return *this;
+	}
+
+	HRope& HRope::insert(size_type index, HStringView view) {
+		return insert(index, HRope{view});
+	}
+
+	HRope& HRope::insert(size_type index, HRope&& rope) {
+		assert(index <= size() && "undefined behavior inserting out of bounds");
+
+		invalidate();
+		rope.invalidate();
+		auto [left, right] = RopeHelper::split(std::move(root_), index);
+		root_ = RopeHelper::join(RopeHelper::join(std::move(left), std::move(rope.root_)), std::move(right));
+		return *this;
+	}
+
+	HRope& HRope::erase(size_type index, size_type count) {
+		return replace(index, std::min(count, size() - index), {});
+	}
+
+	HRope& HRope::replace(size_type pos, size_type count, HStringView view) {
+		assert(pos + count <= size() && "undefined behavior replacing out of bounds");
+		invalidate();
+
+		auto [left, rest] = RopeHelper::split(std::move(root_), pos);
+		auto [removed, right] = RopeHelper::split(std::move(rest), count);
+		root_ = RopeHelper::join(RopeHelper::join(std::move(left), RopeHelper::build(view)), std::move(right));
+		return *this;
+	}
+
+	HRope& HRope::clear() noexcept {
+		invalidate();
+		root_.reset();
+		return *this;
+	}
+
+	HRope HRope::split(size_type index) {
+		invalidate();
+		auto [left, right] = RopeHelper::split(std::move(root_), index);
+		root_ = std::move(left);
+
+		HRope result;
+		result.root_ = std::move(right);
+		return result;
+	}
+}
+
+// flatten
+namespace hana
+{
+	HString HRope::str() const {
+		HString result;
+		result.reserve(size());
+		for_each_chunk([&](HStringView chunk) {
+			result.append(chunk);
+		});
+		return result;
+	}
+
+	HStringView HRope::flatten() {
+		if (!root_) {
+			return {};
+		}
+		if (root_->is_leaf()) {
+			return HStringView{root_->text};
+		}
+		// the leaves stay as they are, splitting one big leaf would copy its tail on every later edit
+		if (!flat_valid_) {
+			flat_ = str();
+			flat_valid_ = true;
+		}
+		return HStringView{flat_};
+	}
+
+	void HRope::invalidate() noexcept {
+		if (flat_valid_) {
+			// release the copy instead of keeping a second document alive
+			flat_ = HString{};
+			flat_valid_ = false;
+		}
+	}
+}
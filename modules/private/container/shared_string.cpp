@@ -0,0 +1,103 @@
+#include <hana/container/shared_string.hpp>
+
+#include <new>
+#include <cassert>
+
+namespace hana
+{
+	HSharedString::HSharedString(HStringView view) {
+		if (view.empty()) {
+			return;
+		}
+
+		header_ = allocate(view.size());
+		traits_type::copy(chars(), view.data(), view.size());
+		chars()[view.size()] = 0;
+		header_->size = view.size();
+	}
+
+	HSharedString::pointer HSharedString::mutable_data() {
+		return unshare(size());
+	}
+
+	HSharedString& HSharedString::assign(HStringView view) {
+		if (is_unique() && view.size() <= header_->capacity) {
+			// view may point into our own buffer
+			traits_type::move(chars(), view.data(), view.size());
+			chars()[view.size()] = 0;
+			header_->size = view.size();
+		} else {
+			*this = HSharedString{view};
+		}
+		return *this;
+	}
+
+	HSharedString& HSharedString::append(HStringView view) {
+		if (view.empty()) {
+			return *this;
+		}
+
+		const size_type old_size = size();
+		const size_type new_size = old_size + view.size();
+		if (!is_unique() || new_size > header_->capacity) {
+			const size_type grown = capacity() / 2 + capacity();
+			Header* copy = allocate(new_size > grown ? new_size : grown);
+			auto* copy_chars = reinterpret_cast<pointer>(copy + 1);
+			traits_type::copy(copy_chars, data(), old_size);
+			// copy before release, view may point into the old buffer
+			traits_type::copy(copy_chars + old_size, view.data(), view.size());
+			release();
+			header_ = copy;
+		} else {
+			traits_type::move(chars() + old_size, view.data(), view.size());
+		}
+
+		chars()[new_size] = 0;
+		header_->size = new_size;
+		return *this;
+	}
+
+	void HSharedString::clear() noexcept {
+		if (is_unique()) {
+			chars()[0] = 0;
+			header_->size = 0;
+		} else {
+			release();
+		}
+	}
+
+	HSharedString::pointer HSharedString::unshare(size_type capacity) {
+		if (!header_) {
+			// keep data() pointing at a writable buffer even for empty text
+			header_ = allocate(capacity);
+			chars()[0] = 0;
+			return chars();
+		}
+
+		if (!is_unique() || capacity > header_->capacity) {
+			const size_type kept = header_->size < capacity ? header_->size : capacity;
+			Header* copy = allocate(capacity);
+			auto* copy_chars = reinterpret_cast<pointer>(copy + 1);
+			traits_type::copy(copy_chars, chars(), kept);
+			copy_chars[kept] = 0;
+			copy->size = kept;
+			release();
+			header_ = copy;
+		}
+		return chars();
+	}
+
+	HSharedString::Header* HSharedString::allocate(size_type capacity) {
+		void* memory = ::operator new(sizeof(Header) + capacity + 1);
+		auto* header = new (memory) Header{};
+		header->counter.store(1, std::memory_order_relaxed);
+		header->size = 0;
+		header->capacity = capacity;
+		return header;
+	}
+
+	void HSharedString::deallocate(Header* header) noexcept {
+		header->~Header();
+		::operator delete(header);
+	}
+}
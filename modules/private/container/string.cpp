@@ -1,4 +1,5 @@
 #include <hana/container/string.hpp>
+#include <hana/archive/format.hpp>
 
 #include <memory>
 #include <cassert>
@@ -25,49 +26,77 @@ namespace hana
 		}
 	};
 
-	struct StringHelper : HString::allocator_type {
-		using size_type = HString::size_type;
-		using pointer = HString::pointer;
-		using traits_type = HString::traits_type;
-		using allocator_type = HString::allocator_type;
+	static thread_local std::pmr::memory_resource* string_resource = nullptr;
 
-		StringHelper(HString* ptr) : str(ptr) {}
+	template<typename String>
+	struct StringHelper : String::allocator_type {
+		using size_type = typename String::size_type;
+		using pointer = typename String::pointer;
+		using traits_type = typename String::traits_type;
+		using allocator_type = typename String::allocator_type;
+		using Heap = typename String::Heap;
 
-		HString* str;
+		// a buffer from a memory_resource is prefixed with the resource, so any string can free it
+		static constexpr size_type kResourcePrefix = sizeof(std::pmr::memory_resource*);
+		static constexpr size_type kResourceAlignment = alignof(std::pmr::memory_resource*);
+
+		StringHelper(String* ptr) : str(ptr) {}
+
+		String* str;
+		// resource of the last allocate(), nullptr for allocator_type
+		std::pmr::memory_resource* resource = nullptr;
 
 		void reset() const noexcept {
-			std::memset(str->buffer_, 0, HString::SSOBufferSize);
-			str->sso_flag_ = 1;
+			str->reset();
 		}
 
 		void set_size(size_type value) const noexcept {
-			if (str->is_sso()) {
-				str->sso_data_[value] = 0;
-				str->sso_size_ = value;
-			} else {
-				str->data_[value] = 0;
-				str->size_ = value;
+			str->set_size(value);
+		}
+
+		pointer allocate(size_type count) {
+			// growing a heap buffer keeps its allocator, new buffers come from the thread's scope
+			if (count - 1 > Heap::max_capacity) {
+				fmt::report_error(u8"string exceeds max_size()");
 			}
+
+			resource = str->is_heap() ? str->memory_resource() : string_resource;
+			if (!resource) {
+				return allocator_type::allocate(count);
+			}
+
+			void* memory = resource->allocate(kResourcePrefix + count, kResourceAlignment);
+			::new (memory) std::pmr::memory_resource*(resource);
+			return reinterpret_cast<pointer>(static_cast<std::byte*>(memory) + kResourcePrefix);
 		}
 
 		void destroy() {
-			deallocate(str->data_, str->capacity_ + 1);
+			if (auto* owner = str->memory_resource()) {
+				owner->deallocate(reinterpret_cast<std::byte*>(str->heap_.data_) - kResourcePrefix, kResourcePrefix + str->heap_.capacity() + 1, kResourceAlignment);
+			} else {
+				allocator_type::deallocate(str->heap_.data_, str->heap_.capacity() + 1);
+			}
+		}
+
+		// takes ownership of memory from the last allocate(), holding count code units
+		void set_heap(pointer memory, size_type count) {
+			// the size overlaps the inline text, read it before switching
+			const size_type size = str->size();
+			if (str->is_heap()) {
+				destroy();
+			}
+
+			str->heap_.set(memory, size, count - 1, resource != nullptr);
+			str->sso_flag_ = 0;
 		}
 
 		template<typename Getter, typename Fn>
 		void reserve(Getter&& getter, size_type count, Fn&& func) {
 			if (count > str->capacity()) {
 				auto new_sz = std::forward<Getter>(getter)(count + 1);
-				pointer new_memory = allocator_type::allocate(new_sz);
+				pointer new_memory = allocate(new_sz);
 				std::forward<Fn>(func)(new_memory);
-
-				if (str->is_heap()) {
-					deallocate(str->data(), str->capacity_ + 1);
-				}
-
-				str->data_ = new_memory;
-				str->capacity_ = new_sz - 1;
-				str->sso_flag_ = 0;
+				set_heap(new_memory, new_sz);
 			}
 		}
 
@@ -80,14 +109,7 @@ namespace hana
 				traits_type::move(new_memory, str->data(), index);
 				traits_type::move(new_memory + index + len, str->data() + index, str->size() - index + 1);
 				std::forward<Fn>(func)(new_memory + index);
-
-				if (str->is_heap()) {
-					deallocate(str->data(), str->capacity_ + 1);
-				}
-
-				str->data_ = new_memory;
-				str->capacity_ = new_sz - 1;
-				str->sso_flag_ = 0;
+				set_heap(new_memory, new_sz);
 			} else {
 				traits_type::move(str->data() + index + len, str->data() + index, str->size() - index + 1);
 				std::forward<Fn>(func)(str->data() + index);
@@ -95,17 +117,50 @@ namespace hana
 			set_size(at_least_capacity);
 		}
 
+		// Worst-case utf-8 sizes up to this are transcoded once into a stack buffer, larger text is sized exactly first.
+		static constexpr size_t kTranscodeStackSize = 256;
+
+		// Writes ptr as utf-8 at data() + offset, grow(count) must make room for count code units before anything is written.
+		// One pass when the worst case fits the current capacity or the stack buffer, two (vectorized) passes otherwise so
+		// the reservation is never inflated to the worst case.
+		template<typename Char, typename Grow>
+		size_type transcode(size_type offset, const Char* ptr, size_t len, Grow&& grow) {
+			if constexpr (sizeof(Char) == sizeof(char8_t)) {
+				grow(offset + len);
+				traits_type::copy(str->data() + offset, reinterpret_cast<const char8_t*>(ptr), len);
+				return len;
+			} else {
+				const size_t bound = unicode::text_size_bound<Char>(len);
+				if (offset + bound <= str->capacity()) {
+					return unicode::transcode_to_utf8(ptr, len, str->data() + offset);
+				}
+
+				if (bound <= kTranscodeStackSize) {
+					char8_t buffer[kTranscodeStackSize];
+					const size_type utf8_len = unicode::transcode_to_utf8(ptr, len, buffer);
+					grow(offset + utf8_len);
+					traits_type::copy(str->data() + offset, buffer, utf8_len);
+					return utf8_len;
+				}
+
+				const size_type utf8_len = unicode::text_size(ptr, len);
+				grow(offset + utf8_len);
+				unicode::transcode_to_utf8(ptr, len, str->data() + offset);
+				return utf8_len;
+			}
+		}
+
 		template<typename Char>
-		HString& do_assign(const Char* ptr, size_t len) {
-			size_type utf8_len = unicode::text_size(ptr, len);
-			this->reserve(policy_type::get_reserve, utf8_len, [](pointer) {});
-			unicode::parse_to_utf8(ptr, len, str->data());
+		String& do_assign(const Char* ptr, size_t len) {
+			const size_type utf8_len = transcode(0, ptr, len, [this](size_type count) {
+				this->reserve(policy_type::get_reserve, count, [](pointer) {});
+			});
 			set_size(utf8_len);
 			return *str;
 		}
 
 		template<typename View>
-		HString& do_insert(size_type index, View view) {
+		String& do_insert(size_type index, View view) {
 			assert(index <= str->size());
 
 			auto utf8_len = unicode::text_size(view.data(), view.size());
@@ -116,14 +171,14 @@ namespace hana
 		}
 
 		template<typename View>
-		HString& do_append(View view) {
-			auto sz = str->size();
-			size_type new_sz = sz + unicode::text_size(view.data(), view.size());
-			this->reserve(policy_type::get_grow, new_sz, [&](pointer ptr) {
-				traits_type::move(ptr, str->data(), sz);
+		String& do_append(View view) {
+			const auto sz = str->size();
+			const size_type utf8_len = transcode(sz, view.data(), view.size(), [this, sz](size_type count) {
+				this->reserve(policy_type::get_grow, count, [&](pointer ptr) {
+					traits_type::move(ptr, str->data(), sz);
+				});
 			});
-			unicode::parse_to_utf8(view.data(), view.size(), str->data() + sz);
-			set_size(new_sz);
+			set_size(sz + utf8_len);
 			return *str;
 		}
 	};
@@ -132,45 +187,53 @@ namespace hana
 // ctor & dtor
 namespace hana
 {
-	HString::HString() {
-		StringHelper helper(this);
+	template<size_t Size>
+	BasicHString<Size>::BasicHString() {
+		StringHelper<BasicHString> helper(this);
 		helper.reset();
 	}
 
-	HString::HString(size_type count, value_type ch) {
-		StringHelper helper(this);
+	template<size_t Size>
+	BasicHString<Size>::BasicHString(size_type count, value_type ch) {
+		StringHelper<BasicHString> helper(this);
+		helper.reset();
 		helper.reserve(policy_type::get_reserve, count, [](pointer) {});
 		std::uninitialized_fill_n(data(), count, ch);
 		helper.set_size(count);
 	}
 
-	HString::HString(HString&& rhs) noexcept {
-		StringHelper helper(this);
+	template<size_t Size>
+	BasicHString<Size>::BasicHString(BasicHString&& rhs) noexcept {
+		StringHelper<BasicHString> helper(this);
 		helper.reset();
 		swap(rhs);
 	}
 
-	HString::HString(HStringView view) {
-		StringHelper helper(this);
+	template<size_t Size>
+	BasicHString<Size>::BasicHString(HStringView view) {
+		StringHelper<BasicHString> helper(this);
 		helper.reset();
 		assign(view.data(), view.size());
 	}
 
-	HString::HString(const char16_t* str, size_type count) {
-		StringHelper helper(this);
+	template<size_t Size>
+	BasicHString<Size>::BasicHString(const char16_t* str, size_type count) {
+		StringHelper<BasicHString> helper(this);
 		helper.reset();
 		assign(str, count);
 	}
 
-	HString::HString(const char32_t* str, size_type count) {
-		StringHelper helper(this);
+	template<size_t Size>
+	BasicHString<Size>::BasicHString(const char32_t* str, size_type count) {
+		StringHelper<BasicHString> helper(this);
 		helper.reset();
 		assign(str, count);
 	}
 
-	HString::~HString() noexcept {
+	template<size_t Size>
+	BasicHString<Size>::~BasicHString() noexcept {
 		if (is_heap()) {
-			StringHelper helper(this);
+			StringHelper<BasicHString> helper(this);
 			helper.destroy();
 		}
 	}
@@ -179,26 +242,30 @@ namespace hana
 // assign
 namespace hana
 {
-	HString& HString::assign(HString&& rhs) noexcept {
-		StringHelper helper(this);
+	template<size_t Size>
+	BasicHString<Size>& BasicHString<Size>::assign(BasicHString&& rhs) noexcept {
+		StringHelper<BasicHString> helper(this);
 		if (is_heap()) helper.destroy();
 		helper.reset();
 		swap(rhs);
 		return *this;
 	}
 
-	HString& HString::assign(HStringView view) {
-		StringHelper helper(this);
+	template<size_t Size>
+	BasicHString<Size>& BasicHString<Size>::assign(HStringView view) {
+		StringHelper<BasicHString> helper(this);
 		return helper.do_assign(view.data(), view.size());
 	}
 
-	HString& HString::assign(const char16_t* str, size_type count) {
-		StringHelper helper(this);
+	template<size_t Size>
+	BasicHString<Size>& BasicHString<Size>::assign(const char16_t* str, size_type count) {
+		StringHelper<BasicHString> helper(this);
 		return helper.do_assign(str, count);
 	}
 
-	HString& HString::assign(const char32_t* str, size_type count) {
-		StringHelper helper(this);
+	template<size_t Size>
+	BasicHString<Size>& BasicHString<Size>::assign(const char32_t* str, size_type count) {
+		StringHelper<BasicHString> helper(this);
 		return helper.do_assign(str, count);
 	}
 }
@@ -206,33 +273,38 @@ namespace hana
 // insert
 namespace hana
 {
-	HString& HString::insert(size_type index, size_type count, value_type ch) {
+	template<size_t Size>
+	BasicHString<Size>& BasicHString<Size>::insert(size_type index, size_type count, value_type ch) {
 		assert(index <= size());
 
-		StringHelper helper(this);
+		StringHelper<BasicHString> helper(this);
 		helper.insert(index, count, [&](pointer ptr) {
 			std::uninitialized_fill_n(ptr, count, ch);
 		});
 		return *this;
 	}
 
-	HString& HString::insert(size_type index, HStringView view) {
-		StringHelper helper(this);
+	template<size_t Size>
+	BasicHString<Size>& BasicHString<Size>::insert(size_type index, HStringView view) {
+		StringHelper<BasicHString> helper(this);
 		return helper.do_insert(index, view);
 	}
 
-	HString& HString::insert(size_type index, const char16_t* str) {
-		StringHelper helper(this);
+	template<size_t Size>
+	BasicHString<Size>& BasicHString<Size>::insert(size_type index, const char16_t* str) {
+		StringHelper<BasicHString> helper(this);
 		return helper.do_insert(index, std::basic_string_view{str});
 	}
 
-	HString& HString::insert(size_type index, const char32_t* str) {
-		StringHelper helper(this);
+	template<size_t Size>
+	BasicHString<Size>& BasicHString<Size>::insert(size_type index, const char32_t* str) {
+		StringHelper<BasicHString> helper(this);
 		return helper.do_insert(index, std::basic_string_view{str});
 	}
 
-	HString& HString::append(size_type count, value_type ch) {
-		StringHelper helper(this);
+	template<size_t Size>
+	BasicHString<Size>& BasicHString<Size>::append(size_type count, value_type ch) {
+		StringHelper<BasicHString> helper(this);
 
 		auto sz = size();
 		size_type new_sz = sz + count;
@@ -244,18 +316,21 @@ namespace hana
 		return *this;
 	}
 
-	HString& HString::append(HStringView view) {
-		StringHelper helper(this);
+	template<size_t Size>
+	BasicHString<Size>& BasicHString<Size>::append(HStringView view) {
+		StringHelper<BasicHString> helper(this);
 		return helper.do_append(view);
 	}
 
-	HString& HString::append(const char16_t* str) {
-		StringHelper helper(this);
+	template<size_t Size>
+	BasicHString<Size>& BasicHString<Size>::append(const char16_t* str) {
+		StringHelper<BasicHString> helper(this);
 		return helper.do_append(std::basic_string_view{str});
 	}
 
-	HString& HString::append(const char32_t* str) {
-		StringHelper helper(this);
+	template<size_t Size>
+	BasicHString<Size>& BasicHString<Size>::append(const char32_t* str) {
+		StringHelper<BasicHString> helper(this);
 		return helper.do_append(std::basic_string_view{str});
 	}
 }
@@ -263,24 +338,27 @@ namespace hana
 // remove
 namespace hana
 {
-	HString& HString::clear() noexcept {
-		StringHelper helper(this);
+	template<size_t Size>
+	BasicHString<Size>& BasicHString<Size>::clear() noexcept {
+		StringHelper<BasicHString> helper(this);
 		helper.set_size(0);
 		return *this;
 	}
 
-	HString& HString::pop_back(size_type count) {
+	template<size_t Size>
+	BasicHString<Size>& BasicHString<Size>::pop_back(size_type count) {
 		assert(size() >= count);
 
-		StringHelper helper(this);
+		StringHelper<BasicHString> helper(this);
 		helper.set_size(size() - count);
 		return *this;
 	}
 
-	HString& HString::erase(size_type index, size_type count) {
+	template<size_t Size>
+	BasicHString<Size>& BasicHString<Size>::erase(size_type index, size_type count) {
 		assert(is_valid_index(index));
 
-		StringHelper helper(this);
+		StringHelper<BasicHString> helper(this);
 		auto v_end = std::min(count, size() - index);
 		traits_type::move(data() + index, data() + index + v_end, size() - index - v_end);
 		helper.set_size(size() - v_end);
@@ -291,10 +369,11 @@ namespace hana
 // replace
 namespace hana
 {
-	HString& HString::replace(size_type pos, size_type count, const_pointer cstr, size_type count2) {
+	template<size_t Size>
+	BasicHString<Size>& BasicHString<Size>::replace(size_type pos, size_type count, const_pointer cstr, size_type count2) {
 		assert(pos + count <= size());
 
-		StringHelper helper(this);
+		StringHelper<BasicHString> helper(this);
 		auto at_least_capacity = size() + count2 - count;
 		if (at_least_capacity > capacity()) {
 			auto new_sz = policy_type::get_grow(at_least_capacity + 1);
@@ -302,14 +381,7 @@ namespace hana
 			traits_type::move(new_memory, data(), pos);
 			traits_type::copy(new_memory + pos, cstr, count2);
 			traits_type::move(new_memory + pos + count2, data() + pos + count, size() - pos - count);
-
-			if (is_heap()) {
-				helper.destroy();
-			}
-
-			data_ = new_memory;
-			capacity_ = new_sz - 1;
-			sso_flag_ = 0;
+			helper.set_heap(new_memory, new_sz);
 		} else {
 			traits_type::move(data() + pos + count2, data() + pos + count, size() - pos - count);
 			traits_type::copy(data() + pos, cstr, count2);
@@ -320,36 +392,137 @@ namespace hana
 	}
 }
 
+// case
+namespace hana
+{
+	template<typename String>
+	static String map_case(HStringView view, unicode::internal::CaseMapping mapping) {
+		const auto mapped_size = unicode::internal::utf8_case_size(view.data(), view.size(), mapping);
+
+		String result;
+		result.reserve_exact(mapped_size);
+		result.resize_and_overwrite(mapped_size, [&](typename String::pointer data, typename String::size_type) {
+			return unicode::internal::utf8_case_map(view.data(), view.size(), data, mapping);
+		});
+		return result;
+	}
+
+	template<typename String>
+	static String& map_case_in_place(String& str, unicode::internal::CaseMapping mapping) {
+		const auto mapped = unicode::internal::utf8_case_map_in_place(str.data(), str.size(), mapping);
+		if (mapped == str.size()) {
+			return str;
+		}
+
+		// a code point changes its utf-8 length, the rest goes to a new buffer
+		const HStringView rest = HStringView(str).subview(mapped);
+		const auto mapped_size = mapped + unicode::internal::utf8_case_size(rest.data(), rest.size(), mapping);
+
+		String result;
+		result.reserve_exact(mapped_size);
+		result.resize_and_overwrite(mapped_size, [&](typename String::pointer data, typename String::size_type) {
+			String::traits_type::copy(data, str.data(), mapped);
+			return mapped + unicode::internal::utf8_case_map(rest.data(), rest.size(), data + mapped, mapping);
+		});
+		return str = std::move(result);
+	}
+
+	template<size_t Size>
+	BasicHString<Size>& BasicHString<Size>::to_lower() {
+		return map_case_in_place(*this, unicode::internal::CaseMapping::Lower);
+	}
+
+	template<size_t Size>
+	BasicHString<Size>& BasicHString<Size>::to_upper() {
+		return map_case_in_place(*this, unicode::internal::CaseMapping::Upper);
+	}
+
+	template<size_t Size>
+	BasicHString<Size>& BasicHString<Size>::casefold() {
+		return map_case_in_place(*this, unicode::internal::CaseMapping::Fold);
+	}
+
+	template<size_t Size>
+	BasicHString<Size> BasicHString<Size>::ToLower() const {
+		return map_case<BasicHString>(*this, unicode::internal::CaseMapping::Lower);
+	}
+
+	template<size_t Size>
+	BasicHString<Size> BasicHString<Size>::ToUpper() const {
+		return map_case<BasicHString>(*this, unicode::internal::CaseMapping::Upper);
+	}
+
+	template<size_t Size>
+	BasicHString<Size> BasicHString<Size>::Casefold() const {
+		return map_case<BasicHString>(*this, unicode::internal::CaseMapping::Fold);
+	}
+}
+
 // misc
 namespace hana
 {
-	void HString::reserve(size_type new_cap) {
-		StringHelper helper(this);
+	template<size_t Size>
+	void BasicHString<Size>::reserve(size_type new_cap) {
+		StringHelper<BasicHString> helper(this);
 		helper.reserve(policy_type::get_reserve, new_cap, [&](pointer ptr) {
 			// '\0'
 			traits_type::move(ptr, data(), size() + 1);
 		});
 	}
 
-	void HString::resize(size_type count) {
-		StringHelper helper(this);
+	template<size_t Size>
+	void BasicHString<Size>::reserve_exact(size_type new_cap) {
+		StringHelper<BasicHString> helper(this);
+		helper.reserve([](size_type count) { return count; }, new_cap, [&](pointer ptr) {
+			traits_type::move(ptr, data(), size() + 1);
+		});
+	}
+
+	template<size_t Size>
+	void BasicHString<Size>::resize(size_type count) {
+		StringHelper<BasicHString> helper(this);
 
 		const auto sz = size();
 		reserve(count);
 		if (sz < count) {
-			std::uninitialized_default_construct_n(data() + sz, count);
+			std::uninitialized_default_construct_n(data() + sz, count - sz);
 		}
 		helper.set_size(count);
 	}
 
-	void HString::resize(size_type count, value_type ch) {
-		StringHelper helper(this);
+	template<size_t Size>
+	void BasicHString<Size>::resize(size_type count, value_type ch) {
+		StringHelper<BasicHString> helper(this);
 
 		const auto sz = size();
 		reserve(count);
 		if (sz < count) {
-			std::uninitialized_fill_n(data() + sz, count, ch);
+			std::uninitialized_fill_n(data() + sz, count - sz, ch);
 		}
 		helper.set_size(count);
 	}
 }
+
+// memory resource
+namespace hana
+{
+	HStringResourceScope::HStringResourceScope(std::pmr::memory_resource* resource) noexcept: previous_(string_resource) {
+		string_resource = resource;
+	}
+
+	HStringResourceScope::~HStringResourceScope() noexcept {
+		string_resource = previous_;
+	}
+
+	std::pmr::memory_resource* HStringResourceScope::current() noexcept {
+		return string_resource;
+	}
+}
+
+// instantiations
+namespace hana
+{
+	template class HANA_BASE_API BasicHString<15>;
+	template class HANA_BASE_API BasicHString<31>;
+	template class HANA_BASE_API BasicHString<63>;
+}
@@ -0,0 +1,92 @@
+#include <hana/container/text_index.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace hana
+{
+	// One step of the lenient walk used by unicode::utf8_code_point_index, an ill-formed or cut sequence takes one code unit.
+	static HStringTextIndex::size_type text_step(const char8_t* seq, HStringTextIndex::size_type size, HStringTextIndex::size_type pos) {
+		const auto seq_len = unicode::utf8_seq_len(seq[pos]);
+		return seq_len && pos + seq_len <= size ? seq_len : 1;
+	}
+
+	HStringTextIndex::size_type HStringTextIndex::text_length() {
+		sync();
+		return length_;
+	}
+
+	unicode::UTF8Seq HStringTextIndex::at_text(size_type index) {
+		return str_->at_text(text_index_to_buffer(index));
+	}
+
+	HStringTextIndex::size_type HStringTextIndex::buffer_index_to_text(size_type index) {
+		sync();
+		assert(index < size_);
+		if (ascii_) {
+			return index;
+		}
+
+		const auto checkpoint = std::upper_bound(checkpoints_.begin(), checkpoints_.end(), index) - checkpoints_.begin() - 1;
+		size_type pos = checkpoints_[checkpoint];
+		size_type code_points = static_cast<size_type>(checkpoint) * Stride;
+		do {
+			pos += text_step(data_, size_, pos);
+			++code_points;
+		} while (pos <= index);
+		return code_points - 1;
+	}
+
+	HStringTextIndex::size_type HStringTextIndex::text_index_to_buffer(size_type index) {
+		sync();
+		assert(index <= length_ && "invalid code point index");
+		if (ascii_) {
+			return index;
+		}
+		if (index >= length_) {
+			return size_;
+		}
+
+		size_type pos = checkpoints_[index / Stride];
+		for (size_type i = index % Stride; i > 0; --i) {
+			pos += text_step(data_, size_, pos);
+		}
+		return pos;
+	}
+
+	void HStringTextIndex::reset() noexcept {
+		data_ = nullptr;
+		size_ = HString::npos;
+		checkpoints_.clear();
+	}
+
+	void HStringTextIndex::sync() {
+		if (str_->data() == data_ && str_->size() == size_) {
+			return;
+		}
+
+		data_ = str_->data();
+		size_ = str_->size();
+		checkpoints_.clear();
+
+		// well-formed with one code point per code unit can only be ASCII
+		uint64_t code_points = 0;
+		ascii_ = unicode::internal::utf8_scan(data_, size_, code_points) && code_points == size_;
+		if (ascii_) {
+			length_ = size_;
+			return;
+		}
+
+		checkpoints_.reserve(size_ / Stride + 1);
+		size_type pos = 0;
+		size_type count = 0;
+		while (pos < size_) {
+			if (count % Stride == 0) {
+				checkpoints_.push_back(pos);
+			}
+			pos += text_step(data_, size_, pos);
+			++count;
+		}
+		length_ = count;
+	}
+}
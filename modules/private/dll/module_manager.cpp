@@ -48,10 +48,6 @@ namespace hana
 		return path;
 	}
 
-	size_t do_hash(const HStringView& str) {
-		return Hash<HStringView>()(str);
-	}
-
 	bool process_pdb(const std::filesystem::path& dst) {
 #ifdef _MSC_VER
 		auto basePath = dst.lexically_normal();
@@ -78,14 +74,14 @@ namespace hana
 // internal function
 namespace hana
 {
-	bool ModuleManagerImpl::LoadHotfixModule(SharedLibrary* lib, size_t hash, std::filesystem::path path) {
+	bool ModuleManagerImpl::LoadHotfixModule(SharedLibrary* lib, HName key, std::filesystem::path path) {
 		std::error_code ec;
 		if (!std::filesystem::exists(path, ec)) {
 			LOG_ERROR(u8"Hotfix module ({}) not found!", path.string());
 			return false;
 		}
 
-		auto&& ctx = hotfix_contexts[hash];
+		auto&& ctx = hotfix_contexts[key];
 		const std::filesystem::path new_path = get_version_path(path, ctx.version, ctx.temppath);
 		if (true) {
 			ctx.last_working_version = ctx.version;
@@ -113,13 +109,13 @@ namespace hana
 
 	IModule* ModuleManagerImpl::LoadModule(HString name, const bool shared, const bool load, const int argc, char8_t** argv) {
 		// module existed
-		auto hash = do_hash(name);
-		if (const auto iter = modules_map.find(hash); iter != modules_map.end()) {
+		const HName key{name};
+		if (const auto iter = modules_map.find(key); iter != modules_map.end()) {
 			assert(iter->second->is_shared() == shared);
 			return iter->second;
 		}
 
-		const bool hotfix = hotfix_contexts.contains(hash);
+		const bool hotfix = hotfix_contexts.contains(key);
 		IModule* module;
 
 		// LoadSharedModule
@@ -148,7 +144,7 @@ namespace hana
 						LOG_TRACE(u8"Load dll ({}) success", filename.u8string());
 						func = static_cast<IDynamicModule*(*)()>(shared_library.get_symbol(init_func_name.data()));
 					}
-				} else if (LoadHotfixModule(&shared_library, hash, std::move(filename))) {
+				} else if (LoadHotfixModule(&shared_library, key, std::move(filename))) {
 					LOG_TRACE(u8"Hotfix module ({}) load success", name);
 					func = static_cast<IDynamicModule*(*)()>(shared_library.get_symbol(init_func_name.data()));
 				}
@@ -163,13 +159,13 @@ namespace hana
 			}
 
 			if (hotfix) {
-				hotfixs.emplace(hash);
+				hotfixs.emplace(key);
 			}
 			reinterpret_cast<IDynamicModule*>(module)->shared_library = std::move(shared_library);
 		}
 		// LoadStaticModule
 		else {
-			const auto init_func = static_init_map.find(hash);
+			const auto init_func = static_init_map.find(key);
 			if (init_func == static_init_map.end()) {
 				LOG_FATAL(u8"Static module {} has no initial function!", name);
 			}
@@ -177,12 +173,12 @@ namespace hana
 		}
 
 		module->name = std::move(name);
-		ParseMetaData(module, hash, load, argc, argv);
+		ParseMetaData(module, key, load, argc, argv);
 		assert(hotfix <= module->is_reloadable());
 		if (load) module->on_load(argc, argv);
-		modules_map.emplace(hash, module);
+		modules_map.emplace(key, module);
 
-		for (auto&& func: subsystem_create_map[hash]) {
+		for (auto&& func: subsystem_create_map[key]) {
 			module->subsystems.emplace_back(func());
 		}
 		for (auto&& subsystem: module->subsystems) {
@@ -192,7 +188,7 @@ namespace hana
 		return module;
 	}
 
-	void ModuleManagerImpl::ParseMetaData(IModule* module, size_t hash, bool load, int argc, char8_t** argv) {
+	void ModuleManagerImpl::ParseMetaData(IModule* module, HName key, bool load, int argc, char8_t** argv) {
 		auto reader = JsonReader::create(module->get_meta_data());
 		reader->start_object(u8"");
 		if (true) {
@@ -207,7 +203,7 @@ namespace hana
 
 			size_t count;
 			reader->start_array(u8"dependencies", count);
-			if (count == 0) roots.emplace(hash);
+			if (count == 0) roots.emplace(key);
 
 			for (auto i = 0; i < count; i++) {
 				HString name, kind;
@@ -225,27 +221,27 @@ namespace hana
 		// reader.end_object();
 	}
 
-	void ModuleManagerImpl::UnloadModule(size_t hash) {
-		auto&& module_iter = modules_map.find(hash);
+	void ModuleManagerImpl::UnloadModule(HName key) {
+		auto&& module_iter = modules_map.find(key);
 		if (module_iter == modules_map.end()) return;
 
 		auto&& module = module_iter->second;
 		dependency_graph->foreach_neighbors(module, [this](GraphNode* node) {
-			UnloadModule(do_hash(reinterpret_cast<IModule*>(node)->name));
+			UnloadModule(HName{reinterpret_cast<IModule*>(node)->name});
 		});
 
 		for (auto&& subsystem: module->subsystems) {
 			subsystem->shutdown();
 			delete subsystem;
 		}
-		subsystem_id_map.erase(hash);
+		subsystem_id_map.erase(key);
 		modules_map.erase(module_iter);
-		destruction.emplace_back(module, hash);
+		destruction.emplace_back(module, key);
 	}
 
 	void ModuleManagerImpl::DestroyModules() {
-		for (auto&& [module, hash]: destruction) {
-			if (auto&& iter = hotfixs.find(hash); iter != hotfixs.end()) hotfixs.erase(iter);
+		for (auto&& [module, key]: destruction) {
+			if (auto&& iter = hotfixs.find(key); iter != hotfixs.end()) hotfixs.erase(iter);
 
 			dependency_graph->remove_vertex(module);
 
@@ -268,7 +264,7 @@ namespace hana
 	}
 
 	int ModuleManagerImpl::execute(const char8_t* name, const int argc, char8_t** argv) {
-		auto&& module_iter = modules_map.find(do_hash(name));
+		auto&& module_iter = modules_map.find(HName::find(name));
 		if (module_iter == modules_map.end()) {
 			LOG_ERROR(u8"Module ({}) not exists!", name);
 			return -1;
@@ -280,12 +276,12 @@ namespace hana
 	// 1.Do not save objects that have pointers to anything that is not in the heap;
 	// 2.Do not save objects that have non-trivial constructors and destructors, they may or may not work;
 	bool ModuleManagerImpl::update() {
-		for (auto hash: hotfixs) {
-			auto&& ctx = hotfix_contexts[hash];
+		for (auto key: hotfixs) {
+			auto&& ctx = hotfix_contexts[key];
 
 			if (std::filesystem::last_write_time(ctx.path) > ctx.timestamp) {
 				// unload old module
-				const auto this_module = reinterpret_cast<IHotfixModule*>(modules_map[hash]);
+				const auto this_module = reinterpret_cast<IHotfixModule*>(modules_map[key]);
 				this_module->on_reload_begin();
 				for (auto&& subsystem: this_module->subsystems) subsystem->begin_reload();
 				const auto this_state = this_module->state;
@@ -294,7 +290,7 @@ namespace hana
 				SharedLibrary shared_library = std::move(this_module->shared_library);
 				delete this_module;
 
-				if (!LoadHotfixModule(&shared_library, hash, get_file_name(this_name))) {
+				if (!LoadHotfixModule(&shared_library, key, get_file_name(this_name))) {
 					return false;
 				}
 
@@ -309,9 +305,9 @@ namespace hana
 				const auto new_module = reinterpret_cast<IHotfixModule*>(func());
 				new_module->shared_library = std::move(shared_library);
 				new_module->name = std::move(this_name);
-				ParseMetaData(new_module, hash, false);
-				modules_map[hash] = new_module;
-				for (auto&& create: subsystem_create_map[hash]) {
+				ParseMetaData(new_module, key, false);
+				modules_map[key] = new_module;
+				for (auto&& create: subsystem_create_map[key]) {
 					new_module->subsystems.emplace_back(create());
 				}
 				for (auto&& subsystem: new_module->subsystems) {
@@ -329,18 +325,18 @@ namespace hana
 
 	void ModuleManagerImpl::unload(const char8_t* name) {
 		destruction.clear();
-		const auto hash = do_hash(name);
-		UnloadModule(hash);
+		const auto key = HName::find(name);
+		UnloadModule(key);
 		DestroyModules();
 
-		if (auto&& iter = roots.find(hash); iter != roots.end()) {
+		if (auto&& iter = roots.find(key); iter != roots.end()) {
 			roots.erase(iter);
 		}
 	}
 
 	void ModuleManagerImpl::destroy() {
 		destruction.clear();
-		for (const auto hash: roots) UnloadModule(hash);
+		for (const auto key: roots) UnloadModule(key);
 		DestroyModules();
 		roots.clear();
 	}
@@ -370,35 +366,35 @@ namespace hana
 	}
 
 	void ModuleManagerImpl::enable_hotfix_for_module(const char8_t* name) {
-		hotfix_contexts.emplace(do_hash(name), ModuleContext{});
+		hotfix_contexts.emplace(HName{name}, ModuleContext{});
 	}
 
 	void ModuleManagerImpl::register_subsystem(const char8_t* name, const char8_t* id, IModuleSubsystem*(*func)()) {
-		const auto hash_name = do_hash(name);
+		const HName module_name{name};
 
-		auto creataion = subsystem_create_map[hash_name];
+		auto creataion = subsystem_create_map[module_name];
 		for (auto&& pfn: creataion) {
 			if (pfn == func) return;
 		}
 
-		auto sub_id = subsystem_id_map[hash_name];
-		const auto hash_id = do_hash(id);
+		auto sub_id = subsystem_id_map[module_name];
+		const HName subsystem_id{id};
 		for (auto&& ID: sub_id) {
-			if (ID == hash_id) return;
+			if (ID == subsystem_id) return;
 		}
 
 		creataion.emplace_back(func);
-		sub_id.emplace_back(hash_id);
+		sub_id.emplace_back(subsystem_id);
 	}
 
 	void ModuleManagerImpl::register_statically_linked_module(const char8_t* name, IStaticModule*(*func)()) {
-		if (const auto hash = do_hash(name); !static_init_map.contains(hash)) {
-			static_init_map.emplace(hash, func);
+		if (const HName key{name}; !static_init_map.contains(key)) {
+			static_init_map.emplace(key, func);
 		}
 	}
 
 	IModule* ModuleManagerImpl::get_module(const char8_t* name) noexcept {
-		auto&& iter = modules_map.find(do_hash(name));
+		auto&& iter = modules_map.find(HName::find(name));
 		return iter == modules_map.end() ? nullptr : iter->second;
 	}
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <hana/dll/module.hpp>
+#include <hana/container/name.hpp>
 #include <hana/graph/graph.hpp>
 #include <hana/graph/graphviz.hpp>
 #include <hana/dll/shared_library.hpp>
@@ -55,25 +56,25 @@ namespace hana
 		ModuleManagerImpl() noexcept;
 		~ModuleManagerImpl() noexcept;
 
-		bool LoadHotfixModule(SharedLibrary* lib, size_t hash, std::filesystem::path path);
+		bool LoadHotfixModule(SharedLibrary* lib, HName key, std::filesystem::path path);
 		IModule* LoadModule(HString name, bool shared, bool load, int argc = 0, char8_t** argv = nullptr);
-		void ParseMetaData(IModule* module, size_t hash, bool load, int argc = 0, char8_t** argv = nullptr);
-		void UnloadModule(size_t hash);
+		void ParseMetaData(IModule* module, HName key, bool load, int argc = 0, char8_t** argv = nullptr);
+		void UnloadModule(HName key);
 		void DestroyModules();
 
 		RCUnique<Graph> dependency_graph;
 		SharedLibrary process_symbol_table;
 		std::filesystem::path root; // 动态库根目录
 
-		std::vector<std::pair<IModule*, size_t>> destruction;
+		std::vector<std::pair<IModule*, HName>> destruction;
 
-		phmap::flat_hash_set<size_t> roots; // 依赖图顶层
-		phmap::flat_hash_set<size_t> hotfixs;
-		phmap::flat_hash_map<size_t, IModule*> modules_map;
-		phmap::flat_hash_map<size_t, ModuleContext> hotfix_contexts;
+		phmap::flat_hash_set<HName> roots; // 依赖图顶层
+		phmap::flat_hash_set<HName> hotfixs;
+		phmap::flat_hash_map<HName, IModule*> modules_map;
+		phmap::flat_hash_map<HName, ModuleContext> hotfix_contexts;
 
-		phmap::flat_hash_map<size_t, std::vector<size_t>> subsystem_id_map;
-		phmap::flat_hash_map<size_t, IStaticModule* (*)()> static_init_map;
-		phmap::flat_hash_map<size_t, std::vector<IModuleSubsystem* (*)()>> subsystem_create_map;
+		phmap::flat_hash_map<HName, std::vector<HName>> subsystem_id_map;
+		phmap::flat_hash_map<HName, IStaticModule* (*)()> static_init_map;
+		phmap::flat_hash_map<HName, std::vector<IModuleSubsystem* (*)()>> subsystem_create_map;
 	};
 }
@@ -1,4 +1,5 @@
 #include <hana/log.hpp>
+#include <hana/container/fixed_string.hpp>
 #include <hana/platform/thread.hpp>
 
 #include <array>
@@ -51,43 +52,8 @@ namespace hana
 
 		template<typename T>
 		void fromi(T num) {
-			if constexpr (Size & 1) {
-				s[Size - 1] = '0' + (num % 10);
-				num /= 10;
-			}
-			switch (Size & -2) {
-				case 18: *(uint16_t*) (s + 16) = *(uint16_t*) (digit_pairs + ((num % 100) << 1));
-					num /= 100;
-				case 16: *(uint16_t*) (s + 14) = *(uint16_t*) (digit_pairs + ((num % 100) << 1));
-					num /= 100;
-				case 14: *(uint16_t*) (s + 12) = *(uint16_t*) (digit_pairs + ((num % 100) << 1));
-					num /= 100;
-				case 12: *(uint16_t*) (s + 10) = *(uint16_t*) (digit_pairs + ((num % 100) << 1));
-					num /= 100;
-				case 10: *(uint16_t*) (s + 8) = *(uint16_t*) (digit_pairs + ((num % 100) << 1));
-					num /= 100;
-				case 8: *(uint16_t*) (s + 6) = *(uint16_t*) (digit_pairs + ((num % 100) << 1));
-					num /= 100;
-				case 6: *(uint16_t*) (s + 4) = *(uint16_t*) (digit_pairs + ((num % 100) << 1));
-					num /= 100;
-				case 4: *(uint16_t*) (s + 2) = *(uint16_t*) (digit_pairs + ((num % 100) << 1));
-					num /= 100;
-				case 2: *(uint16_t*) (s + 0) = *(uint16_t*) (digit_pairs + ((num % 100) << 1));
-					num /= 100;
-			}
+			internal::write_digits(s, Size, static_cast<std::make_unsigned_t<T>>(num));
 		}
-
-		static constexpr const char8_t* digit_pairs =
-				u8"00010203040506070809"
-				"10111213141516171819"
-				"20212223242526272829"
-				"30313233343536373839"
-				"40414243444546474849"
-				"50515253545556575859"
-				"60616263646566676869"
-				"70717273747576777879"
-				"80818283848586878889"
-				"90919293949596979899";
 	};
 
 	struct MsgHeader {
@@ -280,103 +246,7 @@ namespace hana
 		SPSCVarQueueOPT varq;
 		bool shouldDeallocate = false;
 		uint32_t tid;
-		HString name;
-	};
-
-	template<size_t SIZE = 1000, typename Allocator = std::allocator<char8_t>>
-	class memory_buffer : public fmt::buffer {
-	public:
-		using value_type = char8_t;
-		using const_reference = const char8_t&;
-
-		explicit memory_buffer(const Allocator& alloc = Allocator()): buffer(grow), alloc_(alloc) {
-			this->set(store_, SIZE);
-		}
-
-		memory_buffer(memory_buffer&& other) noexcept : buffer(grow) {
-			this->move(other);
-		}
-
-		~memory_buffer() { deallocate(); }
-
-		// Moves the content of the other `memory_buffer` object to this one.
-		memory_buffer& operator=(memory_buffer&& other) noexcept {
-			assert(this != &other);
-			deallocate();
-			this->move(other);
-			return *this;
-		}
-
-		// Returns a copy of the allocator associated with this buffer.
-		Allocator get_allocator() const { return alloc_; }
-
-		/// Resizes the buffer to contain `count` elements. If T is a POD type new
-		/// elements may not be initialized.
-		void resize(size_t count) { this->try_resize(count); }
-
-		/// Increases the buffer capacity to `new_capacity`.
-		void reserve(size_t new_capacity) { this->try_reserve(new_capacity); }
-
-		using buffer::append;
-
-		template<typename ContiguousRange>
-		void append(const ContiguousRange& range) {
-			this->append(range.data(), range.data() + range.size());
-		}
-
-	private:
-		// Move data from other to this buffer.
-		void move(memory_buffer& other) {
-			alloc_ = std::move(other.alloc_);
-			char8_t* data = other.data();
-			const size_t size = other.size();
-			const size_t capacity = other.capacity();
-			if (data == other.store_) {
-				this->set(store_, capacity);
-				std::copy(other.store_, other.store_ + size, store_);
-			} else {
-				this->set(data, capacity);
-				// Set pointer to the inline array so that delete is not called
-				// when deallocating.
-				other.set(other.store_, 0);
-				other.clear();
-			}
-			this->resize(size);
-		}
-
-		char8_t store_[SIZE];
-
-		// Don't inherit from Allocator to avoid generating type_info for it.
-		[[no_unique_address]] Allocator alloc_;
-
-		// Deallocate memory allocated by the buffer.
-		void deallocate() {
-			char8_t* data = this->data();
-			if (data != store_) alloc_.deallocate(data, this->capacity());
-		}
-
-		static void grow(buffer* buf, size_t size) {
-			// assert(size <= 5000);
-			auto& self = *reinterpret_cast<memory_buffer*>(buf);
-			const size_t max_size = std::allocator_traits<Allocator>::max_size(self.alloc_);
-			size_t old_capacity = buf->capacity();
-			size_t new_capacity = old_capacity + old_capacity / 2;
-			if (size > new_capacity)
-				new_capacity = size;
-			else if (new_capacity > max_size)
-				new_capacity = std::max(size, max_size);
-			char8_t* old_data = buf->data();
-			char8_t* new_data = self.alloc_.allocate(new_capacity);
-			// Suppress a bogus -Wstringop-overflow in gcc 13.1 (#3481).
-			[[assume(buf.size() <= new_capacity)]];
-			// The following code doesn't throw, so the raw pointer above doesn't leak.
-			memcpy(new_data, old_data, buf->size());
-			self.set(new_data, new_capacity);
-			// deallocate must not throw according to the standard, but even if it does,
-			// the buffer already uses the new storage and will deallocate it in
-			// destructor.
-			if (old_data != self.store_) self.alloc_.deallocate(old_data, old_capacity);
-		}
+		HFixedString<Thread::MAX_THREAD_NAME_LENGTH> name;
 	};
 
 	struct HeapNode {
@@ -665,7 +535,7 @@ namespace hana
 		std::vector<ThreadBuffer*> threadBuffers;
 		std::vector<HeapNode> bgThreadBuffers;
 		std::mutex bufferMutex;
-		memory_buffer<> membuf;
+		fmt::memory_buffer<> membuf;
 
 		void preallocate() {
 			if (threadBuffer) return;
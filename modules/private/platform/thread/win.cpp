@@ -1,4 +1,5 @@
 #include <hana/platform/thread.hpp>
+#include <hana/container/fixed_string.hpp>
 
 #include <iterator>
 
@@ -7,7 +8,7 @@
 
 namespace hana
 {
-	thread_local char thread_name[Thread::MAX_THREAD_NAME_LENGTH + 1] = "unnamed";
+	thread_local HFixedString<Thread::MAX_THREAD_NAME_LENGTH> thread_name = u8"unnamed";
 
 	static constexpr int priorities[] = {
 		THREAD_PRIORITY_NORMAL,
@@ -41,12 +42,12 @@ namespace hana
 		buffer[resultLength] = 0;
 
 		SetThreadDescription(GetCurrentThread(), buffer);
-		strcpy_s(thread_name, MAX_THREAD_NAME_LENGTH + 1, name.raw_data());
+		thread_name = name;
 		delete buffer;
 	}
 
 	const char8_t* Thread::get_current_name() noexcept {
-		return reinterpret_cast<const char8_t*>(thread_name);
+		return thread_name.c_str();
 	}
 
 	ThreadPriority Thread::set_priority(ThreadPriority pr) noexcept {
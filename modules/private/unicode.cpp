@@ -0,0 +1,3 @@
+#include "unicode/utf8.cpp"
+#include "unicode/transcode.cpp"
+#include "unicode/case.cpp"
\ No newline at end of file
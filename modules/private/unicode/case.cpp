@@ -0,0 +1,402 @@
+#include <hana/unicode/algorithm.hpp>
+
+#include "simd.hpp"
+#include "case_tables.hpp"
+
+namespace hana::unicode
+{
+	char32_t to_lower(char32_t ch) noexcept {
+		if (ch < 0x80) {
+			return ch - U'A' < 26 ? ch + 0x20 : ch;
+		}
+		return internal::kLowerData.map(ch);
+	}
+
+	char32_t to_upper(char32_t ch) noexcept {
+		if (ch < 0x80) {
+			return ch - U'a' < 26 ? ch - 0x20 : ch;
+		}
+		return internal::kUpperData.map(ch);
+	}
+
+	char32_t casefold(char32_t ch) noexcept {
+		if (ch < 0x80) {
+			return ch - U'A' < 26 ? ch + 0x20 : ch;
+		}
+		return internal::kFoldData.map(ch);
+	}
+}
+
+namespace hana::unicode::internal
+{
+	static constexpr uint64_t kCaseNpos = static_cast<uint64_t>(-1);
+
+	// ill-formed code units fold above the code space, so they only match themselves
+	static constexpr char32_t kIllFormedBase = 0x110000;
+
+#pragma region scalar
+
+	// first code unit of the ASCII range the mapping changes, bit 5 toggles the case inside [first, first + 26)
+	static constexpr char8_t ascii_case_first(CaseMapping mapping) noexcept {
+		return mapping == CaseMapping::Upper ? u8'a' : u8'A';
+	}
+
+	static inline char8_t ascii_case(char8_t ch, char8_t first) noexcept {
+		return static_cast<uint8_t>(ch - first) < 26 ? static_cast<char8_t>(ch ^ 0x20) : ch;
+	}
+
+	static inline char32_t map_case(char32_t ch, CaseMapping mapping) noexcept {
+		switch (mapping) {
+			case CaseMapping::Lower: return to_lower(ch);
+			case CaseMapping::Upper: return to_upper(ch);
+			default: return casefold(ch);
+		}
+	}
+
+	static inline uint64_t case_seq_size(const char8_t* seq, uint64_t size, uint64_t& pos, CaseMapping mapping) {
+		if (seq[pos] < 0x80) {
+			++pos;
+			return 1;
+		}
+
+		char32_t value;
+		const auto result = decode_utf(seq + pos, seq + size, value);
+		const auto len = static_cast<uint64_t>(result.next_ptr_ - (seq + pos));
+		pos += len;
+		return result.is_unicode_scalar_value_ ? utf8_seq_len(map_case(value, mapping)) : len;
+	}
+
+	static inline uint64_t case_seq_map(const char8_t* seq, uint64_t size, uint64_t& pos, char8_t* dst, CaseMapping mapping) {
+		if (seq[pos] < 0x80) {
+			dst[0] = ascii_case(seq[pos], ascii_case_first(mapping));
+			++pos;
+			return 1;
+		}
+
+		char32_t value;
+		const auto result = decode_utf(seq + pos, seq + size, value);
+		const auto len = static_cast<uint64_t>(result.next_ptr_ - (seq + pos));
+		const char32_t mapped = result.is_unicode_scalar_value_ ? map_case(value, mapping) : value;
+		if (mapped == value) {
+			std::memcpy(dst, seq + pos, len);
+			pos += len;
+			return len;
+		}
+
+		const UTF8Seq utf8_seq{mapped};
+		std::memcpy(dst, utf8_seq.data, utf8_seq.len);
+		pos += len;
+		return utf8_seq.len;
+	}
+
+	// return: false, leaving seq untouched, if the mapped code point has another utf-8 length
+	static inline bool case_seq_map_in_place(char8_t* seq, uint64_t size, uint64_t& pos, CaseMapping mapping) {
+		if (seq[pos] < 0x80) {
+			seq[pos] = ascii_case(seq[pos], ascii_case_first(mapping));
+			++pos;
+			return true;
+		}
+
+		char32_t value;
+		const auto result = decode_utf(seq + pos, seq + size, value);
+		const auto len = static_cast<uint64_t>(result.next_ptr_ - (seq + pos));
+		const char32_t mapped = result.is_unicode_scalar_value_ ? map_case(value, mapping) : value;
+		if (mapped != value) {
+			const UTF8Seq utf8_seq{mapped};
+			if (utf8_seq.len != len) {
+				return false;
+			}
+			std::memcpy(seq + pos, utf8_seq.data, len);
+		}
+		pos += len;
+		return true;
+	}
+
+	static inline char32_t fold_seq(const char8_t* seq, uint64_t size, uint64_t& pos) {
+		if (seq[pos] < 0x80) {
+			return ascii_case(seq[pos++], u8'A');
+		}
+
+		char32_t value;
+		const auto result = decode_utf(seq + pos, seq + size, value);
+		if (!result.is_unicode_scalar_value_) {
+			return kIllFormedBase + seq[pos++];
+		}
+		pos = static_cast<uint64_t>(result.next_ptr_ - seq);
+		return casefold(value);
+	}
+
+#pragma endregion scalar
+
+#pragma region blocks
+
+	// Block helpers work on 16 code units. A mask has kCaseMaskUnitBits bits per code unit (NEON has no movemask), returning
+	// false or a non-zero mask leaves the rest to the scalar step. Targets without a vector unit never run the blocks.
+#if defined(HANA_UNICODE_X64)
+
+	static constexpr uint32_t kCaseMaskUnitBits = 1;
+
+	// bytes in [first, first + 26) get bit 5 toggled, the add moves that range to the bottom of the signed byte range
+	static inline __m128i ascii_case_sse2(__m128i input, char8_t first) {
+		const __m128i shifted = _mm_add_epi8(input, _mm_set1_epi8(static_cast<char>(0x80 - first)));
+		const __m128i in_range = _mm_cmplt_epi8(shifted, _mm_set1_epi8(-128 + 26));
+		return _mm_xor_si128(input, _mm_and_si128(in_range, _mm_set1_epi8(0x20)));
+	}
+
+	static inline bool case_block(const char8_t* seq, char8_t* dst, char8_t first) {
+		const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(seq));
+		if (_mm_movemask_epi8(input) != 0) {
+			return false;
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), ascii_case_sse2(input, first));
+		return true;
+	}
+
+	static inline bool ascii_block(const char8_t* seq) {
+		return _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(seq))) == 0;
+	}
+
+	// units that differ after folding or are not ASCII on either side
+	static inline uint64_t fold_stop_block(const char8_t* lhs, const char8_t* rhs) {
+		const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs));
+		const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs));
+		const auto equal = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ascii_case_sse2(a, u8'A'), ascii_case_sse2(b, u8'A'))));
+		return (~equal | static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(a, b)))) & 0xFFFF;
+	}
+
+	// units equal to the folded ASCII code unit ch after folding, or not ASCII
+	static inline uint64_t fold_find_block(const char8_t* seq, char8_t ch) {
+		const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(seq));
+		const __m128i hit = _mm_cmpeq_epi8(ascii_case_sse2(input, u8'A'), _mm_set1_epi8(static_cast<char>(ch)));
+		return static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(hit, input)));
+	}
+
+#elif defined(HANA_UNICODE_NEON)
+
+	static constexpr uint32_t kCaseMaskUnitBits = 4;
+
+	static inline uint64_t case_mask_neon(uint8x16_t hit) {
+		return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hit), 4)), 0);
+	}
+
+	static inline uint8x16_t ascii_case_neon(uint8x16_t input, char8_t first) {
+		const uint8x16_t in_range = vcltq_u8(vsubq_u8(input, vdupq_n_u8(first)), vdupq_n_u8(26));
+		return veorq_u8(input, vandq_u8(in_range, vdupq_n_u8(0x20)));
+	}
+
+	static inline bool case_block(const char8_t* seq, char8_t* dst, char8_t first) {
+		const uint8x16_t input = vld1q_u8(reinterpret_cast<const uint8_t*>(seq));
+		if (vmaxvq_u8(input) >= 0x80) {
+			return false;
+		}
+		vst1q_u8(reinterpret_cast<uint8_t*>(dst), ascii_case_neon(input, first));
+		return true;
+	}
+
+	static inline bool ascii_block(const char8_t* seq) {
+		return vmaxvq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(seq))) < 0x80;
+	}
+
+	static inline uint64_t fold_stop_block(const char8_t* lhs, const char8_t* rhs) {
+		const uint8x16_t a = vld1q_u8(reinterpret_cast<const uint8_t*>(lhs));
+		const uint8x16_t b = vld1q_u8(reinterpret_cast<const uint8_t*>(rhs));
+		const uint8x16_t differ = vmvnq_u8(vceqq_u8(ascii_case_neon(a, u8'A'), ascii_case_neon(b, u8'A')));
+		const uint8x16_t non_ascii = vcgeq_u8(vorrq_u8(a, b), vdupq_n_u8(0x80));
+		return case_mask_neon(vorrq_u8(differ, non_ascii));
+	}
+
+	static inline uint64_t fold_find_block(const char8_t* seq, char8_t ch) {
+		const uint8x16_t input = vld1q_u8(reinterpret_cast<const uint8_t*>(seq));
+		const uint8x16_t hit = vceqq_u8(ascii_case_neon(input, u8'A'), vdupq_n_u8(ch));
+		return case_mask_neon(vorrq_u8(hit, vcgeq_u8(input, vdupq_n_u8(0x80))));
+	}
+
+#endif
+
+#if defined(HANA_UNICODE_X64) || defined(HANA_UNICODE_NEON)
+	static constexpr uint64_t kCaseBlockUnits = 16;
+#else
+	// no vector unit, the block loops below never run
+	static constexpr uint64_t kCaseBlockUnits = UINT64_MAX;
+	static constexpr uint32_t kCaseMaskUnitBits = 1;
+
+	static inline bool case_block(const char8_t*, char8_t*, char8_t) { return false; }
+	static inline bool ascii_block(const char8_t*) { return false; }
+	static inline uint64_t fold_stop_block(const char8_t*, const char8_t*) { return 1; }
+	static inline uint64_t fold_find_block(const char8_t*, char8_t) { return 1; }
+#endif
+
+	static inline uint64_t first_unit(uint64_t mask) {
+		return static_cast<uint64_t>(std::countr_zero(mask)) / kCaseMaskUnitBits;
+	}
+
+#pragma endregion blocks
+
+#pragma region compare
+
+	// Walks both sides while their folded code points match, lhs_pos and rhs_pos end past the last code points compared.
+	// return: <0, 0 or >0 comparing the first folded code points that differ, 0 if either side ran out first
+	static int fold_compare(const char8_t* lhs, uint64_t lhs_size, uint64_t& lhs_pos, const char8_t* rhs, uint64_t rhs_size, uint64_t& rhs_pos) {
+		// positions stay in registers, going through the references every unit serializes the loop on memory
+		uint64_t i = lhs_pos;
+		uint64_t j = rhs_pos;
+		int result = 0;
+		while (i < lhs_size && j < rhs_size) {
+			if (lhs_size - i >= kCaseBlockUnits && rhs_size - j >= kCaseBlockUnits) {
+				const uint64_t stop = fold_stop_block(lhs + i, rhs + j);
+				if (stop == 0) {
+					i += kCaseBlockUnits;
+					j += kCaseBlockUnits;
+					continue;
+				}
+				// the units before the stop are equal ASCII, so both sides are still on code point boundaries
+				const uint64_t skip = first_unit(stop);
+				i += skip;
+				j += skip;
+			}
+
+			char32_t a = lhs[i];
+			char32_t b = rhs[j];
+			if ((a | b) < 0x80) {
+				a = ascii_case(static_cast<char8_t>(a), u8'A');
+				b = ascii_case(static_cast<char8_t>(b), u8'A');
+				++i;
+				++j;
+			} else {
+				a = fold_seq(lhs, lhs_size, i);
+				b = fold_seq(rhs, rhs_size, j);
+			}
+			if (a != b) {
+				result = a < b ? -1 : 1;
+				break;
+			}
+		}
+		lhs_pos = i;
+		rhs_pos = j;
+		return result;
+	}
+
+#pragma endregion compare
+
+	uint64_t utf8_case_size(const char8_t* seq, uint64_t size, CaseMapping mapping) noexcept {
+		uint64_t pos = 0;
+		uint64_t mapped_size = 0;
+		while (size - pos >= kCaseBlockUnits) {
+			if (ascii_block(seq + pos)) {
+				pos += kCaseBlockUnits;
+				mapped_size += kCaseBlockUnits;
+				continue;
+			}
+			// a sequence may run past the block
+			for (const uint64_t stop = pos + kCaseBlockUnits; pos < stop;) {
+				mapped_size += case_seq_size(seq, size, pos, mapping);
+			}
+		}
+		while (pos < size) {
+			mapped_size += case_seq_size(seq, size, pos, mapping);
+		}
+		return mapped_size;
+	}
+
+	uint64_t utf8_case_map(const char8_t* seq, uint64_t size, char8_t* dst, CaseMapping mapping) noexcept {
+		const char8_t first = ascii_case_first(mapping);
+		uint64_t pos = 0;
+		uint64_t written = 0;
+		while (size - pos >= kCaseBlockUnits) {
+			if (case_block(seq + pos, dst + written, first)) {
+				pos += kCaseBlockUnits;
+				written += kCaseBlockUnits;
+				continue;
+			}
+			for (const uint64_t stop = pos + kCaseBlockUnits; pos < stop;) {
+				written += case_seq_map(seq, size, pos, dst + written, mapping);
+			}
+		}
+		while (pos < size) {
+			written += case_seq_map(seq, size, pos, dst + written, mapping);
+		}
+		return written;
+	}
+
+	uint64_t utf8_case_map_in_place(char8_t* seq, uint64_t size, CaseMapping mapping) noexcept {
+		const char8_t first = ascii_case_first(mapping);
+		uint64_t pos = 0;
+		while (size - pos >= kCaseBlockUnits) {
+			// loads the whole block before storing it, so source and destination may be the same
+			if (case_block(seq + pos, seq + pos, first)) {
+				pos += kCaseBlockUnits;
+				continue;
+			}
+			for (const uint64_t stop = pos + kCaseBlockUnits; pos < stop;) {
+				if (!case_seq_map_in_place(seq, size, pos, mapping)) {
+					return pos;
+				}
+			}
+		}
+		while (pos < size) {
+			if (!case_seq_map_in_place(seq, size, pos, mapping)) {
+				return pos;
+			}
+		}
+		return pos;
+	}
+
+	int utf8_icompare(const char8_t* lhs, uint64_t lhs_size, const char8_t* rhs, uint64_t rhs_size) noexcept {
+		uint64_t lhs_pos = 0;
+		uint64_t rhs_pos = 0;
+		if (const int result = fold_compare(lhs, lhs_size, lhs_pos, rhs, rhs_size, rhs_pos)) {
+			return result;
+		}
+		return static_cast<int>(lhs_pos < lhs_size) - static_cast<int>(rhs_pos < rhs_size);
+	}
+
+	bool utf8_iequals(const char8_t* lhs, uint64_t lhs_size, const char8_t* rhs, uint64_t rhs_size) noexcept {
+		if (lhs == rhs && lhs_size == rhs_size) {
+			return true;
+		}
+		uint64_t lhs_pos = 0;
+		uint64_t rhs_pos = 0;
+		return fold_compare(lhs, lhs_size, lhs_pos, rhs, rhs_size, rhs_pos) == 0 && lhs_pos == lhs_size && rhs_pos == rhs_size;
+	}
+
+	uint64_t utf8_ifind(const char8_t* seq, uint64_t size, const char8_t* pattern, uint64_t count, uint64_t pos) noexcept {
+		if (pos > size) {
+			return kCaseNpos;
+		}
+		if (count == 0) {
+			return pos;
+		}
+
+		// a candidate is a unit folding to the first unit of an ASCII pattern or any non-ASCII unit, since K (U+212A) and
+		// long s (U+017F) fold into ASCII; a pattern starting with another code point only matches at non-ASCII units
+		uint64_t first_len = 0;
+		const char32_t first = fold_seq(pattern, count, first_len);
+		const char8_t first_unit_ch = first < 0x80 ? static_cast<char8_t>(first) : char8_t{0x80};
+
+		while (pos < size) {
+			if (size - pos >= kCaseBlockUnits) {
+				const uint64_t candidates = fold_find_block(seq + pos, first_unit_ch);
+				if (candidates == 0) {
+					pos += kCaseBlockUnits;
+					continue;
+				}
+				pos += first_unit(candidates);
+			} else if (seq[pos] < 0x80 && ascii_case(seq[pos], u8'A') != first_unit_ch) {
+				++pos;
+				continue;
+			}
+
+			uint64_t next = pos;
+			const char32_t ch = fold_seq(seq, size, next);
+			if (ch == first) {
+				uint64_t seq_pos = next;
+				uint64_t pattern_pos = first_len;
+				if (fold_compare(seq, size, seq_pos, pattern, count, pattern_pos) == 0 && pattern_pos == count) {
+					return pos;
+				}
+			}
+			pos = next;
+		}
+		return kCaseNpos;
+	}
+}
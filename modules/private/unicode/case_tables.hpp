@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstdint>
+#include <algorithm>
+
+// Simple (1:1) case mappings of the Unicode Character Database 14.0.0, code points below 0x80 are left to the ASCII path.
+// lower and upper come from the simple mapping fields of UnicodeData.txt, fold from the C and S entries of
+// CaseFolding.txt. Generated, do not edit.
+namespace hana::unicode::internal
+{
+	/*!
+	 * @brief Runs of code points sharing one mapping delta, searched by their first code point.
+	 *
+	 * A run either maps every code point in [first, first + size) or, for the upper/lower pairs that alternate through
+	 * Latin Extended and Cyrillic, every other one starting at first.
+	 */
+	template<size_t NumRanges>
+	struct CaseMappingData {
+		uint32_t lower_bounds[NumRanges];
+		// run size << 1 | 1 if the run alternates
+		uint16_t sizes_and_strides[NumRanges];
+		int32_t deltas[NumRanges];
+
+		constexpr char32_t map(char32_t ch) const noexcept {
+			const auto index = std::upper_bound(lower_bounds, std::end(lower_bounds), static_cast<uint32_t>(ch)) - lower_bounds;
+			if (index == 0) {
+				return ch;
+			}
+			const uint32_t offset = static_cast<uint32_t>(ch) - lower_bounds[index - 1];
+			const uint16_t data = sizes_and_strides[index - 1];
+			const uint32_t stride = (data & 1) + 1;
+			if (offset % stride != 0 || offset / stride >= static_cast<uint32_t>(data >> 1)) {
+				return ch;
+			}
+			return static_cast<char32_t>(static_cast<int32_t>(ch) + deltas[index - 1]);
+		}
+	};
+
+	inline constexpr CaseMappingData<181> kLowerData{
+		{0xc0, 0xd8, 0x100, 0x130, 0x132, 0x139, 0x14a, 0x178, 0x179, 0x181, 0x182, 0x186, 0x187, 0x189, 0x18b, 0x18e, 0x18f,
+		0x190, 0x191, 0x193, 0x194, 0x196, 0x197, 0x198, 0x19c, 0x19d, 0x19f, 0x1a0, 0x1a6, 0x1a7, 0x1a9, 0x1ac, 0x1ae, 0x1af,
+		0x1b1, 0x1b3, 0x1b7, 0x1b8, 0x1bc, 0x1c4, 0x1c5, 0x1c7, 0x1c8, 0x1ca, 0x1cb, 0x1de, 0x1f1, 0x1f2, 0x1f6, 0x1f7, 0x1f8,
+		0x220, 0x222, 0x23a, 0x23b, 0x23d, 0x23e, 0x241, 0x243, 0x244, 0x245, 0x246, 0x370, 0x376, 0x37f, 0x386, 0x388, 0x38c,
+		0x38e, 0x391, 0x3a3, 0x3cf, 0x3d8, 0x3f4, 0x3f7, 0x3f9, 0x3fa, 0x3fd, 0x400, 0x410, 0x460, 0x48a, 0x4c0, 0x4c1, 0x4d0,
+		0x531, 0x10a0, 0x10c7, 0x10cd, 0x13a0, 0x13f0, 0x1c90, 0x1cbd, 0x1e00, 0x1e9e, 0x1ea0, 0x1f08, 0x1f18, 0x1f28, 0x1f38,
+		0x1f48, 0x1f59, 0x1f68, 0x1f88, 0x1f98, 0x1fa8, 0x1fb8, 0x1fba, 0x1fbc, 0x1fc8, 0x1fcc, 0x1fd8, 0x1fda, 0x1fe8,
+		0x1fea, 0x1fec, 0x1ff8, 0x1ffa, 0x1ffc, 0x2126, 0x212a, 0x212b, 0x2132, 0x2160, 0x2183, 0x24b6, 0x2c00, 0x2c60,
+		0x2c62, 0x2c63, 0x2c64, 0x2c67, 0x2c6d, 0x2c6e, 0x2c6f, 0x2c70, 0x2c72, 0x2c75, 0x2c7e, 0x2c80, 0x2ceb, 0x2cf2,
+		0xa640, 0xa680, 0xa722, 0xa732, 0xa779, 0xa77d, 0xa77e, 0xa78b, 0xa78d, 0xa790, 0xa796, 0xa7aa, 0xa7ab, 0xa7ac,
+		0xa7ad, 0xa7ae, 0xa7b0, 0xa7b1, 0xa7b2, 0xa7b3, 0xa7b4, 0xa7c4, 0xa7c5, 0xa7c6, 0xa7c7, 0xa7d0, 0xa7d6, 0xa7f5,
+		0xff21, 0x10400, 0x104b0, 0x10570, 0x1057c, 0x1058c, 0x10594, 0x10c80, 0x118a0, 0x16e40, 0x1e900},
+		{46, 14, 49, 2, 7, 17, 47, 2, 7, 2, 5, 2, 2, 4, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 7, 2, 2, 2, 2, 2, 2, 4, 5, 2,
+		2, 2, 2, 2, 2, 2, 2, 19, 19, 2, 5, 2, 2, 41, 2, 19, 2, 2, 2, 2, 2, 2, 2, 2, 11, 5, 2, 2, 2, 6, 2, 4, 34, 18, 2, 25, 2,
+		2, 2, 2, 6, 32, 64, 35, 55, 2, 15, 97, 76, 76, 2, 2, 160, 12, 86, 6, 151, 2, 97, 16, 12, 16, 16, 12, 9, 16, 16, 16,
+		16, 4, 4, 2, 8, 2, 4, 4, 4, 4, 2, 4, 4, 2, 2, 2, 2, 2, 32, 2, 52, 96, 2, 2, 2, 2, 7, 2, 2, 2, 2, 2, 2, 4, 101, 5, 2,
+		47, 29, 15, 63, 5, 2, 11, 2, 2, 5, 21, 2, 2, 2, 2, 2, 2, 2, 2, 2, 17, 2, 2, 2, 5, 2, 5, 2, 52, 80, 72, 22, 30, 14, 4,
+		102, 64, 64, 68},
+		{32, 32, 1, -199, 1, 1, 1, -121, 1, 210, 1, 206, 1, 205, 1, 79, 202, 203, 1, 205, 207, 211, 209, 1, 211, 213, 214, 1,
+		218, 1, 218, 1, 218, 1, 217, 1, 219, 1, 1, 2, 1, 2, 1, 2, 1, 1, 2, 1, -97, -56, 1, -130, 1, 10795, 1, -163, 10792, 1,
+		-195, 69, 71, 1, 1, 1, 116, 38, 37, 64, 63, 32, 32, 8, 1, -60, 1, -7, 1, -130, 80, 32, 1, 1, 15, 1, 1, 48, 7264, 7264,
+		7264, 38864, 8, -3008, -3008, 1, -7615, 1, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -74, -9, -86, -9, -8, -100, -8,
+		-112, -7, -128, -126, -9, -7517, -8383, -8262, 28, 16, 1, 26, 48, 1, -10743, -3814, -10727, 1, -10780, -10749, -10783,
+		-10782, 1, 1, -10815, 1, 1, 1, 1, 1, 1, 1, 1, -35332, 1, 1, -42280, 1, 1, -42308, -42319, -42315, -42305, -42308,
+		-42258, -42282, -42261, 928, 1, -48, -42307, -35384, 1, 1, 1, 1, 32, 40, 40, 39, 39, 39, 39, 64, 32, 32, 34}};
+
+	inline constexpr CaseMappingData<199> kUpperData{
+		{0xb5, 0xe0, 0xf8, 0xff, 0x101, 0x131, 0x133, 0x13a, 0x14b, 0x17a, 0x17f, 0x180, 0x183, 0x188, 0x18c, 0x192, 0x195,
+		0x199, 0x19a, 0x19e, 0x1a1, 0x1a8, 0x1ad, 0x1b0, 0x1b4, 0x1b9, 0x1bd, 0x1bf, 0x1c5, 0x1c6, 0x1c8, 0x1c9, 0x1cb, 0x1cc,
+		0x1ce, 0x1dd, 0x1df, 0x1f2, 0x1f3, 0x1f5, 0x1f9, 0x223, 0x23c, 0x23f, 0x242, 0x247, 0x250, 0x251, 0x252, 0x253, 0x254,
+		0x256, 0x259, 0x25b, 0x25c, 0x260, 0x261, 0x263, 0x265, 0x266, 0x268, 0x269, 0x26a, 0x26b, 0x26c, 0x26f, 0x271, 0x272,
+		0x275, 0x27d, 0x280, 0x282, 0x283, 0x287, 0x288, 0x289, 0x28a, 0x28c, 0x292, 0x29d, 0x29e, 0x345, 0x371, 0x377, 0x37b,
+		0x3ac, 0x3ad, 0x3b1, 0x3c2, 0x3c3, 0x3cc, 0x3cd, 0x3d0, 0x3d1, 0x3d5, 0x3d6, 0x3d7, 0x3d9, 0x3f0, 0x3f1, 0x3f2, 0x3f3,
+		0x3f5, 0x3f8, 0x3fb, 0x430, 0x450, 0x461, 0x48b, 0x4c2, 0x4cf, 0x4d1, 0x561, 0x10d0, 0x10fd, 0x13f8, 0x1c80, 0x1c81,
+		0x1c82, 0x1c83, 0x1c85, 0x1c86, 0x1c87, 0x1c88, 0x1d79, 0x1d7d, 0x1d8e, 0x1e01, 0x1e9b, 0x1ea1, 0x1f00, 0x1f10,
+		0x1f20, 0x1f30, 0x1f40, 0x1f51, 0x1f60, 0x1f70, 0x1f72, 0x1f76, 0x1f78, 0x1f7a, 0x1f7c, 0x1f80, 0x1f90, 0x1fa0,
+		0x1fb0, 0x1fb3, 0x1fbe, 0x1fc3, 0x1fd0, 0x1fe0, 0x1fe5, 0x1ff3, 0x214e, 0x2170, 0x2184, 0x24d0, 0x2c30, 0x2c61,
+		0x2c65, 0x2c66, 0x2c68, 0x2c73, 0x2c76, 0x2c81, 0x2cec, 0x2cf3, 0x2d00, 0x2d27, 0x2d2d, 0xa641, 0xa681, 0xa723,
+		0xa733, 0xa77a, 0xa77f, 0xa78c, 0xa791, 0xa794, 0xa797, 0xa7b5, 0xa7c8, 0xa7d1, 0xa7d7, 0xa7f6, 0xab53, 0xab70,
+		0xff41, 0x10428, 0x104d8, 0x10597, 0x105a3, 0x105b3, 0x105bb, 0x10cc0, 0x118c0, 0x16e60, 0x1e922},
+		{2, 46, 14, 2, 49, 2, 7, 17, 47, 7, 2, 2, 5, 2, 2, 2, 2, 2, 2, 2, 7, 2, 2, 2, 5, 2, 2, 2, 2, 2, 2, 2, 2, 2, 17, 2, 19,
+		2, 2, 2, 41, 19, 2, 4, 2, 11, 2, 2, 2, 2, 2, 4, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+		2, 4, 2, 2, 2, 2, 2, 5, 2, 6, 2, 6, 34, 2, 18, 2, 4, 2, 2, 2, 2, 2, 25, 2, 2, 2, 2, 2, 2, 2, 64, 32, 35, 55, 15, 2,
+		97, 76, 86, 6, 12, 2, 2, 2, 4, 2, 2, 2, 2, 2, 2, 2, 151, 2, 97, 16, 12, 16, 16, 12, 9, 16, 4, 8, 4, 4, 4, 4, 16, 16,
+		16, 4, 2, 2, 2, 4, 4, 2, 2, 2, 32, 2, 52, 96, 2, 2, 2, 7, 2, 2, 101, 5, 2, 76, 2, 2, 47, 29, 15, 63, 5, 11, 2, 5, 2,
+		21, 17, 5, 2, 5, 2, 2, 160, 52, 80, 72, 22, 30, 14, 4, 102, 64, 64, 68},
+		{743, -32, -32, 121, -1, -232, -1, -1, -1, -1, -300, 195, -1, -1, -1, -1, 97, -1, 163, 130, -1, -1, -1, -1, -1, -1,
+		-1, 56, -1, -2, -1, -2, -1, -2, -1, -79, -1, -1, -2, -1, -1, -1, -1, 10815, -1, -1, 10783, 10780, 10782, -210, -206,
+		-205, -202, -203, 42319, -205, 42315, -207, 42280, 42308, -209, -211, 42308, 10743, 42305, -211, 10749, -213, -214,
+		10727, -218, 42307, -218, 42282, -218, -69, -217, -71, -219, 42261, 42258, 84, -1, -1, 130, -38, -37, -32, -31, -32,
+		-64, -63, -62, -57, -47, -54, -8, -1, -86, -80, 7, -116, -96, -1, -1, -32, -80, -1, -1, -1, -15, -1, -48, 3008, 3008,
+		-8, -6254, -6253, -6244, -6242, -6243, -6236, -6181, 35266, 35332, 3814, 35384, -1, -59, -1, 8, 8, 8, 8, 8, 8, 8, 74,
+		86, 100, 128, 112, 126, 8, 8, 8, 8, 9, -7205, 9, 8, 8, 7, 9, -28, -16, -1, -26, -48, -1, -10795, -10792, -1, -1, -1,
+		-1, -1, -1, -7264, -7264, -7264, -1, -1, -1, -1, -1, -1, -1, -1, 48, -1, -1, -1, -1, -1, -1, -928, -38864, -32, -40,
+		-40, -39, -39, -39, -39, -64, -32, -32, -34}};
+
+	inline constexpr CaseMappingData<201> kFoldData{
+		{0xb5, 0xc0, 0xd8, 0x100, 0x132, 0x139, 0x14a, 0x178, 0x179, 0x17f, 0x181, 0x182, 0x186, 0x187, 0x189, 0x18b, 0x18e,
+		0x18f, 0x190, 0x191, 0x193, 0x194, 0x196, 0x197, 0x198, 0x19c, 0x19d, 0x19f, 0x1a0, 0x1a6, 0x1a7, 0x1a9, 0x1ac, 0x1ae,
+		0x1af, 0x1b1, 0x1b3, 0x1b7, 0x1b8, 0x1bc, 0x1c4, 0x1c5, 0x1c7, 0x1c8, 0x1ca, 0x1cb, 0x1de, 0x1f1, 0x1f2, 0x1f6, 0x1f7,
+		0x1f8, 0x220, 0x222, 0x23a, 0x23b, 0x23d, 0x23e, 0x241, 0x243, 0x244, 0x245, 0x246, 0x345, 0x370, 0x376, 0x37f, 0x386,
+		0x388, 0x38c, 0x38e, 0x391, 0x3a3, 0x3c2, 0x3cf, 0x3d0, 0x3d1, 0x3d5, 0x3d6, 0x3d8, 0x3f0, 0x3f1, 0x3f4, 0x3f5, 0x3f7,
+		0x3f9, 0x3fa, 0x3fd, 0x400, 0x410, 0x460, 0x48a, 0x4c0, 0x4c1, 0x4d0, 0x531, 0x10a0, 0x10c7, 0x10cd, 0x13f8, 0x1c80,
+		0x1c81, 0x1c82, 0x1c83, 0x1c85, 0x1c86, 0x1c87, 0x1c88, 0x1c90, 0x1cbd, 0x1e00, 0x1e9b, 0x1e9e, 0x1ea0, 0x1f08,
+		0x1f18, 0x1f28, 0x1f38, 0x1f48, 0x1f59, 0x1f68, 0x1f88, 0x1f98, 0x1fa8, 0x1fb8, 0x1fba, 0x1fbc, 0x1fbe, 0x1fc8,
+		0x1fcc, 0x1fd8, 0x1fda, 0x1fe8, 0x1fea, 0x1fec, 0x1ff8, 0x1ffa, 0x1ffc, 0x2126, 0x212a, 0x212b, 0x2132, 0x2160,
+		0x2183, 0x24b6, 0x2c00, 0x2c60, 0x2c62, 0x2c63, 0x2c64, 0x2c67, 0x2c6d, 0x2c6e, 0x2c6f, 0x2c70, 0x2c72, 0x2c75,
+		0x2c7e, 0x2c80, 0x2ceb, 0x2cf2, 0xa640, 0xa680, 0xa722, 0xa732, 0xa779, 0xa77d, 0xa77e, 0xa78b, 0xa78d, 0xa790,
+		0xa796, 0xa7aa, 0xa7ab, 0xa7ac, 0xa7ad, 0xa7ae, 0xa7b0, 0xa7b1, 0xa7b2, 0xa7b3, 0xa7b4, 0xa7c4, 0xa7c5, 0xa7c6,
+		0xa7c7, 0xa7d0, 0xa7d6, 0xa7f5, 0xab70, 0xff21, 0x10400, 0x104b0, 0x10570, 0x1057c, 0x1058c, 0x10594, 0x10c80,
+		0x118a0, 0x16e40, 0x1e900},
+		{2, 46, 14, 49, 7, 17, 47, 2, 7, 2, 2, 5, 2, 2, 4, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 7, 2, 2, 2, 2, 2, 2, 4, 5,
+		2, 2, 2, 2, 2, 2, 2, 2, 19, 19, 2, 5, 2, 2, 41, 2, 19, 2, 2, 2, 2, 2, 2, 2, 2, 11, 2, 5, 2, 2, 2, 6, 2, 4, 34, 18, 2,
+		2, 2, 2, 2, 2, 25, 2, 2, 2, 2, 2, 2, 2, 6, 32, 64, 35, 55, 2, 15, 97, 76, 76, 2, 2, 12, 2, 2, 2, 4, 2, 2, 2, 2, 86, 6,
+		151, 2, 2, 97, 16, 12, 16, 16, 12, 9, 16, 16, 16, 16, 4, 4, 2, 2, 8, 2, 4, 4, 4, 4, 2, 4, 4, 2, 2, 2, 2, 2, 32, 2, 52,
+		96, 2, 2, 2, 2, 7, 2, 2, 2, 2, 2, 2, 4, 101, 5, 2, 47, 29, 15, 63, 5, 2, 11, 2, 2, 5, 21, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+		17, 2, 2, 2, 5, 2, 5, 2, 160, 52, 80, 72, 22, 30, 14, 4, 102, 64, 64, 68},
+		{775, 32, 32, 1, 1, 1, 1, -121, 1, -268, 210, 1, 206, 1, 205, 1, 79, 202, 203, 1, 205, 207, 211, 209, 1, 211, 213,
+		214, 1, 218, 1, 218, 1, 218, 1, 217, 1, 219, 1, 1, 2, 1, 2, 1, 2, 1, 1, 2, 1, -97, -56, 1, -130, 1, 10795, 1, -163,
+		10792, 1, -195, 69, 71, 1, 116, 1, 1, 116, 38, 37, 64, 63, 32, 32, 1, 8, -30, -25, -15, -22, 1, -54, -48, -60, -64, 1,
+		-7, 1, -130, 80, 32, 1, 1, 15, 1, 1, 48, 7264, 7264, 7264, -8, -6222, -6221, -6212, -6210, -6211, -6204, -6180, 35267,
+		-3008, -3008, 1, -58, -7615, 1, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -74, -9, -7173, -86, -9, -8, -100, -8,
+		-112, -7, -128, -126, -9, -7517, -8383, -8262, 28, 16, 1, 26, 48, 1, -10743, -3814, -10727, 1, -10780, -10749, -10783,
+		-10782, 1, 1, -10815, 1, 1, 1, 1, 1, 1, 1, 1, -35332, 1, 1, -42280, 1, 1, -42308, -42319, -42315, -42305, -42308,
+		-42258, -42282, -42261, 928, 1, -48, -42307, -35384, 1, 1, 1, 1, -38864, 32, 40, 40, 39, 39, 39, 39, 64, 32, 32, 34}};
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <bit>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#	define HANA_UNICODE_X64
+#	include <immintrin.h>
+#	ifdef _MSC_VER
+#		include <intrin.h>
+#		define HANA_UNICODE_TARGET_AVX2
+#	else
+#		define HANA_UNICODE_TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+#	endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#	define HANA_UNICODE_NEON
+#	include <arm_neon.h>
+#endif
+
+namespace hana::simd
+{
+#ifdef HANA_UNICODE_X64
+	// Cached cpu feature check for the AVX2 kernels, SSE2 is part of the x64 baseline.
+	inline bool cpu_has_avx2() {
+		static const bool has_avx2 = [] {
+#ifdef _MSC_VER
+			int info[4];
+			__cpuid(info, 0);
+			if (info[0] < 7) return false;
+
+			__cpuid(info, 1);
+			const bool osxsave = (info[2] & (1 << 27)) != 0;
+			const bool avx = (info[2] & (1 << 28)) != 0;
+			const bool popcnt = (info[2] & (1 << 23)) != 0;
+			// the OS must save the ymm registers on context switch
+			if (!osxsave || !avx || !popcnt || (_xgetbv(0) & 0x6) != 0x6) return false;
+
+			__cpuidex(info, 7, 0);
+			return (info[1] & (1 << 5)) != 0;
+#else
+			__builtin_cpu_init();
+			return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+#endif
+		}();
+		return has_avx2;
+	}
+#endif
+}
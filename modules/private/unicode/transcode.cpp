@@ -0,0 +1,332 @@
+#include <hana/unicode/algorithm.hpp>
+
+#include "simd.hpp"
+
+namespace hana::unicode::internal
+{
+#pragma region scalar
+
+	// One UTF16Cursor step: a leading surrogate always takes the next unit, a lone surrogate keeps its first byte.
+	static inline uint64_t utf16_seq_to_utf8(const char16_t* seq, uint64_t size, uint64_t& pos, char8_t* dst) {
+		const char16_t ch = seq[pos];
+		if (!utf16_is_surrogate(ch)) {
+			const UTF8Seq utf8_seq{static_cast<char32_t>(ch)};
+			std::memcpy(dst, utf8_seq.data, utf8_seq.len);
+			pos += 1;
+			return utf8_seq.len;
+		}
+
+		if (utf16_is_leading_surrogate(ch) && pos + 1 < size) {
+			const UTF8Seq utf8_seq = UTF16Seq{ch, seq[pos + 1]};
+			std::memcpy(dst, utf8_seq.data, utf8_seq.len);
+			pos += 2;
+			return utf8_seq.len;
+		}
+
+		std::memcpy(dst, &ch, 1);
+		pos += 1;
+		return 1;
+	}
+
+	static inline uint64_t utf16_seq_utf8_size(const char16_t* seq, uint64_t size, uint64_t& pos) {
+		const char16_t ch = seq[pos];
+		if (!utf16_is_surrogate(ch)) {
+			pos += 1;
+			return utf8_seq_len(ch);
+		}
+
+		if (utf16_is_leading_surrogate(ch) && pos + 1 < size) {
+			pos += 2;
+			return 4;
+		}
+
+		pos += 1;
+		return 1;
+	}
+
+	static inline uint64_t utf32_seq_to_utf8(char32_t ch, char8_t* dst) {
+		const UTF8Seq utf8_seq{ch};
+		std::memcpy(dst, utf8_seq.data, utf8_seq.len);
+		return utf8_seq.len;
+	}
+
+	template<typename Char>
+	static inline uint64_t utf8_seq_to_utf(const char8_t* seq, uint64_t size, uint64_t& pos, Char* dst) {
+		char32_t value;
+		const auto next = decode_utf(seq + pos, seq + size, value).next_ptr_;
+		pos = static_cast<uint64_t>(next - seq);
+		if constexpr (sizeof(Char) == sizeof(char32_t)) {
+			dst[0] = value;
+			return 1;
+		} else {
+			const UTF16Seq utf16_seq{value};
+			dst[0] = utf16_seq.data[0];
+			if (utf16_seq.len == 2) {
+				dst[1] = utf16_seq.data[1];
+			}
+			return utf16_seq.len;
+		}
+	}
+
+#pragma endregion scalar
+
+#pragma region blocks
+
+	// Block helpers work on 16 code units (8 for the utf-16 size count, 4 for utf-32), returning false leaves the block to
+	// the scalar step. Targets without a vector unit always return false.
+#if defined(HANA_UNICODE_X64)
+
+	static inline bool narrow_ascii_block(const char16_t* seq, char8_t* dst) {
+		const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(seq));
+		const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(seq + 8));
+		const __m128i high = _mm_and_si128(_mm_or_si128(a, b), _mm_set1_epi16(static_cast<short>(0xFF80)));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) != 0xFFFF) return false;
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(a, b));
+		return true;
+	}
+
+	static inline bool narrow_ascii_block(const char32_t* seq, char8_t* dst) {
+		const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(seq));
+		const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(seq + 4));
+		const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(seq + 8));
+		const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(seq + 12));
+		const __m128i any = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+		const __m128i high = _mm_and_si128(any, _mm_set1_epi32(~0x7F));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(high, _mm_setzero_si128())) != 0xFFFF) return false;
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+		return true;
+	}
+
+	static inline bool widen_ascii_block(const char8_t* seq, char16_t* dst) {
+		const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(seq));
+		if (_mm_movemask_epi8(input) != 0) return false;
+		const __m128i zero = _mm_setzero_si128();
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi8(input, zero));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 8), _mm_unpackhi_epi8(input, zero));
+		return true;
+	}
+
+	static inline bool widen_ascii_block(const char8_t* seq, char32_t* dst) {
+		const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(seq));
+		if (_mm_movemask_epi8(input) != 0) return false;
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i low = _mm_unpacklo_epi8(input, zero);
+		const __m128i high = _mm_unpackhi_epi8(input, zero);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi16(low, zero));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4), _mm_unpackhi_epi16(low, zero));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 8), _mm_unpacklo_epi16(high, zero));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 12), _mm_unpackhi_epi16(high, zero));
+		return true;
+	}
+
+	// number of lanes with (v & bits) != 0, movemask gives two bits per 16-bit lane and four per 32-bit lane
+	static inline uint32_t count_u16_lanes_above(__m128i v, short bits) {
+		const __m128i below = _mm_cmpeq_epi16(_mm_and_si128(v, _mm_set1_epi16(bits)), _mm_setzero_si128());
+		return static_cast<uint32_t>(std::popcount(static_cast<uint32_t>(~_mm_movemask_epi8(below) & 0xFFFF))) / 2;
+	}
+
+	static inline bool utf8_size_block(const char16_t* seq, uint64_t& size) {
+		const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(seq));
+		const __m128i surrogates = _mm_cmpeq_epi16(_mm_and_si128(input, _mm_set1_epi16(static_cast<short>(0xF800))), _mm_set1_epi16(static_cast<short>(0xD800)));
+		if (_mm_movemask_epi8(surrogates) != 0) return false;
+		size += 8 + count_u16_lanes_above(input, static_cast<short>(0xFF80)) + count_u16_lanes_above(input, static_cast<short>(0xF800));
+		return true;
+	}
+
+	static inline uint32_t count_u32_lanes_above(__m128i v, int bits) {
+		const __m128i below = _mm_cmpeq_epi32(_mm_and_si128(v, _mm_set1_epi32(bits)), _mm_setzero_si128());
+		return static_cast<uint32_t>(std::popcount(static_cast<uint32_t>(~_mm_movemask_epi8(below) & 0xFFFF))) / 4;
+	}
+
+	static inline void utf8_size_block(const char32_t* seq, uint64_t& size) {
+		const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(seq));
+		size += 4 + count_u32_lanes_above(input, ~0x7F) + count_u32_lanes_above(input, ~0x7FF) + count_u32_lanes_above(input, ~0xFFFF);
+	}
+
+#elif defined(HANA_UNICODE_NEON)
+
+	static inline bool narrow_ascii_block(const char16_t* seq, char8_t* dst) {
+		const uint16x8_t a = vld1q_u16(reinterpret_cast<const uint16_t*>(seq));
+		const uint16x8_t b = vld1q_u16(reinterpret_cast<const uint16_t*>(seq + 8));
+		if (vmaxvq_u16(vorrq_u16(a, b)) >= 0x80) return false;
+		vst1q_u8(reinterpret_cast<uint8_t*>(dst), vcombine_u8(vmovn_u16(a), vmovn_u16(b)));
+		return true;
+	}
+
+	static inline bool narrow_ascii_block(const char32_t* seq, char8_t* dst) {
+		const uint32x4_t a = vld1q_u32(reinterpret_cast<const uint32_t*>(seq));
+		const uint32x4_t b = vld1q_u32(reinterpret_cast<const uint32_t*>(seq + 4));
+		const uint32x4_t c = vld1q_u32(reinterpret_cast<const uint32_t*>(seq + 8));
+		const uint32x4_t d = vld1q_u32(reinterpret_cast<const uint32_t*>(seq + 12));
+		if (vmaxvq_u32(vorrq_u32(vorrq_u32(a, b), vorrq_u32(c, d))) >= 0x80) return false;
+		const uint16x8_t low = vcombine_u16(vmovn_u32(a), vmovn_u32(b));
+		const uint16x8_t high = vcombine_u16(vmovn_u32(c), vmovn_u32(d));
+		vst1q_u8(reinterpret_cast<uint8_t*>(dst), vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+		return true;
+	}
+
+	static inline bool widen_ascii_block(const char8_t* seq, char16_t* dst) {
+		const uint8x16_t input = vld1q_u8(reinterpret_cast<const uint8_t*>(seq));
+		if (vmaxvq_u8(input) >= 0x80) return false;
+		vst1q_u16(reinterpret_cast<uint16_t*>(dst), vmovl_u8(vget_low_u8(input)));
+		vst1q_u16(reinterpret_cast<uint16_t*>(dst + 8), vmovl_high_u8(input));
+		return true;
+	}
+
+	static inline bool widen_ascii_block(const char8_t* seq, char32_t* dst) {
+		const uint8x16_t input = vld1q_u8(reinterpret_cast<const uint8_t*>(seq));
+		if (vmaxvq_u8(input) >= 0x80) return false;
+		const uint16x8_t low = vmovl_u8(vget_low_u8(input));
+		const uint16x8_t high = vmovl_high_u8(input);
+		vst1q_u32(reinterpret_cast<uint32_t*>(dst), vmovl_u16(vget_low_u16(low)));
+		vst1q_u32(reinterpret_cast<uint32_t*>(dst + 4), vmovl_high_u16(low));
+		vst1q_u32(reinterpret_cast<uint32_t*>(dst + 8), vmovl_u16(vget_low_u16(high)));
+		vst1q_u32(reinterpret_cast<uint32_t*>(dst + 12), vmovl_high_u16(high));
+		return true;
+	}
+
+	static inline bool utf8_size_block(const char16_t* seq, uint64_t& size) {
+		const uint16x8_t input = vld1q_u16(reinterpret_cast<const uint16_t*>(seq));
+		const uint16x8_t surrogates = vceqq_u16(vandq_u16(input, vdupq_n_u16(0xF800)), vdupq_n_u16(0xD800));
+		if (vmaxvq_u16(surrogates) != 0) return false;
+		const uint16x8_t two = vshrq_n_u16(vcgeq_u16(input, vdupq_n_u16(0x80)), 15);
+		const uint16x8_t three = vshrq_n_u16(vcgeq_u16(input, vdupq_n_u16(0x800)), 15);
+		size += 8 + vaddvq_u16(vaddq_u16(two, three));
+		return true;
+	}
+
+	static inline void utf8_size_block(const char32_t* seq, uint64_t& size) {
+		const uint32x4_t input = vld1q_u32(reinterpret_cast<const uint32_t*>(seq));
+		const uint32x4_t two = vshrq_n_u32(vcgeq_u32(input, vdupq_n_u32(0x80)), 31);
+		const uint32x4_t three = vshrq_n_u32(vcgeq_u32(input, vdupq_n_u32(0x800)), 31);
+		const uint32x4_t four = vshrq_n_u32(vcgeq_u32(input, vdupq_n_u32(0x10000)), 31);
+		size += 4 + vaddvq_u32(vaddq_u32(vaddq_u32(two, three), four));
+	}
+
+#endif
+
+#if defined(HANA_UNICODE_X64) || defined(HANA_UNICODE_NEON)
+	static constexpr uint64_t kBlockUnits = 16;
+#else
+	// no vector unit, the block loops below never run
+	static constexpr uint64_t kBlockUnits = UINT64_MAX;
+
+	template<typename From, typename To>
+	static inline bool narrow_ascii_block(const From*, To*) { return false; }
+	template<typename From, typename To>
+	static inline bool widen_ascii_block(const From*, To*) { return false; }
+#endif
+
+#pragma endregion blocks
+
+	uint64_t utf16_utf8_size(const char16_t* seq, uint64_t size) noexcept {
+		uint64_t pos = 0;
+		uint64_t utf8_size = 0;
+#if defined(HANA_UNICODE_X64) || defined(HANA_UNICODE_NEON)
+		while (size - pos >= 8) {
+			if (utf8_size_block(seq + pos, utf8_size)) {
+				pos += 8;
+				continue;
+			}
+			// a surrogate pair may run one unit past the block
+			for (const uint64_t stop = pos + 8; pos < stop;) {
+				utf8_size += utf16_seq_utf8_size(seq, size, pos);
+			}
+		}
+#endif
+		while (pos < size) {
+			utf8_size += utf16_seq_utf8_size(seq, size, pos);
+		}
+		return utf8_size;
+	}
+
+	uint64_t utf32_utf8_size(const char32_t* seq, uint64_t size) noexcept {
+		uint64_t pos = 0;
+		uint64_t utf8_size = 0;
+#if defined(HANA_UNICODE_X64) || defined(HANA_UNICODE_NEON)
+		for (; size - pos >= 4; pos += 4) {
+			utf8_size_block(seq + pos, utf8_size);
+		}
+#endif
+		for (; pos < size; ++pos) {
+			utf8_size += utf8_seq_len(seq[pos]);
+		}
+		return utf8_size;
+	}
+
+	uint64_t utf16_to_utf8(const char16_t* seq, uint64_t size, char8_t* dst) noexcept {
+		uint64_t pos = 0;
+		uint64_t written = 0;
+		while (size - pos >= kBlockUnits) {
+			if (narrow_ascii_block(seq + pos, dst + written)) {
+				pos += kBlockUnits;
+				written += kBlockUnits;
+				continue;
+			}
+			for (const uint64_t stop = pos + kBlockUnits; pos < stop;) {
+				written += utf16_seq_to_utf8(seq, size, pos, dst + written);
+			}
+		}
+		while (pos < size) {
+			written += utf16_seq_to_utf8(seq, size, pos, dst + written);
+		}
+		return written;
+	}
+
+	uint64_t utf32_to_utf8(const char32_t* seq, uint64_t size, char8_t* dst) noexcept {
+		uint64_t pos = 0;
+		uint64_t written = 0;
+		while (size - pos >= kBlockUnits) {
+			if (narrow_ascii_block(seq + pos, dst + written)) {
+				pos += kBlockUnits;
+				written += kBlockUnits;
+				continue;
+			}
+			for (const uint64_t stop = pos + kBlockUnits; pos < stop; ++pos) {
+				written += utf32_seq_to_utf8(seq[pos], dst + written);
+			}
+		}
+		for (; pos < size; ++pos) {
+			written += utf32_seq_to_utf8(seq[pos], dst + written);
+		}
+		return written;
+	}
+
+	uint64_t utf8_to_utf16(const char8_t* seq, uint64_t size, char16_t* dst) noexcept {
+		uint64_t pos = 0;
+		uint64_t written = 0;
+		while (size - pos >= kBlockUnits) {
+			if (widen_ascii_block(seq + pos, dst + written)) {
+				pos += kBlockUnits;
+				written += kBlockUnits;
+				continue;
+			}
+			for (const uint64_t stop = pos + kBlockUnits; pos < stop;) {
+				written += utf8_seq_to_utf(seq, size, pos, dst + written);
+			}
+		}
+		while (pos < size) {
+			written += utf8_seq_to_utf(seq, size, pos, dst + written);
+		}
+		return written;
+	}
+
+	uint64_t utf8_to_utf32(const char8_t* seq, uint64_t size, char32_t* dst) noexcept {
+		uint64_t pos = 0;
+		uint64_t written = 0;
+		while (size - pos >= kBlockUnits) {
+			if (widen_ascii_block(seq + pos, dst + written)) {
+				pos += kBlockUnits;
+				written += kBlockUnits;
+				continue;
+			}
+			for (const uint64_t stop = pos + kBlockUnits; pos < stop;) {
+				written += utf8_seq_to_utf(seq, size, pos, dst + written);
+			}
+		}
+		while (pos < size) {
+			written += utf8_seq_to_utf(seq, size, pos, dst + written);
+		}
+		return written;
+	}
+}
\ No newline at end of file
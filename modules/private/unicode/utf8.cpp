@@ -0,0 +1,316 @@
+#include <hana/unicode/algorithm.hpp>
+
+#include "simd.hpp"
+
+namespace hana::unicode::internal
+{
+	using scan_fn = bool (*)(const char8_t* seq, uint64_t size, uint64_t& code_points);
+
+	// Below this size the setup of a vector kernel costs more than it saves.
+	static constexpr uint64_t kScalarThreshold = 16;
+
+	inline bool is_continuation(char8_t ch) {
+		return (ch & 0xC0) == 0x80;
+	}
+
+	static bool utf8_scan_scalar(const char8_t* seq, uint64_t size, uint64_t& code_points) noexcept {
+		for (uint64_t i = 0; i < size; ++i) {
+			code_points += !is_continuation(seq[i]);
+		}
+		return utf8_validate_scalar(seq, size);
+	}
+
+	// Validates whole sequences starting at first until first reaches stop, returns nullptr on error.
+	static const char8_t* utf8_validate_until(const char8_t* first, const char8_t* stop, const char8_t* last, uint64_t& code_points) {
+		while (first < stop) {
+			const int len = utf8_code_units_in_next_character(first, last);
+			if (len < 0) {
+				return nullptr;
+			}
+			first += len;
+			++code_points;
+		}
+		return first;
+	}
+
+#pragma region lookup tables
+
+	// Error classes of the Keiser-Lemire lookup validator ("Validating UTF-8 In Less Than One Instruction Per Byte").
+	// Each table maps a nibble of the previous or current code unit to the errors it may take part in;
+	// a pair is bad when the three lookups share a bit.
+	enum : uint8_t {
+		TOO_SHORT = 1 << 0,      // 11______ 0_______ or 11______ 11______
+		TOO_LONG = 1 << 1,       // 0_______ 10______
+		OVERLONG_3 = 1 << 2,     // 11100000 100_____
+		TOO_LARGE = 1 << 3,      // 11110100 1001____ and above
+		SURROGATE = 1 << 4,      // 11101101 101_____
+		OVERLONG_2 = 1 << 5,     // 1100000_ 10______
+		TOO_LARGE_1000 = 1 << 6, // 11110101+ 1000____
+		OVERLONG_4 = 1 << 6,     // 11110000 1000____
+		TWO_CONTS = 1 << 7,      // 10______ 10______
+		CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS,
+	};
+
+	alignas(16) static constexpr uint8_t kByte1High[16] = {
+		TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+		TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+		TOO_SHORT | OVERLONG_2,
+		TOO_SHORT,
+		TOO_SHORT | OVERLONG_3 | SURROGATE,
+		TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4,
+	};
+
+	alignas(16) static constexpr uint8_t kByte1Low[16] = {
+		CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+		CARRY | OVERLONG_2,
+		CARRY,
+		CARRY,
+		CARRY | TOO_LARGE,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+	};
+
+	alignas(16) static constexpr uint8_t kByte2High[16] = {
+		TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+		TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+		TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+		TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+		TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+		TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+	};
+
+	// Subtracted with saturation from the last block, anything left means a sequence is cut at the end.
+	alignas(16) static constexpr uint8_t kIncompleteMax[32] = {
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1,
+	};
+
+#pragma endregion lookup tables
+
+#ifdef HANA_UNICODE_X64
+
+#pragma region sse2
+
+	// SSE2 has no byte shuffle, so it only skips ASCII runs and leaves the rest to the scalar decoder.
+	static bool utf8_scan_sse2(const char8_t* seq, uint64_t size, uint64_t& code_points) noexcept {
+		const char8_t* first = seq;
+		const char8_t* const last = seq + size;
+		while (last - first >= 16) {
+			const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+			if (_mm_movemask_epi8(input) == 0) {
+				first += 16;
+				code_points += 16;
+				continue;
+			}
+
+			first = utf8_validate_until(first, first + 16, last, code_points);
+			if (!first) {
+				return false;
+			}
+		}
+
+		return utf8_validate_until(first, last, last, code_points) != nullptr;
+	}
+
+	static uint64_t count_code_points_sse2(const char8_t* block) {
+		const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+		// continuation units are 0x80-0xBF, i.e. below -64 as signed bytes
+		const __m128i heads = _mm_cmpgt_epi8(input, _mm_set1_epi8(-65));
+		return static_cast<uint64_t>(std::popcount(static_cast<uint32_t>(_mm_movemask_epi8(heads))));
+	}
+
+#pragma endregion sse2
+
+#pragma region avx2
+
+	HANA_UNICODE_TARGET_AVX2 static inline __m256i lookup_avx2(const uint8_t (&table)[16], __m256i index) {
+		const __m256i lut = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(table)));
+		return _mm256_shuffle_epi8(lut, index);
+	}
+
+	// `input` shifted right by N code units, pulling in the tail of the previous block.
+	template<int N>
+	HANA_UNICODE_TARGET_AVX2 static inline __m256i prev_avx2(__m256i input, __m256i prev_input) {
+		return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev_input, input, 0x21), 16 - N);
+	}
+
+	HANA_UNICODE_TARGET_AVX2 static inline __m256i check_block_avx2(__m256i input, __m256i prev_input) {
+		const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+		const __m256i prev1 = prev_avx2<1>(input, prev_input);
+		const __m256i byte_1_high = lookup_avx2(kByte1High, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble));
+		const __m256i byte_1_low = lookup_avx2(kByte1Low, _mm256_and_si256(prev1, low_nibble));
+		const __m256i byte_2_high = lookup_avx2(kByte2High, _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble));
+		const __m256i special_cases = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+		// third and fourth units of a sequence must be continuations, and only there may two continuations follow each other
+		const __m256i is_third = _mm256_subs_epu8(prev_avx2<2>(input, prev_input), _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+		const __m256i is_fourth = _mm256_subs_epu8(prev_avx2<3>(input, prev_input), _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+		const __m256i must_be_2_3_continuation = _mm256_and_si256(_mm256_or_si256(is_third, is_fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+		return _mm256_xor_si256(must_be_2_3_continuation, special_cases);
+	}
+
+	HANA_UNICODE_TARGET_AVX2 static bool utf8_scan_avx2(const char8_t* seq, uint64_t size, uint64_t& code_points) noexcept {
+		const __m256i incomplete_max = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(kIncompleteMax));
+		const __m256i continuation_max = _mm256_set1_epi8(-65);
+
+		__m256i error = _mm256_setzero_si256();
+		__m256i prev_input = _mm256_setzero_si256();
+		__m256i prev_incomplete = _mm256_setzero_si256();
+
+		const auto process = [&](__m256i input) HANA_UNICODE_TARGET_AVX2 {
+			const auto heads = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(input, continuation_max)));
+			code_points += static_cast<uint64_t>(std::popcount(heads));
+
+			if (_mm256_movemask_epi8(input) == 0) {
+				error = _mm256_or_si256(error, prev_incomplete);
+				prev_incomplete = _mm256_setzero_si256();
+			} else {
+				error = _mm256_or_si256(error, check_block_avx2(input, prev_input));
+				prev_incomplete = _mm256_subs_epu8(input, incomplete_max);
+			}
+			prev_input = input;
+		};
+
+		uint64_t pos = 0;
+		for (; pos + 32 <= size; pos += 32) {
+			process(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(seq + pos)));
+		}
+
+		if (pos < size) {
+			// zero padding is ASCII, so it only has to be taken out of the count again
+			alignas(32) char8_t tail[32] = {};
+			std::memcpy(tail, seq + pos, size - pos);
+			process(_mm256_load_si256(reinterpret_cast<const __m256i*>(tail)));
+			code_points -= 32 - (size - pos);
+		}
+
+		error = _mm256_or_si256(error, prev_incomplete);
+		return _mm256_testz_si256(error, error) != 0;
+	}
+
+#pragma endregion avx2
+
+#endif
+
+#ifdef HANA_UNICODE_NEON
+
+#pragma region neon
+
+	static inline uint8x16_t check_block_neon(uint8x16_t input, uint8x16_t prev_input) {
+		const uint8x16_t low_nibble = vdupq_n_u8(0x0F);
+		const uint8x16_t prev1 = vextq_u8(prev_input, input, 15);
+		const uint8x16_t byte_1_high = vqtbl1q_u8(vld1q_u8(kByte1High), vshrq_n_u8(prev1, 4));
+		const uint8x16_t byte_1_low = vqtbl1q_u8(vld1q_u8(kByte1Low), vandq_u8(prev1, low_nibble));
+		const uint8x16_t byte_2_high = vqtbl1q_u8(vld1q_u8(kByte2High), vshrq_n_u8(input, 4));
+		const uint8x16_t special_cases = vandq_u8(vandq_u8(byte_1_high, byte_1_low), byte_2_high);
+
+		const uint8x16_t is_third = vqsubq_u8(vextq_u8(prev_input, input, 14), vdupq_n_u8(0xE0 - 0x80));
+		const uint8x16_t is_fourth = vqsubq_u8(vextq_u8(prev_input, input, 13), vdupq_n_u8(0xF0 - 0x80));
+		const uint8x16_t must_be_2_3_continuation = vandq_u8(vorrq_u8(is_third, is_fourth), vdupq_n_u8(0x80));
+		return veorq_u8(must_be_2_3_continuation, special_cases);
+	}
+
+	static uint64_t count_code_points_neon(uint8x16_t input) {
+		const uint8x16_t heads = vcgtq_s8(vreinterpretq_s8_u8(input), vdupq_n_s8(-65));
+		return vaddvq_u8(vshrq_n_u8(heads, 7));
+	}
+
+	static bool utf8_scan_neon(const char8_t* seq, uint64_t size, uint64_t& code_points) noexcept {
+		const uint8x16_t incomplete_max = vld1q_u8(kIncompleteMax + 16);
+
+		uint8x16_t error = vdupq_n_u8(0);
+		uint8x16_t prev_input = vdupq_n_u8(0);
+		uint8x16_t prev_incomplete = vdupq_n_u8(0);
+
+		const auto process = [&](uint8x16_t input) {
+			code_points += count_code_points_neon(input);
+
+			if (vmaxvq_u8(input) < 0x80) {
+				error = vorrq_u8(error, prev_incomplete);
+				prev_incomplete = vdupq_n_u8(0);
+			} else {
+				error = vorrq_u8(error, check_block_neon(input, prev_input));
+				prev_incomplete = vqsubq_u8(input, incomplete_max);
+			}
+			prev_input = input;
+		};
+
+		uint64_t pos = 0;
+		for (; pos + 16 <= size; pos += 16) {
+			process(vld1q_u8(reinterpret_cast<const uint8_t*>(seq + pos)));
+		}
+
+		if (pos < size) {
+			alignas(16) uint8_t tail[16] = {};
+			std::memcpy(tail, seq + pos, size - pos);
+			process(vld1q_u8(tail));
+			code_points -= 16 - (size - pos);
+		}
+
+		error = vorrq_u8(error, prev_incomplete);
+		return vmaxvq_u8(error) == 0;
+	}
+
+#pragma endregion neon
+
+#endif
+
+	static scan_fn select_utf8_scan() {
+#if defined(HANA_UNICODE_X64)
+		return simd::cpu_has_avx2() ? utf8_scan_avx2 : utf8_scan_sse2;
+#elif defined(HANA_UNICODE_NEON)
+		return utf8_scan_neon;
+#else
+		return utf8_scan_scalar;
+#endif
+	}
+
+	bool utf8_scan(const char8_t* seq, uint64_t size, uint64_t& code_points) noexcept {
+		if (size < kScalarThreshold) {
+			return utf8_scan_scalar(seq, size, code_points);
+		}
+
+		static const scan_fn scan = select_utf8_scan();
+		return scan(seq, size, code_points);
+	}
+
+	bool utf8_skip(const char8_t* seq, uint64_t size, uint64_t code_points, uint64_t& index) noexcept {
+		uint64_t pos = 0;
+		uint64_t seen = 0;
+
+		// skip whole blocks that end before the wanted code point starts
+#if defined(HANA_UNICODE_X64)
+		for (; pos + 16 <= size; pos += 16) {
+			const uint64_t count = count_code_points_sse2(seq + pos);
+			if (seen + count > code_points) break;
+			seen += count;
+		}
+#elif defined(HANA_UNICODE_NEON)
+		for (; pos + 16 <= size; pos += 16) {
+			const uint64_t count = count_code_points_neon(vld1q_u8(reinterpret_cast<const uint8_t*>(seq + pos)));
+			if (seen + count > code_points) break;
+			seen += count;
+		}
+#endif
+
+		for (; pos < size; ++pos) {
+			if (!is_continuation(seq[pos])) {
+				if (seen == code_points) break;
+				++seen;
+			}
+		}
+
+		index = pos;
+		uint64_t prefix_code_points = 0;
+		return utf8_scan(seq, pos, prefix_code_points);
+	}
+}
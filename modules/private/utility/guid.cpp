@@ -12,11 +12,11 @@
 
 namespace hana
 {
-	HString guid_t::to_string() const noexcept {
+	HFixedString<36> guid_t::to_string() const noexcept {
 		static constexpr char8_t guid_encoder[17] = u8"0123456789abcdef";
 		static constexpr char8_t empty_guid[37] = u8"00000000-0000-0000-0000-000000000000";
 
-		HString uustr{empty_guid};
+		HFixedString<36> uustr{empty_guid};
 
 		for (size_t i = 0, index = 0; i < 36; ++i) {
 			if (i == 8 || i == 13 || i == 18 || i == 23) {
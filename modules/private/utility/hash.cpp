@@ -2,6 +2,8 @@
 
 #include <xxh3.h>
 
+#include <cassert>
+
 namespace hana
 {
 	uint32_t XXHash::_xxhash32(const void* input, size_t length, uint32_t seed) noexcept {
@@ -15,4 +17,73 @@ namespace hana
 	uint64_t XXHash::_xxhash64(const void* input, size_t length, uint64_t seed) noexcept {
 		return XXH3_64bits_withSeed(input, length, seed);
 	}
+
+	Fingerprint128 XXHash::_xxhash128(const void* input, size_t length) noexcept {
+		const XXH128_hash_t hash = XXH3_128bits(input, length);
+		return {hash.low64, hash.high64};
+	}
+
+	Fingerprint128 XXHash::_xxhash128(const void* input, size_t length, uint64_t seed) noexcept {
+		const XXH128_hash_t hash = XXH3_128bits_withSeed(input, length, seed);
+		return {hash.low64, hash.high64};
+	}
+
+	// the length is a constant here, so the inlined XXH3 keeps only the branch for it
+	template<size_t Width>
+	static void hash_fixed(const unsigned char* keys, std::span<uint64_t> out, uint64_t seed) noexcept {
+		for (uint64_t& hash: out) {
+			hash = XXH3_64bits_withSeed(keys, Width, seed);
+			keys += Width;
+		}
+	}
+
+	void XXHash::hash_many(std::span<const HStringView> keys, std::span<uint64_t> out, uint64_t seed) noexcept {
+		assert(out.size() >= keys.size() && "hash_many output is smaller than the keys");
+
+		uint64_t* hash = out.data();
+		for (const HStringView key: keys) {
+			*hash++ = XXH3_64bits_withSeed(key.raw_data(), key.size(), seed);
+		}
+	}
+
+	void XXHash::hash_many(const void* keys, size_t width, std::span<uint64_t> out, uint64_t seed) noexcept {
+		const auto* bytes = static_cast<const unsigned char*>(keys);
+		switch (width) {
+			case 4: return hash_fixed<4>(bytes, out, seed);
+			case 8: return hash_fixed<8>(bytes, out, seed);
+			case 16: return hash_fixed<16>(bytes, out, seed);
+			case 24: return hash_fixed<24>(bytes, out, seed);
+			case 32: return hash_fixed<32>(bytes, out, seed);
+			case 64: return hash_fixed<64>(bytes, out, seed);
+			default:
+				for (uint64_t& hash: out) {
+					hash = XXH3_64bits_withSeed(bytes, width, seed);
+					bytes += width;
+				}
+		}
+	}
+
+	static_assert(sizeof(XXH3_state_t) <= sizeof(XXHashState) && alignof(XXH3_state_t) <= alignof(XXHashState), "XXHashState cannot hold XXH3_state_t");
+
+	XXHashState::XXHashState() noexcept {
+		reset();
+	}
+
+	XXHashState::XXHashState(uint64_t seed) noexcept {
+		reset(seed);
+	}
+
+	void XXHashState::reset(uint64_t seed) noexcept {
+		auto* state = reinterpret_cast<XXH3_state_t*>(state_);
+		XXH3_INITSTATE(state);
+		XXH3_64bits_reset_withSeed(state, seed);
+	}
+
+	void XXHashState::update_bytes(const void* input, size_t length) noexcept {
+		XXH3_64bits_update(reinterpret_cast<XXH3_state_t*>(state_), input, length);
+	}
+
+	uint64_t XXHashState::digest() const noexcept {
+		return XXH3_64bits_digest(reinterpret_cast<const XXH3_state_t*>(state_));
+	}
 }
@@ -1,15 +1,37 @@
 #pragma once
 
 #include "hana/container/string.hpp"
+#include "hana/container/fixed_string.hpp"
+#include "hana/container/shared_string.hpp"
+#include "hana/utility/hash.hpp"
 
+#include <tuple>
+#include <chrono>
+#include <ranges>
+#include <variant>
+#include <optional>
+
+#ifndef HANA_FMT_NO_LOCALE
 #include <locale>
+#endif
 
 namespace hana::fmt
 {
+#ifdef HANA_FMT_NO_LOCALE
+	// Left incomplete on purpose: with locales compiled out every locale pointer is null.
+	struct no_locale;
+	using locale_type = no_locale;
+#else
+	using locale_type = std::locale;
+#endif
+
 	class format_args;
 
 	template<typename...> class fstring;
 
+	template<size_t SIZE = 1000, typename Allocator = std::allocator<char8_t>>
+	class memory_buffer;
+
 	template<typename... Args>
 	using format_string = fstring<std::type_identity_t<Args>...>;
 
@@ -52,6 +74,7 @@ namespace hana
 
 	inline char8_t* vformat_to(char8_t* out, HStringView fmt, fmt::format_args args);
 
+#ifndef HANA_FMT_NO_LOCALE
 	template<std::output_iterator<const char8_t&> OutputIt, typename... T>
 	OutputIt format_to(OutputIt out, const std::locale& loc, fmt::format_string<T...> fmt, T&&... args);
 
@@ -59,6 +82,7 @@ namespace hana
 	OutputIt vformat_to(OutputIt out, const std::locale& loc, HStringView fmt, fmt::format_args args);
 
 	inline char8_t* vformat_to(char8_t* out, const std::locale& loc, HStringView fmt, fmt::format_args args);
+#endif
 
 #pragma endregion format_to
 
@@ -79,6 +103,7 @@ namespace hana
 
 	inline fmt::format_to_n_result<char8_t*> vformat_to_n(char8_t* out, size_t n, HStringView fmt, fmt::format_args args);
 
+#ifndef HANA_FMT_NO_LOCALE
 	template<std::output_iterator<const char8_t&> OutputIt, typename... T>
 	fmt::format_to_n_result<OutputIt> format_to_n(OutputIt out, size_t n, const std::locale& loc, fmt::format_string<T...> fmt, T&&... args);
 
@@ -86,6 +111,7 @@ namespace hana
 	fmt::format_to_n_result<OutputIt> vformat_to_n(OutputIt out, size_t n, const std::locale& loc, HStringView fmt, fmt::format_args args);
 
 	inline fmt::format_to_n_result<char8_t*> vformat_to_n(char8_t* out, size_t n, const std::locale& loc, HStringView fmt, fmt::format_args args);
+#endif
 
 #pragma endregion format_to_n
 
@@ -97,11 +123,13 @@ namespace hana
 	template<size_t N>
 	fmt::format_to_result vformat_to(char8_t (&out)[N], HStringView fmt, fmt::format_args args);
 
+#ifndef HANA_FMT_NO_LOCALE
 	template<size_t N, typename... T>
 	fmt::format_to_result format_to(char8_t (&out)[N], const std::locale& loc, fmt::format_string<T...> fmt, T&&... args);
 
 	template<size_t N>
 	fmt::format_to_result vformat_to(char8_t (&out)[N], const std::locale& loc, HStringView fmt, fmt::format_args args);
+#endif
 
 #pragma endregion format to fixed array
 
@@ -113,10 +141,12 @@ namespace hana
 
 	[[nodiscard]] inline size_t vformatted_size(HStringView fmt, fmt::format_args args);
 
+#ifndef HANA_FMT_NO_LOCALE
 	template<typename... T>
 	[[nodiscard]] size_t formatted_size(const std::locale& loc, fmt::format_string<T...> fmt, T&&... args);
 
 	[[nodiscard]] inline size_t vformatted_size(const std::locale& loc, HStringView fmt, fmt::format_args args);
+#endif
 
 #pragma endregion formatted_size
 
@@ -127,12 +157,48 @@ namespace hana
 	template<typename... T>
 	HString format(fmt::format_string<T...> fmt, T&&... args);
 
+#ifndef HANA_FMT_NO_LOCALE
 	inline HString vformat(const std::locale& loc, HStringView fmt, fmt::format_args args);
 
 	template<typename... T>
 	HString format(const std::locale& loc, fmt::format_string<T...> fmt, T&&... args);
+#endif
 
 #pragma endregion format
+
+#pragma region format_scratch
+
+	/*!
+	 * @brief
+	 *		Formats into a buffer owned by the calling thread and returns a view of the result.
+	 *		The view is valid until the next `format_scratch` call on the same thread, copy it
+	 *		into an HString to keep it longer. Once the buffer has grown to the thread's largest
+	 *		message nothing is allocated. Calling it from a formatter that is itself running
+	 *		inside `format_scratch` is an error.
+	 *
+	 *		The view may be passed to the next call, as an argument or as the format string:
+	 *		a call whose string arguments point into the scratch buffer formats into a second
+	 *		one. Arguments pointing into both buffers are an error. Custom types holding such
+	 *		views are not detected and must be copied first.
+	 *
+	 * @code
+	 *		const HStringView line = hana::format_scratch(u8"{} {}\n", id, name);
+	 *		fwrite(line.data(), 1, line.size(), file);
+	 * @endcode
+	 */
+	template<typename... T>
+	[[nodiscard]] HStringView format_scratch(fmt::format_string<T...> fmt, T&&... args);
+
+	[[nodiscard]] inline HStringView vformat_scratch(HStringView fmt, fmt::format_args args);
+
+#ifndef HANA_FMT_NO_LOCALE
+	template<typename... T>
+	[[nodiscard]] HStringView format_scratch(const std::locale& loc, fmt::format_string<T...> fmt, T&&... args);
+
+	[[nodiscard]] inline HStringView vformat_scratch(const std::locale& loc, HStringView fmt, fmt::format_args args);
+#endif
+
+#pragma endregion format_scratch
 }
 
 //================================> fmt <==================================
@@ -276,6 +342,15 @@ namespace hana::fmt
 		constexpr void format(parse_context& parse_ctx, context& format_ctx) const;
 	};
 
+	/*!
+	 * @brief
+	 *		Parses a custom formatter, reusing the result parsed on this thread for the same spec.
+	 *		Entries are keyed by the spec's address and bytes, so a call site pays for parse once
+	 *		while a reused or rewritten runtime format string simply misses.
+	 */
+	template<typename Formatter>
+	void parse_cached(Formatter& f, parse_context& parse_ctx);
+
 	struct value {
 		constexpr value() noexcept;
 		constexpr value(int val) noexcept;
@@ -490,6 +565,7 @@ namespace hana::fmt
 		using iterator = const_iterator;
 
 		constexpr explicit parse_context(HStringView fmt, size_t num_args = 0) noexcept;
+		constexpr parse_context(HStringView fmt, size_t num_args, const Type* arg_types) noexcept;
 		parse_context(const parse_context&) = delete;
 		parse_context& operator=(const parse_context&) = delete;
 
@@ -508,10 +584,14 @@ namespace hana::fmt
 		 */
 		constexpr size_t next_arg_id();
 		constexpr void check_arg_id(size_t id);
+		// Rejects non-integer width/precision arguments while the format string is checked at compile time.
+		constexpr void check_dynamic_spec(size_t id);
 
 	private:
 		HStringView format_string_;
 		size_t num_args_;
+		// erased argument types, only known to format_checker
+		const Type* arg_types_ = nullptr;
 		/**
 		 * The standard says this is size_t, however we use ptrdiff_t to save some space
 		 * by not having to store the indexing mode. Above is a more detailed explanation
@@ -525,25 +605,30 @@ namespace hana::fmt
 		using iterator = std::back_insert_iterator<buffer>;
 		using char_type = char8_t;
 
-		context(iterator iter, format_args ctx_args, const std::locale* loc = nullptr);
+		context(iterator iter, format_args ctx_args, const locale_type* loc = nullptr);
 
 		format_arg arg(size_t id) const noexcept;
 		iterator out() const;
 		void advance_to(iterator it);
 		const format_args& get_args() const noexcept;
-		const std::locale* get_lazy_locale() const;
+		const locale_type* get_lazy_locale() const;
 
 	protected:
 		iterator out_;
 		format_args args_;
-		const std::locale* loc_;
+#ifndef HANA_FMT_NO_LOCALE
+		const locale_type* loc_;
+#endif
 	};
 
-	template<typename T, Type>
+	template<typename T, Type ArgType>
 	struct formatter_base {
 		constexpr auto parse(parse_context& parse_ctx);
 		HANA_BASE_API context::iterator format(T value, context& ctx) const;
 
+		// Makes strings and characters print quoted and escaped, as used for range elements.
+		constexpr void set_debug_format() requires (ArgType == Type::char_type || ArgType == Type::cstring_type || ArgType == Type::string_type);
+
 	private:
 		dynamic_format_specs specs_;
 	};
@@ -576,7 +661,9 @@ namespace hana
 	template<> struct formatter<char> : formatter<char8_t> {};
 	template<> struct formatter<void*> : formatter<const void*> {};
 
-	template<> struct formatter<HString> : formatter<HStringView> {};
+	template<size_t Size> struct formatter<BasicHString<Size>> : formatter<HStringView> {};
+	template<size_t N> struct formatter<HFixedString<N>> : formatter<HStringView> {};
+	template<> struct formatter<HSharedString> : formatter<HStringView> {};
 
 	template<typename Traits>
 	struct formatter<std::basic_string_view<char, Traits>> : formatter<HStringView> {
@@ -660,6 +747,27 @@ namespace hana
 		}
 	};
 
+	template<>
+	struct formatter<Fingerprint128> : formatter<HStringView> {
+		using base = formatter<HStringView>;
+
+		fmt::context::iterator format(const Fingerprint128& value, fmt::context& ctx) const {
+			return base::format(value.to_string(), ctx);
+		}
+	};
+
+	template<>
+	struct formatter<std::monostate> : formatter<HStringView> {
+		using base = formatter<HStringView>;
+
+		// never quoted when printed inside a variant
+		constexpr void set_debug_format() = delete;
+
+		fmt::context::iterator format(std::monostate, fmt::context& ctx) const {
+			return base::format(HStringView{u8"monostate"}, ctx);
+		}
+	};
+
 	template<typename T, typename U = std::remove_const_t<T>>
 	concept formattable = requires(formatter<U>& f, const formatter<U>& cf, T&& t, fmt::context fc, fmt::parse_context pc)
 	{
@@ -667,16 +775,204 @@ namespace hana
 		{ cf.format(t, fc) } -> std::same_as<fmt::context::iterator>;
 		requires std::semiregular<formatter<U>>;
 	};
+
+	//==========================> range formatter <=============================
+
+	/*!
+	 * @brief
+	 *		Formats ranges element by element straight into the output, e.g. `[1, 2, 3]`.
+	 *		Spec is `[n][m][:element-spec]`: `n` drops the brackets, `m` (pair-like elements only)
+	 *		prints `{k: v, ...}` and everything after `:` is forwarded to every element.
+	 */
+	template<typename T>
+	class range_formatter {
+	public:
+		constexpr void set_separator(HStringView sep) noexcept;
+		constexpr void set_brackets(HStringView opening, HStringView closing) noexcept;
+
+		constexpr formatter<T>& underlying() noexcept { return underlying_; }
+		constexpr const formatter<T>& underlying() const noexcept { return underlying_; }
+
+		constexpr fmt::parse_context::iterator parse(fmt::parse_context& parse_ctx);
+
+		template<std::ranges::input_range R>
+		fmt::context::iterator format(R&& range, fmt::context& ctx) const;
+
+	private:
+		formatter<T> underlying_;
+		HStringView separator_ = u8", ";
+		HStringView opening_ = u8"[";
+		HStringView closing_ = u8"]";
+	};
+
+	/*!
+	 * @brief
+	 *		Formats `std::pair` and `std::tuple` as `(a, b, ...)`.
+	 *		Spec is `[n|m]`: `n` drops the brackets, `m` (two elements only) prints `a: b`.
+	 */
+	template<typename... Ts>
+	class tuple_formatter {
+	public:
+		constexpr void set_separator(HStringView sep) noexcept;
+		constexpr void set_brackets(HStringView opening, HStringView closing) noexcept;
+
+		constexpr fmt::parse_context::iterator parse(fmt::parse_context& parse_ctx);
+
+		template<typename Tuple>
+		fmt::context::iterator format(const Tuple& value, fmt::context& ctx) const;
+
+	private:
+		std::tuple<formatter<std::remove_cvref_t<Ts>>...> underlying_;
+		HStringView separator_ = u8", ";
+		HStringView opening_ = u8"(";
+		HStringView closing_ = u8")";
+	};
+}
+
+namespace hana::fmt
+{
+	template<typename T>
+	concept string_like = std::same_as<T, HString> || std::same_as<T, HStringView> || std::same_as<T, HSharedString>
+			|| is_specialization_v<T, std::basic_string> || is_specialization_v<T, std::basic_string_view>
+			|| (std::is_array_v<T> && is_char_v<std::remove_extent_t<T>>);
+
+	template<typename R>
+	concept formattable_range = std::ranges::input_range<R> && !string_like<std::remove_cv_t<R>>
+			&& formattable<std::remove_cvref_t<std::ranges::range_reference_t<R>>>;
+
+	template<typename R>
+	concept map_like = requires { typename R::key_type; typename R::mapped_type; };
+
+	template<typename R>
+	concept set_like = requires { typename R::key_type; } && !map_like<R>;
+
+	template<typename T>
+	concept pair_like = is_specialization_v<T, std::pair> || (is_specialization_v<T, std::tuple> && std::tuple_size_v<T> == 2);
+}
+
+namespace hana
+{
+	template<fmt::formattable_range R>
+	struct formatter<R> : range_formatter<std::remove_cvref_t<std::ranges::range_reference_t<R>>> {
+		constexpr formatter() noexcept;
+	};
+
+	template<typename... Ts>
+	requires (formattable<std::remove_cvref_t<Ts>> && ...)
+	struct formatter<std::tuple<Ts...>> : tuple_formatter<Ts...> {};
+
+	template<typename T1, typename T2>
+	requires formattable<std::remove_cvref_t<T1>> && formattable<std::remove_cvref_t<T2>>
+	struct formatter<std::pair<T1, T2>> : tuple_formatter<T1, T2> {};
+
+	/*!
+	 * @brief
+	 *		Formats `std::optional` as `optional(value)` or `none`.
+	 *		Spec is `[n][:value-spec]`: `n` drops the `optional(...)` wrapper.
+	 */
+	template<typename T>
+	requires formattable<std::remove_cvref_t<T>>
+	struct formatter<std::optional<T>> {
+		constexpr fmt::parse_context::iterator parse(fmt::parse_context& parse_ctx);
+		fmt::context::iterator format(const std::optional<T>& value, fmt::context& ctx) const;
+
+	private:
+		formatter<std::remove_cvref_t<T>> underlying_;
+		bool no_brackets_ = false;
+	};
+
+	/*!
+	 * @brief
+	 *		Formats `std::variant` as `variant(value)` and `std::monostate` as `monostate`.
+	 *		Spec is `[n]`: `n` drops the `variant(...)` wrapper.
+	 */
+	template<typename... Ts>
+	requires (formattable<std::remove_cvref_t<Ts>> && ...)
+	struct formatter<std::variant<Ts...>> {
+		constexpr fmt::parse_context::iterator parse(fmt::parse_context& parse_ctx);
+		fmt::context::iterator format(const std::variant<Ts...>& value, fmt::context& ctx) const;
+
+	private:
+		std::tuple<formatter<std::remove_cvref_t<Ts>>...> underlying_;
+		bool no_brackets_ = false;
+	};
+}
+
+namespace hana::fmt
+{
+	//=========================> chrono formatter <=============================
+
+	enum class ChronoKind : uint8_t { duration, time_of_day, time_point };
+
+	// Every duration and time point is reduced to this before it reaches the exported writer.
+	struct chrono_value {
+		// seconds since epoch for time points, absolute seconds otherwise
+		int64_t seconds_ = 0;
+		// fractional part of the second, in units of 10^-digits_
+		int64_t subseconds_ = 0;
+		int digits_ = 0;
+		bool negative_ = false;
+		bool floating_ = false;
+		ChronoKind kind_ = ChronoKind::duration;
+		// raw tick count and period, used by %Q, %q and the default duration output
+		long long count_ = 0;
+		double fcount_ = 0;
+		intmax_t num_ = 1;
+		intmax_t den_ = 1;
+	};
+
+	/*!
+	 * @brief
+	 *		Shared spec handling of the chrono formatters: `[fill-align][width][chrono-specs]`
+	 *		where chrono-specs use strftime-like `%` conversions (always UTC, "C" locale names).
+	 */
+	class chrono_formatter {
+	public:
+		constexpr explicit chrono_formatter(ChronoKind kind) noexcept : kind_(kind) {}
+
+		constexpr parse_context::iterator parse(parse_context& parse_ctx);
+		HANA_BASE_API context::iterator format(const chrono_value& value, context& ctx) const;
+
+	private:
+		dynamic_format_specs specs_;
+		HStringView chrono_specs_;
+		ChronoKind kind_;
+	};
+}
+
+namespace hana
+{
+	// Prints `42ms` by default.
+	template<typename Rep, typename Period>
+	struct formatter<std::chrono::duration<Rep, Period>> : fmt::chrono_formatter {
+		constexpr formatter() noexcept : chrono_formatter(fmt::ChronoKind::duration) {}
+		fmt::context::iterator format(const std::chrono::duration<Rep, Period>& value, fmt::context& ctx) const;
+	};
+
+	// Prints `2024-01-31 12:34:56.789` (UTC) by default, with as many fractional digits as `Duration` needs.
+	template<typename Duration>
+	struct formatter<std::chrono::sys_time<Duration>> : fmt::chrono_formatter {
+		constexpr formatter() noexcept : chrono_formatter(fmt::ChronoKind::time_point) {}
+		fmt::context::iterator format(const std::chrono::sys_time<Duration>& value, fmt::context& ctx) const;
+	};
+
+	// Prints `12:34:56` by default.
+	template<typename Duration>
+	struct formatter<std::chrono::hh_mm_ss<Duration>> : fmt::chrono_formatter {
+		constexpr formatter() noexcept : chrono_formatter(fmt::ChronoKind::time_of_day) {}
+		fmt::context::iterator format(const std::chrono::hh_mm_ss<Duration>& value, fmt::context& ctx) const;
+	};
 }
 
 namespace hana::fmt
 {
 	HANA_BASE_API void report_error(const char8_t* message);
-	HANA_BASE_API void vformat_to(buffer& buf, HStringView fmt, format_args args, const std::locale* loc = nullptr);
-	HANA_BASE_API char8_t* vformat_to(char8_t* out, HStringView fmt, format_args args, const std::locale* loc = nullptr);
-	HANA_BASE_API format_to_n_result<char8_t*> vformat_to_n(char8_t* out, size_t n, HStringView fmt, format_args args, const std::locale* loc = nullptr);
-	HANA_BASE_API size_t vformatted_size(HStringView fmt, format_args args, const std::locale* loc = nullptr);
-	HANA_BASE_API HString vformat(HStringView fmt, format_args args, const std::locale* loc = nullptr);
+	HANA_BASE_API void vformat_to(buffer& buf, HStringView fmt, format_args args, const locale_type* loc = nullptr);
+	HANA_BASE_API char8_t* vformat_to(char8_t* out, HStringView fmt, format_args args, const locale_type* loc = nullptr);
+	HANA_BASE_API format_to_n_result<char8_t*> vformat_to_n(char8_t* out, size_t n, HStringView fmt, format_args args, const locale_type* loc = nullptr);
+	HANA_BASE_API size_t vformatted_size(HStringView fmt, format_args args, const locale_type* loc = nullptr);
+	HANA_BASE_API HString vformat(HStringView fmt, format_args args, const locale_type* loc = nullptr);
+	HANA_BASE_API HStringView vformat_scratch(HStringView fmt, format_args args, const locale_type* loc = nullptr);
 
 #pragma region Type
 
@@ -736,6 +1032,52 @@ namespace hana::fmt
 
 #pragma region custom_value
 
+	enum : size_t {
+		parse_cache_size = 16,
+		parse_cache_max_spec = 32,
+	};
+
+	template<typename Formatter>
+	struct parse_cache_entry {
+		const char8_t* key_ = nullptr;
+		size_t length_ = static_cast<size_t>(-1);
+		char8_t spec_[parse_cache_max_spec] = {};
+		Formatter formatter_;
+	};
+
+	template<typename Formatter>
+	void parse_cached(Formatter& f, parse_context& parse_ctx) {
+		thread_local parse_cache_entry<Formatter> entries[parse_cache_size];
+
+		const char8_t* first = parse_ctx.unchecked_begin();
+		const char8_t* last = parse_ctx.unchecked_end();
+		const char8_t* spec_end = first;
+		// nested replacement fields consume argument ids, those specs always go through parse
+		while (spec_end != last && *spec_end != u8'}' && *spec_end != u8'{') ++spec_end;
+		const auto length = static_cast<size_t>(spec_end - first);
+		if ((spec_end != last && *spec_end == u8'{') || length > parse_cache_max_spec) {
+			parse_ctx.advance_to(f.parse(parse_ctx));
+			return;
+		}
+
+		auto& entry = entries[(reinterpret_cast<uintptr_t>(first) * 0x9E3779B97F4A7C15ull) >> 60];
+		if (entry.key_ == first && entry.length_ == length && std::equal(first, spec_end, entry.spec_)) {
+			// copied out so a recursive format of the same type may evict the entry
+			f = entry.formatter_;
+			parse_ctx.advance_to(parse_ctx.begin() + length);
+			return;
+		}
+
+		const auto iter = f.parse(parse_ctx);
+		parse_ctx.advance_to(iter);
+		if (std::to_address(iter) == spec_end) {
+			entry.key_ = first;
+			entry.length_ = length;
+			std::copy(first, spec_end, entry.spec_);
+			entry.formatter_ = f;
+		}
+	}
+
 	template<typename T>
 	custom_value::custom_value(const T& value) noexcept {
 		using CT = std::conditional_t<formattable<const T>, const T, T>;
@@ -746,7 +1088,7 @@ namespace hana::fmt
 			using U = std::remove_const_t<T>;
 			// doesn't drop const-qualifier per an unnumbered LWG issue
 			formatter<U> formatter;
-			parse_ctx.advance_to(formatter.parse(parse_ctx));
+			parse_cached(formatter, parse_ctx);
 			format_ctx.advance_to(formatter.format(*const_cast<CT*>(static_cast<const U*>(ptr)), format_ctx));
 		};
 	}
@@ -962,11 +1304,13 @@ namespace hana::fmt
 		using ParseFunc = parse_context::iterator (*)(parse_context&);
 
 		static constexpr size_t NUM_ARGS = sizeof...(Args);
+		Type arg_types_[NUM_ARGS > 0 ? NUM_ARGS : 1];
 		parse_context parse_context_;
 		ParseFunc parse_funcs_[NUM_ARGS > 0 ? NUM_ARGS : 1];
 
 		consteval explicit format_checker(HStringView fmt) noexcept
-			: parse_context_(fmt, NUM_ARGS), parse_funcs_{&compile_time_parse_format_specs<Args>...} {}
+			: arg_types_{type_constant<format_arg_traits::storage_type<Args>>::value...},
+			  parse_context_(fmt, NUM_ARGS, arg_types_), parse_funcs_{&compile_time_parse_format_specs<Args>...} {}
 
 		static constexpr void on_text(const char8_t*, const char8_t*) noexcept {}
 		static constexpr void on_replacement_field(size_t, const char8_t*) noexcept {}
@@ -1061,6 +1405,206 @@ namespace hana::fmt
 		}
 	};
 
+	template<typename OutputIt>
+	concept contiguous_back_inserter = is_specialization_v<OutputIt, std::back_insert_iterator>
+			&& requires(typename OutputIt::container_type& c, size_t n)
+			{
+				{ c.data() } -> std::same_as<char8_t*>;
+				{ c.size() } -> std::convertible_to<size_t>;
+				{ c.capacity() } -> std::convertible_to<size_t>;
+				c.resize(n);
+			};
+
+	// memory_buffer and other fmt::buffer targets are written to directly.
+	template<typename OutputIt>
+	concept buffer_back_inserter = is_specialization_v<OutputIt, std::back_insert_iterator>
+			&& std::derived_from<typename OutputIt::container_type, buffer>;
+
+	template<typename Container>
+	Container& get_container(std::back_insert_iterator<Container> it) {
+		struct accessor : std::back_insert_iterator<Container> {
+			explicit accessor(std::back_insert_iterator<Container> iter) : std::back_insert_iterator<Container>(iter) {}
+			using std::back_insert_iterator<Container>::container;
+		};
+		return *accessor(it).container;
+	}
+
+	// A buffer that formats straight into the tail of a contiguous container, growing it by 1.5x and trimming on destruction.
+	template<typename Container>
+	class container_buffer : public buffer {
+	public:
+		explicit container_buffer(Container& c)
+			: buffer(grow), container_(c), offset_(c.size()) {
+			const size_t available = container_.capacity() > offset_ ? container_.capacity() - offset_ : 0;
+			reset(std::max<size_t>(available, initial_capacity));
+		}
+
+		container_buffer(const container_buffer&) = delete;
+		container_buffer& operator=(const container_buffer&) = delete;
+
+		~container_buffer() {
+			container_.resize(offset_ + this->size());
+		}
+
+	private:
+		enum { initial_capacity = 64 };
+		Container& container_;
+		size_t offset_;
+
+		void reset(size_t capacity) {
+			if constexpr (requires(Container& c) { c.resize_and_overwrite(size_t{}, [](auto*, auto count) { return count; }); }) {
+				// the new capacity stays uninitialized, formatting overwrites it
+				container_.resize_and_overwrite(offset_ + capacity, [](auto*, auto count) { return count; });
+			} else {
+				// value-initializes the new capacity, one extra fill per grow for containers such as std::vector
+				container_.resize(offset_ + capacity);
+			}
+			this->set(container_.data() + offset_, capacity);
+		}
+
+		static void grow(buffer* buf, size_t capacity) {
+			static_cast<container_buffer*>(buf)->reset(std::max(capacity, buf->capacity() + buf->capacity() / 2));
+		}
+	};
+
+	/*!
+	 * @brief
+	 *		Format target with SIZE bytes of inline storage that spills to Allocator, growing by 1.5x.
+	 *		Any char8_t allocator works, e.g. a std::pmr::polymorphic_allocator over a monotonic
+	 *		resource. With the default allocator, `std::move(buf).to_string()` hands a spilled
+	 *		buffer to HString without copying.
+	 */
+	template<size_t SIZE, typename Allocator>
+	class memory_buffer : public buffer {
+	public:
+		using value_type = char8_t;
+		using const_reference = const char8_t&;
+		using allocator_type = Allocator;
+
+		explicit memory_buffer(const Allocator& alloc = Allocator()) : buffer(grow), alloc_(alloc) {
+			this->set(store_, SIZE);
+		}
+
+		memory_buffer(memory_buffer&& other) noexcept : buffer(grow), alloc_(std::move(other.alloc_)) {
+			this->move(other);
+		}
+
+		~memory_buffer() { deallocate(); }
+
+		// Moves the content of the other `memory_buffer` object to this one. The heap block is only taken over when the
+		// allocator propagates or compares equal, otherwise the content is copied into storage from this allocator.
+		memory_buffer& operator=(memory_buffer&& other) noexcept(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value) {
+			assert(this != &other);
+			if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+				deallocate();
+				alloc_ = std::move(other.alloc_);
+				this->move(other);
+			} else {
+				if (alloc_traits::is_always_equal::value || alloc_ == other.alloc_) {
+					deallocate();
+					this->move(other);
+				} else {
+					this->clear();
+					this->append(other.data(), other.data() + other.size());
+					other.clear();
+				}
+			}
+			return *this;
+		}
+
+		// Returns a copy of the allocator associated with this buffer.
+		Allocator get_allocator() const { return alloc_; }
+
+		// Resizes the buffer to contain `count` elements, new elements are not initialized.
+		void resize(size_t count) { this->try_resize(count); }
+
+		// Increases the buffer capacity to `new_capacity`.
+		void reserve(size_t new_capacity) { this->try_reserve(new_capacity); }
+
+		using buffer::append;
+
+		template<typename ContiguousRange>
+		void append(const ContiguousRange& range) {
+			this->append(range.data(), range.data() + range.size());
+		}
+
+		// Copies the content, the buffer keeps its storage.
+		HString to_string() const& { return HString{this->data(), this->size()}; }
+		// Adopts the heap block when HString can own it, otherwise copies; leaves the buffer empty.
+		HString to_string() &&;
+
+	private:
+		using alloc_traits = std::allocator_traits<Allocator>;
+
+		char8_t store_[SIZE];
+
+		// Don't inherit from Allocator to avoid generating type_info for it.
+		[[no_unique_address]] Allocator alloc_;
+
+		// Move data from other to this buffer.
+		void move(memory_buffer& other) {
+			char8_t* data = other.data();
+			const size_t size = other.size();
+			const size_t capacity = other.capacity();
+			if (data == other.store_) {
+				this->set(store_, capacity);
+				std::copy(other.store_, other.store_ + size, store_);
+			} else {
+				this->set(data, capacity);
+				// Set pointer to the inline array so that delete is not called
+				// when deallocating.
+				other.set(other.store_, 0);
+				other.clear();
+			}
+			this->resize(size);
+		}
+
+		// Deallocate memory allocated by the buffer.
+		void deallocate() {
+			char8_t* data = this->data();
+			if (data != store_) alloc_.deallocate(data, this->capacity());
+		}
+
+		static void grow(buffer* buf, size_t size) {
+			auto& self = *static_cast<memory_buffer*>(buf);
+			const size_t max_size = std::allocator_traits<Allocator>::max_size(self.alloc_);
+			size_t old_capacity = buf->capacity();
+			size_t new_capacity = old_capacity + old_capacity / 2;
+			if (size > new_capacity)
+				new_capacity = size;
+			else if (new_capacity > max_size)
+				new_capacity = std::max(size, max_size);
+			char8_t* old_data = buf->data();
+			char8_t* new_data = self.alloc_.allocate(new_capacity);
+			// The following code doesn't throw, so the raw pointer above doesn't leak.
+			std::memcpy(new_data, old_data, buf->size());
+			self.set(new_data, new_capacity);
+			// deallocate must not throw according to the standard, but even if it does,
+			// the buffer already uses the new storage and will deallocate it in
+			// destructor.
+			if (old_data != self.store_) self.alloc_.deallocate(old_data, old_capacity);
+		}
+	};
+
+	template<size_t SIZE, typename Allocator>
+	HString memory_buffer<SIZE, Allocator>::to_string() && {
+		char8_t* data = this->data();
+		const size_t size = this->size();
+		const size_t capacity = this->capacity();
+		if constexpr (std::is_same_v<Allocator, HString::allocator_type>) {
+			// HString needs room for the terminator and keeps short strings inline
+			if (data != store_ && size < capacity && size > HString::SSOCapacity) {
+				this->set(store_, SIZE);
+				this->clear();
+				return HString::adopt(data, size, capacity);
+			}
+		}
+
+		HString result{data, size};
+		this->clear();
+		return result;
+	}
+
 #pragma endregion buffer
 
 #pragma region specs_setter
@@ -1094,20 +1638,26 @@ namespace hana::fmt
 
 	constexpr void dynamic_specs_handler::on_dynamic_width(size_t arg_id) const {
 		parse_ctx_.check_arg_id(arg_id);
+		parse_ctx_.check_dynamic_spec(arg_id);
 		dynamic_specs_.dynamic_width_index_ = verify_dynamic_arg_index_in_range(arg_id);
 	}
 
 	constexpr void dynamic_specs_handler::on_dynamic_width(auto_id_tag) const {
-		dynamic_specs_.dynamic_width_index_ = verify_dynamic_arg_index_in_range(parse_ctx_.next_arg_id());
+		const size_t arg_id = parse_ctx_.next_arg_id();
+		parse_ctx_.check_dynamic_spec(arg_id);
+		dynamic_specs_.dynamic_width_index_ = verify_dynamic_arg_index_in_range(arg_id);
 	}
 
 	constexpr void dynamic_specs_handler::on_dynamic_precision(size_t arg_id) const {
 		parse_ctx_.check_arg_id(arg_id);
+		parse_ctx_.check_dynamic_spec(arg_id);
 		dynamic_specs_.dynamic_precision_index_ = verify_dynamic_arg_index_in_range(arg_id);
 	}
 
 	constexpr void dynamic_specs_handler::on_dynamic_precision(auto_id_tag) const {
-		dynamic_specs_.dynamic_precision_index_ = verify_dynamic_arg_index_in_range(parse_ctx_.next_arg_id());
+		const size_t arg_id = parse_ctx_.next_arg_id();
+		parse_ctx_.check_dynamic_spec(arg_id);
+		dynamic_specs_.dynamic_precision_index_ = verify_dynamic_arg_index_in_range(arg_id);
 	}
 
 	constexpr int dynamic_specs_handler::verify_dynamic_arg_index_in_range(size_t idx) {
@@ -1145,8 +1695,12 @@ namespace hana::fmt
 		}
 
 		constexpr void on_localized() {
+#ifdef HANA_FMT_NO_LOCALE
+			report_error(u8"'L' is unavailable, hana::fmt is built with HANA_FMT_NO_LOCALE.");
+#else
 			require_numeric_argument();
 			Handler::on_localized();
+#endif
 		}
 
 		constexpr void on_hash() {
@@ -1542,6 +2096,11 @@ namespace hana::fmt
 		return parse_ctx.begin() + (iter - parse_ctx.unchecked_begin());
 	}
 
+	template<typename T, Type ArgType>
+	constexpr void formatter_base<T, ArgType>::set_debug_format() requires (ArgType == Type::char_type || ArgType == Type::cstring_type || ArgType == Type::string_type) {
+		specs_.type_ = u8'?';
+	}
+
 #pragma endregion compile_parse
 }
 
@@ -1625,6 +2184,9 @@ namespace hana::fmt
 	constexpr parse_context::parse_context(HStringView fmt, size_t num_args) noexcept
 		: format_string_(fmt), num_args_(num_args) {}
 
+	constexpr parse_context::parse_context(HStringView fmt, size_t num_args, const Type* arg_types) noexcept
+		: format_string_(fmt), num_args_(num_args), arg_types_(arg_types) {}
+
 	constexpr parse_context::const_iterator parse_context::begin() const noexcept {
 		return format_string_.begin();
 	}
@@ -1671,12 +2233,26 @@ namespace hana::fmt
 		next_arg_id_ = -1;
 	}
 
+	constexpr void parse_context::check_dynamic_spec(size_t id) {
+		if (std::is_constant_evaluated() && arg_types_ && id < num_args_) {
+			const Type type = arg_types_[id];
+			if (type != Type::int_type && type != Type::uint_type && type != Type::long_long_type && type != Type::ulong_long_type) {
+				fmt::report_error(u8"width/precision is not integer.");
+			}
+		}
+	}
+
 #pragma endregion parse_context
 
 #pragma region context
 
-	inline context::context(iterator iter, format_args ctx_args, const std::locale* loc)
+#ifdef HANA_FMT_NO_LOCALE
+	inline context::context(iterator iter, format_args ctx_args, const locale_type*)
+		: out_(iter), args_(ctx_args) {}
+#else
+	inline context::context(iterator iter, format_args ctx_args, const locale_type* loc)
 		: out_(iter), args_(ctx_args), loc_(loc) {}
+#endif
 
 	inline format_arg context::arg(size_t id) const noexcept {
 		return args_.get(id);
@@ -1694,8 +2270,12 @@ namespace hana::fmt
 		return args_;
 	}
 
-	inline const std::locale* context::get_lazy_locale() const {
+	inline const locale_type* context::get_lazy_locale() const {
+#ifdef HANA_FMT_NO_LOCALE
+		return nullptr;
+#else
 		return loc_;
+#endif
 	}
 
 #pragma endregion context
@@ -1711,6 +2291,401 @@ namespace hana::fmt
 	}
 }
 
+namespace hana::fmt
+{
+#pragma region range helpers
+
+	inline context::iterator write_text(context::iterator out, HStringView text) {
+		for (const char8_t ch: text) *out++ = ch;
+		return out;
+	}
+
+	// Parses an empty spec for an element formatter, then asks for quoted strings and chars.
+	template<typename Formatter>
+	constexpr void parse_element_specs(Formatter& f, parse_context& parse_ctx) {
+		(void) f.parse(parse_ctx);
+		if constexpr (requires { f.set_debug_format(); }) {
+			f.set_debug_format();
+		}
+	}
+
+#pragma endregion range helpers
+}
+
+namespace hana
+{
+#pragma region range_formatter
+
+	template<typename T>
+	constexpr void range_formatter<T>::set_separator(HStringView sep) noexcept {
+		separator_ = sep;
+	}
+
+	template<typename T>
+	constexpr void range_formatter<T>::set_brackets(HStringView opening, HStringView closing) noexcept {
+		opening_ = opening;
+		closing_ = closing;
+	}
+
+	template<typename T>
+	constexpr fmt::parse_context::iterator range_formatter<T>::parse(fmt::parse_context& parse_ctx) {
+		auto first = parse_ctx.unchecked_begin();
+		const auto last = parse_ctx.unchecked_end();
+
+		bool no_brackets = false;
+		if (first != last && *first == 'n') {
+			no_brackets = true;
+			++first;
+		}
+
+		if (first != last && *first == 'm') {
+			if constexpr (fmt::pair_like<T>) {
+				set_brackets(u8"{", u8"}");
+				underlying_.set_brackets({}, {});
+				underlying_.set_separator(u8": ");
+			} else {
+				fmt::report_error(u8"'m' range specifier requires pair-like elements.");
+			}
+			++first;
+		}
+
+		if (no_brackets) {
+			set_brackets({}, {});
+		}
+
+		if (first != last && *first == ':') {
+			parse_ctx.advance_to(parse_ctx.begin() + (first + 1 - parse_ctx.unchecked_begin()));
+			first = underlying_.parse(parse_ctx);
+		} else {
+			parse_ctx.advance_to(parse_ctx.begin() + (first - parse_ctx.unchecked_begin()));
+			fmt::parse_element_specs(underlying_, parse_ctx);
+		}
+
+		if (first != last && *first != '}') {
+			fmt::report_error(u8"invalid range format specifier.");
+		}
+		return parse_ctx.begin() + (first - parse_ctx.unchecked_begin());
+	}
+
+	template<typename T>
+	template<std::ranges::input_range R>
+	fmt::context::iterator range_formatter<T>::format(R&& range, fmt::context& ctx) const {
+		auto out = fmt::write_text(ctx.out(), opening_);
+		bool need_separator = false;
+		for (auto&& elem: range) {
+			if (need_separator) {
+				out = fmt::write_text(out, separator_);
+			}
+			need_separator = true;
+			ctx.advance_to(out);
+			out = underlying_.format(elem, ctx);
+		}
+		return fmt::write_text(out, closing_);
+	}
+
+	template<fmt::formattable_range R>
+	constexpr formatter<R>::formatter() noexcept {
+		using base = range_formatter<std::remove_cvref_t<std::ranges::range_reference_t<R>>>;
+		if constexpr (fmt::map_like<R> && fmt::pair_like<std::remove_cvref_t<std::ranges::range_reference_t<R>>>) {
+			base::set_brackets(u8"{", u8"}");
+			base::underlying().set_brackets({}, {});
+			base::underlying().set_separator(u8": ");
+		} else if constexpr (fmt::set_like<R>) {
+			base::set_brackets(u8"{", u8"}");
+		}
+	}
+
+#pragma endregion range_formatter
+
+#pragma region tuple_formatter
+
+	template<typename... Ts>
+	constexpr void tuple_formatter<Ts...>::set_separator(HStringView sep) noexcept {
+		separator_ = sep;
+	}
+
+	template<typename... Ts>
+	constexpr void tuple_formatter<Ts...>::set_brackets(HStringView opening, HStringView closing) noexcept {
+		opening_ = opening;
+		closing_ = closing;
+	}
+
+	template<typename... Ts>
+	constexpr fmt::parse_context::iterator tuple_formatter<Ts...>::parse(fmt::parse_context& parse_ctx) {
+		auto first = parse_ctx.unchecked_begin();
+		const auto last = parse_ctx.unchecked_end();
+
+		if (first != last && *first == 'n') {
+			set_brackets({}, {});
+			++first;
+		} else if (first != last && *first == 'm') {
+			if constexpr (sizeof...(Ts) == 2) {
+				set_brackets({}, {});
+				set_separator(u8": ");
+			} else {
+				fmt::report_error(u8"'m' tuple specifier requires exactly two elements.");
+			}
+			++first;
+		}
+
+		if (first != last && *first != '}') {
+			fmt::report_error(u8"invalid tuple format specifier.");
+		}
+
+		parse_ctx.advance_to(parse_ctx.begin() + (first - parse_ctx.unchecked_begin()));
+		std::apply([&parse_ctx](auto&... f) { (fmt::parse_element_specs(f, parse_ctx), ...); }, underlying_);
+		return parse_ctx.begin();
+	}
+
+	template<typename... Ts>
+	template<typename Tuple>
+	fmt::context::iterator tuple_formatter<Ts...>::format(const Tuple& value, fmt::context& ctx) const {
+		auto out = fmt::write_text(ctx.out(), opening_);
+		[&]<size_t... I>(std::index_sequence<I...>) {
+			((ctx.advance_to(I == 0 ? out : fmt::write_text(out, separator_)), out = std::get<I>(underlying_).format(std::get<I>(value), ctx)), ...);
+		}(std::index_sequence_for<Ts...>{});
+		return fmt::write_text(out, closing_);
+	}
+
+#pragma endregion tuple_formatter
+
+#pragma region optional & variant formatter
+
+	template<typename T>
+	requires formattable<std::remove_cvref_t<T>>
+	constexpr fmt::parse_context::iterator formatter<std::optional<T>>::parse(fmt::parse_context& parse_ctx) {
+		auto first = parse_ctx.unchecked_begin();
+		const auto last = parse_ctx.unchecked_end();
+
+		if (first != last && *first == 'n') {
+			no_brackets_ = true;
+			++first;
+		}
+
+		if (first != last && *first == ':') {
+			parse_ctx.advance_to(parse_ctx.begin() + (first + 1 - parse_ctx.unchecked_begin()));
+			first = underlying_.parse(parse_ctx);
+		} else {
+			parse_ctx.advance_to(parse_ctx.begin() + (first - parse_ctx.unchecked_begin()));
+			fmt::parse_element_specs(underlying_, parse_ctx);
+		}
+
+		if (first != last && *first != '}') {
+			fmt::report_error(u8"invalid optional format specifier.");
+		}
+		return parse_ctx.begin() + (first - parse_ctx.unchecked_begin());
+	}
+
+	template<typename T>
+	requires formattable<std::remove_cvref_t<T>>
+	fmt::context::iterator formatter<std::optional<T>>::format(const std::optional<T>& value, fmt::context& ctx) const {
+		if (!value) {
+			return fmt::write_text(ctx.out(), u8"none");
+		}
+
+		if (no_brackets_) {
+			return underlying_.format(*value, ctx);
+		}
+
+		ctx.advance_to(fmt::write_text(ctx.out(), u8"optional("));
+		return fmt::write_text(underlying_.format(*value, ctx), u8")");
+	}
+
+	template<typename... Ts>
+	requires (formattable<std::remove_cvref_t<Ts>> && ...)
+	constexpr fmt::parse_context::iterator formatter<std::variant<Ts...>>::parse(fmt::parse_context& parse_ctx) {
+		auto first = parse_ctx.unchecked_begin();
+		const auto last = parse_ctx.unchecked_end();
+
+		if (first != last && *first == 'n') {
+			no_brackets_ = true;
+			++first;
+		}
+
+		if (first != last && *first != '}') {
+			fmt::report_error(u8"invalid variant format specifier.");
+		}
+
+		parse_ctx.advance_to(parse_ctx.begin() + (first - parse_ctx.unchecked_begin()));
+		std::apply([&parse_ctx](auto&... f) { (fmt::parse_element_specs(f, parse_ctx), ...); }, underlying_);
+		return parse_ctx.begin();
+	}
+
+	template<typename... Ts>
+	requires (formattable<std::remove_cvref_t<Ts>> && ...)
+	fmt::context::iterator formatter<std::variant<Ts...>>::format(const std::variant<Ts...>& value, fmt::context& ctx) const {
+		if (value.valueless_by_exception()) {
+			return fmt::write_text(ctx.out(), u8"valueless by exception");
+		}
+
+		if (!no_brackets_) {
+			ctx.advance_to(fmt::write_text(ctx.out(), u8"variant("));
+		}
+
+		auto out = [&]<size_t... I>(std::index_sequence<I...>) {
+			fmt::context::iterator result = ctx.out();
+			((value.index() == I ? (result = std::get<I>(underlying_).format(*std::get_if<I>(&value), ctx), true) : false) || ...);
+			return result;
+		}(std::index_sequence_for<Ts...>{});
+
+		return no_brackets_ ? out : fmt::write_text(out, u8")");
+	}
+
+#pragma endregion optional & variant formatter
+}
+
+namespace hana::fmt
+{
+#pragma region chrono formatter
+
+	constexpr bool is_valid_chrono_conversion(char8_t ch, ChronoKind kind) {
+		switch (ch) {
+			case 'n':
+			case 't':
+			case '%':
+			case 'H':
+			case 'M':
+			case 'S':
+			case 'R':
+			case 'T':
+				return true;
+			case 'Q':
+			case 'q':
+				return kind == ChronoKind::duration;
+			case 'Y':
+			case 'y':
+			case 'C':
+			case 'm':
+			case 'd':
+			case 'e':
+			case 'j':
+			case 'I':
+			case 'p':
+			case 'F':
+			case 'D':
+			case 'a':
+			case 'A':
+			case 'b':
+			case 'B':
+			case 'u':
+			case 'w':
+			case 'z':
+			case 'Z':
+				return kind == ChronoKind::time_point;
+			default:
+				return false;
+		}
+	}
+
+	constexpr parse_context::iterator chrono_formatter::parse(parse_context& parse_ctx) {
+		auto first = parse_ctx.unchecked_begin();
+		const auto last = parse_ctx.unchecked_end();
+
+		if (first != last && *first != '}') {
+			dynamic_specs_handler handler{specs_, parse_ctx};
+			first = fmt::parse_align(first, last, handler);
+			if (first != last && *first != '}') {
+				first = fmt::parse_width(first, last, handler);
+			}
+		}
+
+		const auto specs_begin = first;
+		while (first != last && *first != '}') {
+			if (*first == '{') {
+				report_error(u8"invalid chrono format specifier.");
+			}
+			if (*first == '%') {
+				if (++first == last || !is_valid_chrono_conversion(*first, kind_)) {
+					report_error(u8"invalid chrono conversion specifier.");
+				}
+			}
+			++first;
+		}
+		chrono_specs_ = HStringView{specs_begin, static_cast<size_t>(first - specs_begin)};
+
+		return parse_ctx.begin() + (first - parse_ctx.unchecked_begin());
+	}
+
+	// Same rule as hh_mm_ss::fractional_width: exact decimal digits of the period, capped to 18, else 6.
+	template<typename Period>
+	consteval int chrono_fractional_width() {
+		if constexpr (Period::den == 1) {
+			return 0;
+		} else {
+			intmax_t pow10 = 1;
+			for (int width = 1; width <= 18; ++width) {
+				pow10 *= 10;
+				if (pow10 % Period::den == 0) return width;
+			}
+			return 6;
+		}
+	}
+
+	consteval intmax_t chrono_pow10(int exp) {
+		intmax_t result = 1;
+		while (exp-- > 0) result *= 10;
+		return result;
+	}
+
+	template<typename Duration>
+	chrono_value make_chrono_value(const Duration& value, ChronoKind kind) {
+		using namespace std::chrono;
+		using rep = typename Duration::rep;
+		using period = typename Duration::period;
+		constexpr int DIGITS = chrono_fractional_width<period>();
+		using subseconds = duration<int64_t, std::ratio<1, chrono_pow10(DIGITS)>>;
+
+		chrono_value result;
+		result.kind_ = kind;
+		result.digits_ = DIGITS;
+		result.num_ = period::num;
+		result.den_ = period::den;
+		result.floating_ = std::chrono::treat_as_floating_point_v<rep>;
+		if constexpr (std::chrono::treat_as_floating_point_v<rep>) {
+			result.fcount_ = static_cast<double>(value.count());
+		} else {
+			result.count_ = static_cast<long long>(value.count());
+		}
+
+		if (kind == ChronoKind::time_point) {
+			const auto secs = floor<seconds>(value);
+			result.seconds_ = secs.count();
+			result.subseconds_ = duration_cast<subseconds>(value - secs).count();
+		} else {
+			result.negative_ = value < Duration::zero();
+			const auto abs = result.negative_ ? -value : value;
+			const auto secs = duration_cast<seconds>(abs);
+			result.seconds_ = secs.count();
+			result.subseconds_ = duration_cast<subseconds>(abs - secs).count();
+		}
+		return result;
+	}
+
+#pragma endregion chrono formatter
+}
+
+namespace hana
+{
+#pragma region chrono formatter
+
+	template<typename Rep, typename Period>
+	fmt::context::iterator formatter<std::chrono::duration<Rep, Period>>::format(const std::chrono::duration<Rep, Period>& value, fmt::context& ctx) const {
+		return chrono_formatter::format(fmt::make_chrono_value(value, fmt::ChronoKind::duration), ctx);
+	}
+
+	template<typename Duration>
+	fmt::context::iterator formatter<std::chrono::sys_time<Duration>>::format(const std::chrono::sys_time<Duration>& value, fmt::context& ctx) const {
+		return chrono_formatter::format(fmt::make_chrono_value(value.time_since_epoch(), fmt::ChronoKind::time_point), ctx);
+	}
+
+	template<typename Duration>
+	fmt::context::iterator formatter<std::chrono::hh_mm_ss<Duration>>::format(const std::chrono::hh_mm_ss<Duration>& value, fmt::context& ctx) const {
+		return chrono_formatter::format(fmt::make_chrono_value(value.to_duration(), fmt::ChronoKind::time_of_day), ctx);
+	}
+
+#pragma endregion chrono formatter
+}
+
 namespace hana
 {
 	//=====================> format_to <========================
@@ -1723,15 +2698,25 @@ namespace hana
 
 	template<std::output_iterator<const char8_t&> OutputIt>
 	OutputIt vformat_to(OutputIt out, HStringView fmt, fmt::format_args args) {
-		auto buf = fmt::iterator_buffer<OutputIt, fmt::buffer_traits>(out);
-		fmt::vformat_to(buf, fmt, args);
-		return buf.out();
+		if constexpr (fmt::buffer_back_inserter<OutputIt>) {
+			fmt::vformat_to(fmt::get_container(out), fmt, args);
+			return out;
+		} else if constexpr (fmt::contiguous_back_inserter<OutputIt>) {
+			auto buf = fmt::container_buffer(fmt::get_container(out));
+			fmt::vformat_to(buf, fmt, args);
+			return out;
+		} else {
+			auto buf = fmt::iterator_buffer<OutputIt, fmt::buffer_traits>(out);
+			fmt::vformat_to(buf, fmt, args);
+			return buf.out();
+		}
 	}
 
 	inline char8_t* vformat_to(char8_t* out, HStringView fmt, fmt::format_args args) {
 		return fmt::vformat_to(out, fmt, args);
 	}
 
+#ifndef HANA_FMT_NO_LOCALE
 	template<std::output_iterator<const char8_t&> OutputIt, typename... T>
 	OutputIt format_to(OutputIt out, const std::locale& loc, fmt::format_string<T...> fmt, T&&... args) {
 		constexpr auto DESC = fmt::make_descriptor<T...>();
@@ -1740,14 +2725,24 @@ namespace hana
 
 	template<std::output_iterator<const char8_t&> OutputIt>
 	OutputIt vformat_to(OutputIt out, const std::locale& loc, HStringView fmt, fmt::format_args args) {
-		auto buf = fmt::iterator_buffer<OutputIt, fmt::buffer_traits>(out);
-		fmt::vformat_to(buf, fmt, args, &loc);
-		return buf.out();
+		if constexpr (fmt::buffer_back_inserter<OutputIt>) {
+			fmt::vformat_to(fmt::get_container(out), fmt, args, &loc);
+			return out;
+		} else if constexpr (fmt::contiguous_back_inserter<OutputIt>) {
+			auto buf = fmt::container_buffer(fmt::get_container(out));
+			fmt::vformat_to(buf, fmt, args, &loc);
+			return out;
+		} else {
+			auto buf = fmt::iterator_buffer<OutputIt, fmt::buffer_traits>(out);
+			fmt::vformat_to(buf, fmt, args, &loc);
+			return buf.out();
+		}
 	}
 
 	inline char8_t* vformat_to(char8_t* out, const std::locale& loc, HStringView fmt, fmt::format_args args) {
 		return fmt::vformat_to(out, fmt, args, &loc);
 	}
+#endif
 
 	//====================> format_to_n <=======================
 
@@ -1768,6 +2763,7 @@ namespace hana
 		return fmt::vformat_to_n(out, n, fmt, args);
 	}
 
+#ifndef HANA_FMT_NO_LOCALE
 	template<std::output_iterator<const char8_t&> OutputIt, typename... T>
 	fmt::format_to_n_result<OutputIt> format_to_n(OutputIt out, size_t n, const std::locale& loc, fmt::format_string<T...> fmt, T&&... args) {
 		constexpr auto DESC = fmt::make_descriptor<T...>();
@@ -1784,13 +2780,14 @@ namespace hana
 	inline fmt::format_to_n_result<char8_t*> vformat_to_n(char8_t* out, size_t n, const std::locale& loc, HStringView fmt, fmt::format_args args) {
 		return fmt::vformat_to_n(out, n, fmt, args, &loc);
 	}
+#endif
 
 	//===============> format_to fixed array <==================
 
 	template<size_t N, typename... T>
 	fmt::format_to_result format_to(char8_t (&out)[N], fmt::format_string<T...> fmt, T&&... args) {
 		constexpr auto DESC = fmt::make_descriptor<T...>();
-		return hana::vformat_to(out, fmt.get(), fmt::format_args(fmt::make_format_store(args...), DESC));
+		return hana::vformat_to<N>(out, fmt.get(), fmt::format_args(fmt::make_format_store(args...), DESC));
 	}
 
 	template<size_t N>
@@ -1799,17 +2796,19 @@ namespace hana
 		return {result.out, result.size > N};
 	}
 
+#ifndef HANA_FMT_NO_LOCALE
 	template<size_t N, typename... T>
 	fmt::format_to_result format_to(char8_t (&out)[N], const std::locale& loc, fmt::format_string<T...> fmt, T&&... args) {
 		constexpr auto DESC = fmt::make_descriptor<T...>();
-		return hana::vformat_to(out, loc, fmt.get(), fmt::format_args(fmt::make_format_store(args...), DESC));
+		return hana::vformat_to<N>(out, loc, fmt.get(), fmt::format_args(fmt::make_format_store(args...), DESC));
 	}
 
 	template<size_t N>
 	fmt::format_to_result vformat_to(char8_t (&out)[N], const std::locale& loc, HStringView fmt, fmt::format_args args) {
-		auto result = hana::vformat_to_n(out, N, fmt, args, &loc);
+		auto result = hana::vformat_to_n(out, N, loc, fmt, args);
 		return {result.out, result.size > N};
 	}
+#endif
 
 	//===================> formatted_size <=====================
 
@@ -1823,6 +2822,7 @@ namespace hana
 		return fmt::vformatted_size(fmt, args);
 	}
 
+#ifndef HANA_FMT_NO_LOCALE
 	template<typename... T>
 	size_t formatted_size(const std::locale& loc, fmt::format_string<T...> fmt, T&&... args) {
 		constexpr auto DESC = fmt::make_descriptor<T...>();
@@ -1832,6 +2832,7 @@ namespace hana
 	inline size_t vformatted_size(const std::locale& loc, HStringView fmt, fmt::format_args args) {
 		return fmt::vformatted_size(fmt, args, &loc);
 	}
+#endif
 
 	//=======================> format <=========================
 
@@ -1845,6 +2846,7 @@ namespace hana
 		return hana::vformat(fmt.get(), fmt::format_args(fmt::make_format_store(args...), DESC));
 	}
 
+#ifndef HANA_FMT_NO_LOCALE
 	inline HString vformat(const std::locale& loc, HStringView fmt, fmt::format_args args) {
 		return fmt::vformat(fmt, args, &loc);
 	}
@@ -1854,4 +2856,29 @@ namespace hana
 		constexpr auto DESC = fmt::make_descriptor<T...>();
 		return hana::vformat(loc, fmt.get(), fmt::format_args(fmt::make_format_store(args...), DESC));
 	}
+#endif
+
+	//===================> format_scratch <=====================
+
+	template<typename... T>
+	HStringView format_scratch(fmt::format_string<T...> fmt, T&&... args) {
+		constexpr auto DESC = fmt::make_descriptor<T...>();
+		return hana::vformat_scratch(fmt.get(), fmt::format_args(fmt::make_format_store(args...), DESC));
+	}
+
+	inline HStringView vformat_scratch(HStringView fmt, fmt::format_args args) {
+		return fmt::vformat_scratch(fmt, args);
+	}
+
+#ifndef HANA_FMT_NO_LOCALE
+	template<typename... T>
+	HStringView format_scratch(const std::locale& loc, fmt::format_string<T...> fmt, T&&... args) {
+		constexpr auto DESC = fmt::make_descriptor<T...>();
+		return hana::vformat_scratch(loc, fmt.get(), fmt::format_args(fmt::make_format_store(args...), DESC));
+	}
+
+	inline HStringView vformat_scratch(const std::locale& loc, HStringView fmt, fmt::format_args args) {
+		return fmt::vformat_scratch(fmt, args, &loc);
+	}
+#endif
 }
@@ -0,0 +1,436 @@
+#pragma once
+
+#include "hana/platform/macros.h"
+#include "hana/container/string.hpp"
+
+#include <concepts>
+
+namespace hana::internal
+{
+	inline constexpr char8_t digit_pairs[] =
+			u8"00010203040506070809"
+			"10111213141516171819"
+			"20212223242526272829"
+			"30313233343536373839"
+			"40414243444546474849"
+			"50515253545556575859"
+			"60616263646566676869"
+			"70717273747576777879"
+			"80818283848586878889"
+			"90919293949596979899";
+
+	//! writes the lowest `width` decimal digits of value to out, zero padded, two digits per step
+	template<std::unsigned_integral T>
+	constexpr void write_digits(char8_t* out, size_t width, T value) noexcept {
+		while (width >= 2) {
+			const size_t pair = static_cast<size_t>(value % 100) * 2;
+			value /= 100;
+			width -= 2;
+			out[width] = digit_pairs[pair];
+			out[width + 1] = digit_pairs[pair + 1];
+		}
+		if (width) {
+			out[0] = static_cast<char8_t>(u8'0' + value % 10);
+		}
+	}
+
+	template<std::unsigned_integral T>
+	constexpr size_t count_digits(T value) noexcept {
+		size_t count = 1;
+		while (value >= 10) {
+			value /= 10;
+			++count;
+		}
+		return count;
+	}
+}
+
+namespace hana
+{
+	/*!
+	 * @brief UTF-8 text of at most N code units stored inline, it never allocates.
+	 *
+	 * Meant for short text on hot paths: thread names, log fields, GUIDs, numbers rendered in place. The buffer is always
+	 * null terminated and the type is trivially copyable, so copies are a memcpy and it can live in constant expressions.
+	 * Text that does not fit is cut at the last code point boundary before the capacity, size() tells how much was kept.
+	 *
+	 * Searches and trims go through HStringView; str() and the HStringView constructor convert to and from HString.
+	 */
+	template<size_t N>
+	class HFixedString {
+	public:
+		//==================> aligns <==================
+
+		using value_type = char8_t;
+		using pointer = value_type*;
+		using const_pointer = const value_type*;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+
+		using raw_value_type = char;
+		using raw_const_pointer = const raw_value_type*;
+
+		using size_type = size_t;
+		using const_data_reference = HStringView::const_data_reference;
+
+		static constexpr size_type Capacity = N;
+		static constexpr size_type npos = HStringView::npos;
+
+		static_assert(N > 0, "HFixedString needs room for at least one code unit");
+
+		//==================> ctor & dtor <==================
+
+		constexpr HFixedString() noexcept = default;
+		constexpr HFixedString(const_pointer str) noexcept;
+		constexpr HFixedString(HStringView view) noexcept;
+
+		//==================> assign <==================
+
+		constexpr HFixedString& assign(HStringView view) noexcept;
+		constexpr HFixedString& operator=(HStringView view) noexcept;
+		constexpr HFixedString& operator=(const_pointer str) noexcept;
+
+		//==================> compare <==================
+
+		constexpr bool operator==(HStringView rhs) const noexcept;
+		template<size_t M> constexpr bool operator==(const HFixedString<M>& rhs) const noexcept;
+		template<size_t Size> bool operator==(const BasicHString<Size>& rhs) const noexcept;
+		constexpr std::strong_ordering operator<=>(HStringView rhs) const noexcept;
+		template<size_t M> constexpr std::strong_ordering operator<=>(const HFixedString<M>& rhs) const noexcept;
+		template<size_t Size> std::strong_ordering operator<=>(const BasicHString<Size>& rhs) const noexcept;
+
+		//==================> iterator <==================
+
+		constexpr pointer begin() noexcept;
+		constexpr const_pointer begin() const noexcept;
+		constexpr pointer end() noexcept;
+		constexpr const_pointer end() const noexcept;
+
+		//==================> size <==================
+
+		constexpr bool empty() const noexcept;
+		constexpr size_type size() const noexcept;
+		constexpr size_type length() const noexcept;
+		constexpr size_type text_length() const noexcept;
+		constexpr size_type slack() const noexcept;
+		static constexpr size_type capacity() noexcept;
+		static constexpr size_type max_size() noexcept;
+
+		//==================> data access <==================
+
+		constexpr reference operator[](size_type pos);
+		constexpr const_reference operator[](size_type pos) const;
+		constexpr reference front();
+		constexpr const_reference front() const;
+		constexpr reference back();
+		constexpr const_reference back() const;
+		constexpr pointer data() noexcept;
+		constexpr const_pointer data() const noexcept;
+		constexpr const_pointer c_str() const noexcept;
+		raw_const_pointer raw_data() const noexcept;
+
+		//==================> view & convert <==================
+
+		constexpr operator HStringView() const noexcept;
+		constexpr HStringView view() const noexcept;
+		constexpr HStringView first_view(size_type count) const;
+		constexpr HStringView last_view(size_type count) const;
+		constexpr HStringView subview(size_type pos = 0, size_type count = npos) const;
+		HString str() const;
+
+		//==================> modify <==================
+
+		// appends keep what fits, see the class note
+		constexpr HFixedString& append(HStringView view) noexcept;
+		constexpr HFixedString& append(unicode::UTF8Seq seq) noexcept;
+		constexpr HFixedString& append(size_type count, value_type ch) noexcept;
+		constexpr HFixedString& operator+=(HStringView view) noexcept;
+		constexpr void push_back(value_type ch) noexcept;
+
+		//! decimal text of value, nothing is appended when it does not fit
+		template<std::integral T> constexpr HFixedString& append_integer(T value) noexcept;
+		//! the lowest width digits of an unsigned value, zero padded, like the fixed width fields of a timestamp
+		template<std::unsigned_integral T> constexpr HFixedString& append_integer(T value, size_type width) noexcept;
+
+		constexpr void resize(size_type count, value_type ch = u8'\0') noexcept;
+		constexpr void clear() noexcept;
+
+		//==================> search <==================
+
+		constexpr bool starts_with(HStringView sv) const noexcept;
+		constexpr bool starts_with(value_type ch) const noexcept;
+		constexpr bool ends_with(HStringView sv) const noexcept;
+		constexpr bool ends_with(value_type ch) const noexcept;
+		constexpr bool contains(HStringView sv) const noexcept;
+		constexpr bool contains(value_type ch) const noexcept;
+		constexpr size_type count(HStringView pattern) const;
+
+		constexpr const_data_reference find(HStringView v, size_type pos = 0) const noexcept;
+		constexpr const_data_reference find(value_type ch, size_type pos = 0) const noexcept;
+		constexpr const_data_reference find_first_of(HStringView v, size_type pos = 0) const noexcept;
+		constexpr const_data_reference find_first_not_of(HStringView v, size_type pos = 0) const noexcept;
+		constexpr const_data_reference rfind(HStringView v, size_type pos = npos) const noexcept;
+		constexpr const_data_reference rfind(value_type ch, size_type pos = npos) const noexcept;
+		constexpr const_data_reference find_last_of(HStringView v, size_type pos = npos) const noexcept;
+		constexpr const_data_reference find_last_not_of(HStringView v, size_type pos = npos) const noexcept;
+
+		constexpr std::array<HStringView, 3> partition(HStringView delimiter) const;
+
+		//==================> trim <==================
+
+		constexpr HFixedString& trim(HStringView characters = u8" \t") noexcept;
+		constexpr HFixedString& trim_start(HStringView characters = u8" \t") noexcept;
+		constexpr HFixedString& trim_end(HStringView characters = u8" \t") noexcept;
+
+		constexpr HFixedString Trim(HStringView characters = u8" \t") const noexcept;
+		constexpr HFixedString TrimStart(HStringView characters = u8" \t") const noexcept;
+		constexpr HFixedString TrimEnd(HStringView characters = u8" \t") const noexcept;
+
+	private:
+		using stored_size_type = std::conditional_t<(N <= UINT8_MAX), uint8_t, std::conditional_t<(N <= UINT16_MAX), uint16_t, size_type>>;
+
+		// code units of [str, str + count) that fit behind the current text without splitting a sequence
+		constexpr size_type fit(const_pointer str, size_type count) const noexcept;
+		constexpr void set_size(size_type value) noexcept;
+
+		value_type data_[N + 1] = {};
+		stored_size_type size_ = 0;
+	};
+
+	template<typename T>
+	struct Hash;
+
+	// hashes like StringHash; declared here so it wins over the std::hash fallback, defined in hash.hpp
+	template<size_t N>
+	struct Hash<HFixedString<N>> {
+		using is_transparent = void;
+
+		template<typename T>
+		constexpr size_t operator()(const T& value) const noexcept;
+	};
+}
+
+// ctor & assign
+namespace hana
+{
+	template<size_t N> constexpr HFixedString<N>::HFixedString(const_pointer str) noexcept { assign(HStringView{str}); }
+
+	template<size_t N> constexpr HFixedString<N>::HFixedString(HStringView view) noexcept { assign(view); }
+
+	template<size_t N>
+	constexpr HFixedString<N>& HFixedString<N>::assign(HStringView view) noexcept {
+		clear();
+		return append(view);
+	}
+
+	template<size_t N> constexpr HFixedString<N>& HFixedString<N>::operator=(HStringView view) noexcept { return assign(view); }
+
+	template<size_t N> constexpr HFixedString<N>& HFixedString<N>::operator=(const_pointer str) noexcept { return assign(HStringView{str}); }
+}
+
+// compare
+namespace hana
+{
+	template<size_t N> constexpr bool HFixedString<N>::operator==(HStringView rhs) const noexcept { return view() == rhs; }
+	template<size_t N> template<size_t M> constexpr bool HFixedString<N>::operator==(const HFixedString<M>& rhs) const noexcept { return view() == rhs.view(); }
+	template<size_t N> template<size_t Size> bool HFixedString<N>::operator==(const BasicHString<Size>& rhs) const noexcept { return view() == HStringView{rhs}; }
+	template<size_t N> constexpr std::strong_ordering HFixedString<N>::operator<=>(HStringView rhs) const noexcept { return view() <=> rhs; }
+	template<size_t N> template<size_t M> constexpr std::strong_ordering HFixedString<N>::operator<=>(const HFixedString<M>& rhs) const noexcept { return view() <=> rhs.view(); }
+	template<size_t N> template<size_t Size> std::strong_ordering HFixedString<N>::operator<=>(const BasicHString<Size>& rhs) const noexcept { return view() <=> HStringView{rhs}; }
+}
+
+// iterator & size
+namespace hana
+{
+	template<size_t N> constexpr typename HFixedString<N>::pointer HFixedString<N>::begin() noexcept { return data_; }
+	template<size_t N> constexpr typename HFixedString<N>::const_pointer HFixedString<N>::begin() const noexcept { return data_; }
+	template<size_t N> constexpr typename HFixedString<N>::pointer HFixedString<N>::end() noexcept { return data_ + size_; }
+	template<size_t N> constexpr typename HFixedString<N>::const_pointer HFixedString<N>::end() const noexcept { return data_ + size_; }
+
+	template<size_t N> constexpr bool HFixedString<N>::empty() const noexcept { return size_ == 0; }
+	template<size_t N> constexpr typename HFixedString<N>::size_type HFixedString<N>::size() const noexcept { return size_; }
+	template<size_t N> constexpr typename HFixedString<N>::size_type HFixedString<N>::length() const noexcept { return size_; }
+	template<size_t N> constexpr typename HFixedString<N>::size_type HFixedString<N>::text_length() const noexcept { return view().text_length(); }
+	template<size_t N> constexpr typename HFixedString<N>::size_type HFixedString<N>::slack() const noexcept { return N - size_; }
+	template<size_t N> constexpr typename HFixedString<N>::size_type HFixedString<N>::capacity() noexcept { return N; }
+	template<size_t N> constexpr typename HFixedString<N>::size_type HFixedString<N>::max_size() noexcept { return N; }
+}
+
+// data access
+namespace hana
+{
+	template<size_t N>
+	constexpr typename HFixedString<N>::reference HFixedString<N>::operator[](size_type pos) {
+		assert(pos < size() && "undefined behavior accessing out of bounds");
+		return data_[pos];
+	}
+
+	template<size_t N>
+	constexpr typename HFixedString<N>::const_reference HFixedString<N>::operator[](size_type pos) const {
+		assert(pos < size() && "undefined behavior accessing out of bounds");
+		return data_[pos];
+	}
+
+	template<size_t N> constexpr typename HFixedString<N>::reference HFixedString<N>::front() { return (*this)[0]; }
+	template<size_t N> constexpr typename HFixedString<N>::const_reference HFixedString<N>::front() const { return (*this)[0]; }
+	template<size_t N> constexpr typename HFixedString<N>::reference HFixedString<N>::back() { return (*this)[size() - 1]; }
+	template<size_t N> constexpr typename HFixedString<N>::const_reference HFixedString<N>::back() const { return (*this)[size() - 1]; }
+
+	template<size_t N> constexpr typename HFixedString<N>::pointer HFixedString<N>::data() noexcept { return data_; }
+	template<size_t N> constexpr typename HFixedString<N>::const_pointer HFixedString<N>::data() const noexcept { return data_; }
+	template<size_t N> constexpr typename HFixedString<N>::const_pointer HFixedString<N>::c_str() const noexcept { return data_; }
+	template<size_t N> HFixedString<N>::raw_const_pointer HFixedString<N>::raw_data() const noexcept { return reinterpret_cast<raw_const_pointer>(data_); }
+}
+
+// view & convert
+namespace hana
+{
+	template<size_t N> constexpr HFixedString<N>::operator HStringView() const noexcept { return view(); }
+	template<size_t N> constexpr HStringView HFixedString<N>::view() const noexcept { return {data_, size_}; }
+	template<size_t N> constexpr HStringView HFixedString<N>::first_view(size_type count) const { return view().first_view(count); }
+	template<size_t N> constexpr HStringView HFixedString<N>::last_view(size_type count) const { return view().last_view(count); }
+	template<size_t N> constexpr HStringView HFixedString<N>::subview(size_type pos, size_type count) const { return view().subview(pos, count); }
+	template<size_t N> HString HFixedString<N>::str() const { return HString{view()}; }
+}
+
+// modify
+namespace hana
+{
+	template<size_t N>
+	constexpr HFixedString<N>& HFixedString<N>::append(HStringView view) noexcept {
+		const size_type count = fit(view.data(), view.size());
+		std::copy_n(view.data(), count, data_ + size_);
+		set_size(size_ + count);
+		return *this;
+	}
+
+	template<size_t N>
+	constexpr HFixedString<N>& HFixedString<N>::append(unicode::UTF8Seq seq) noexcept {
+		if (seq.is_valid() && seq.len <= slack()) {
+			return append(HStringView(seq.data, seq.len));
+		}
+		return *this;
+	}
+
+	template<size_t N>
+	constexpr HFixedString<N>& HFixedString<N>::append(size_type count, value_type ch) noexcept {
+		count = std::min(count, slack());
+		std::fill_n(data_ + size_, count, ch);
+		set_size(size_ + count);
+		return *this;
+	}
+
+	template<size_t N> constexpr HFixedString<N>& HFixedString<N>::operator+=(HStringView view) noexcept { return append(view); }
+
+	template<size_t N> constexpr void HFixedString<N>::push_back(value_type ch) noexcept { append(1, ch); }
+
+	template<size_t N>
+	template<std::integral T>
+	constexpr HFixedString<N>& HFixedString<N>::append_integer(T value) noexcept {
+		using U = std::make_unsigned_t<T>;
+		const bool negative = value < 0;
+		const U magnitude = negative ? static_cast<U>(U{0} - static_cast<U>(value)) : static_cast<U>(value);
+		const size_type digits = internal::count_digits(magnitude);
+		if (digits + negative > slack()) {
+			return *this;
+		}
+		if (negative) {
+			data_[size_] = u8'-';
+		}
+		internal::write_digits(data_ + size_ + negative, digits, magnitude);
+		set_size(size_ + negative + digits);
+		return *this;
+	}
+
+	template<size_t N>
+	template<std::unsigned_integral T>
+	constexpr HFixedString<N>& HFixedString<N>::append_integer(T value, size_type width) noexcept {
+		if (width > slack()) {
+			return *this;
+		}
+		internal::write_digits(data_ + size_, width, value);
+		set_size(size_ + width);
+		return *this;
+	}
+
+	template<size_t N>
+	constexpr void HFixedString<N>::resize(size_type count, value_type ch) noexcept {
+		if (count > size_) {
+			append(count - size_, ch);
+		} else {
+			set_size(count);
+		}
+	}
+
+	template<size_t N> constexpr void HFixedString<N>::clear() noexcept { set_size(0); }
+
+	template<size_t N>
+	constexpr typename HFixedString<N>::size_type HFixedString<N>::fit(const_pointer str, size_type count) const noexcept {
+		const size_type room = slack();
+		if (count <= room) {
+			return count;
+		}
+		// step back over at most 3 continuation bytes to the start of the sequence being cut
+		size_type boundary = room;
+		while (boundary + 3 > room && boundary > 0 && (str[boundary] & 0xC0) == 0x80) {
+			--boundary;
+		}
+		return (str[boundary] & 0xC0) != 0x80 ? boundary : room;
+	}
+
+	template<size_t N>
+	constexpr void HFixedString<N>::set_size(size_type value) noexcept {
+		size_ = static_cast<stored_size_type>(value);
+		data_[value] = u8'\0';
+	}
+}
+
+// search
+namespace hana
+{
+	template<size_t N> constexpr bool HFixedString<N>::starts_with(HStringView sv) const noexcept { return view().starts_with(sv); }
+	template<size_t N> constexpr bool HFixedString<N>::starts_with(value_type ch) const noexcept { return view().starts_with(ch); }
+	template<size_t N> constexpr bool HFixedString<N>::ends_with(HStringView sv) const noexcept { return view().ends_with(sv); }
+	template<size_t N> constexpr bool HFixedString<N>::ends_with(value_type ch) const noexcept { return view().ends_with(ch); }
+	template<size_t N> constexpr bool HFixedString<N>::contains(HStringView sv) const noexcept { return view().contains(sv); }
+	template<size_t N> constexpr bool HFixedString<N>::contains(value_type ch) const noexcept { return view().contains(ch); }
+	template<size_t N> constexpr typename HFixedString<N>::size_type HFixedString<N>::count(HStringView pattern) const { return view().count(pattern); }
+
+	template<size_t N> constexpr typename HFixedString<N>::const_data_reference HFixedString<N>::find(HStringView v, size_type pos) const noexcept { return view().find(v, pos); }
+	template<size_t N> constexpr typename HFixedString<N>::const_data_reference HFixedString<N>::find(value_type ch, size_type pos) const noexcept { return view().find(ch, pos); }
+	template<size_t N> constexpr typename HFixedString<N>::const_data_reference HFixedString<N>::find_first_of(HStringView v, size_type pos) const noexcept { return view().find_first_of(v, pos); }
+	template<size_t N> constexpr typename HFixedString<N>::const_data_reference HFixedString<N>::find_first_not_of(HStringView v, size_type pos) const noexcept { return view().find_first_not_of(v, pos); }
+	template<size_t N> constexpr typename HFixedString<N>::const_data_reference HFixedString<N>::rfind(HStringView v, size_type pos) const noexcept { return view().rfind(v, pos); }
+	template<size_t N> constexpr typename HFixedString<N>::const_data_reference HFixedString<N>::rfind(value_type ch, size_type pos) const noexcept { return view().rfind(ch, pos); }
+	template<size_t N> constexpr typename HFixedString<N>::const_data_reference HFixedString<N>::find_last_of(HStringView v, size_type pos) const noexcept { return view().find_last_of(v, pos); }
+	template<size_t N> constexpr typename HFixedString<N>::const_data_reference HFixedString<N>::find_last_not_of(HStringView v, size_type pos) const noexcept { return view().find_last_not_of(v, pos); }
+
+	template<size_t N> constexpr std::array<HStringView, 3> HFixedString<N>::partition(HStringView delimiter) const { return view().partition(delimiter); }
+}
+
+// trim
+namespace hana
+{
+	template<size_t N>
+	constexpr HFixedString<N>& HFixedString<N>::trim(HStringView characters) noexcept {
+		return trim_end(characters).trim_start(characters);
+	}
+
+	template<size_t N>
+	constexpr HFixedString<N>& HFixedString<N>::trim_start(HStringView characters) noexcept {
+		const HStringView kept = view().trim_start(characters);
+		std::copy_n(kept.data(), kept.size(), data_);
+		set_size(kept.size());
+		return *this;
+	}
+
+	template<size_t N>
+	constexpr HFixedString<N>& HFixedString<N>::trim_end(HStringView characters) noexcept {
+		set_size(view().trim_end(characters).size());
+		return *this;
+	}
+
+	template<size_t N> constexpr HFixedString<N> HFixedString<N>::Trim(HStringView characters) const noexcept { return HFixedString{view().trim(characters)}; }
+	template<size_t N> constexpr HFixedString<N> HFixedString<N>::TrimStart(HStringView characters) const noexcept { return HFixedString{view().trim_start(characters)}; }
+	template<size_t N> constexpr HFixedString<N> HFixedString<N>::TrimEnd(HStringView characters) const noexcept { return HFixedString{view().trim_end(characters)}; }
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "hana/platform/macros.h"
+#include "hana/container/string_view.hpp"
+#include "hana/utility/hash.hpp"
+
+namespace hana
+{
+	namespace internal
+	{
+		//! interned text, the characters and a terminator follow the entry
+		struct NameEntry {
+			uint64_t hash;
+			uint32_t size;
+
+			const char8_t* data() const noexcept { return reinterpret_cast<const char8_t*>(this + 1); }
+		};
+
+		HANA_BASE_API const NameEntry* name_entry(uint32_t id) noexcept;
+	}
+
+	/*!
+	 * @brief 4-byte handle to a string interned in the global name pool.
+	 *
+	 * Equal text always yields the same handle, so comparison is an integer compare and the xxh3 hash of the text is
+	 * computed once, when the text is first interned. The pool is sharded for concurrent interning and keeps the
+	 * characters in an arena that lives until the process exits; handles are cheap to copy and never dangle.
+	 *
+	 * Meant for identifiers that are looked up over and over (module names, subsystem ids), not for arbitrary text:
+	 * interned strings are never released.
+	 */
+	class HName {
+	public:
+		using size_type = size_t;
+
+		//==================> ctor <==================
+
+		//! the empty name, does not touch the pool
+		constexpr HName() noexcept = default;
+		HANA_BASE_API explicit HName(HStringView text);
+		explicit HName(const char8_t* text);
+
+		//! looks the text up without interning it
+		//! @return the handle of text or the empty name if text was never interned
+		HANA_BASE_API static HName find(HStringView text) noexcept;
+
+		//==================> compare <==================
+
+		constexpr bool operator==(const HName& rhs) const noexcept = default;
+		bool operator==(HStringView rhs) const noexcept;
+
+		//==================> access <==================
+
+		constexpr uint32_t id() const noexcept;
+		constexpr bool empty() const noexcept;
+		size_type size() const noexcept;
+		const char8_t* c_str() const noexcept;
+		HStringView view() const noexcept;
+		operator HStringView() const noexcept;
+
+		//! xxh3 hash of the text, XXHash::xxhash64 of view()
+		uint64_t hash() const noexcept;
+
+	private:
+		uint32_t id_ = 0;
+	};
+}
+
+template<>
+struct std::hash<hana::HName> {
+	size_t operator()(const hana::HName& name) const noexcept {
+		return static_cast<size_t>(name.hash());
+	}
+};
+
+namespace hana
+{
+	inline HName::HName(const char8_t* text): HName(HStringView{text}) {}
+
+	inline bool HName::operator==(HStringView rhs) const noexcept { return view() == rhs; }
+
+	constexpr uint32_t HName::id() const noexcept { return id_; }
+	constexpr bool HName::empty() const noexcept { return id_ == 0; }
+	inline HName::size_type HName::size() const noexcept { return internal::name_entry(id_)->size; }
+	inline const char8_t* HName::c_str() const noexcept { return internal::name_entry(id_)->data(); }
+
+	inline HStringView HName::view() const noexcept {
+		const auto* entry = internal::name_entry(id_);
+		return {entry->data(), entry->size};
+	}
+
+	inline HName::operator HStringView() const noexcept { return view(); }
+	inline uint64_t HName::hash() const noexcept { return internal::name_entry(id_)->hash; }
+}
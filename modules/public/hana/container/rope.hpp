@@ -0,0 +1,127 @@
+#pragma once
+
+#include "hana/platform/macros.h"
+#include "hana/container/string.hpp"
+
+#include <memory>
+
+namespace hana
+{
+	/*!
+	 * @brief UTF-8 text stored as HString leaves of a balanced tree, for large documents edited in place.
+	 *
+	 * HString::insert and erase move the whole tail, so building a document from many edits is quadratic. HRope splits and
+	 * joins subtrees instead: insert, erase, replace and split cost O(log n) plus the size of the inserted text. Every node
+	 * caches the code units and code points below it, so byte and code point indices convert in O(log n) as well.
+	 *
+	 * Text added through the rope is cut into leaves of at most LeafSize code units on code point boundaries and adjacent
+	 * small leaves are merged, so a sequence never spans two leaves as long as edits happen on code point boundaries.
+	 * str() and flatten() produce contiguous text on demand; flatten() keeps the tree and caches the copy until the next edit.
+	 */
+	class HANA_BASE_API HRope {
+	public:
+		//==================> aligns <==================
+
+		using value_type = char8_t;
+		using size_type = size_t;
+
+		static constexpr size_type npos = HStringView::npos;
+		static constexpr size_type LeafSize = 1024;
+
+		//==================> ctor & dtor <==================
+
+		HRope() noexcept;
+		HRope(HStringView view);
+		HRope(const HRope& other);
+		HRope(HRope&& other) noexcept;
+		~HRope() noexcept;
+
+		HRope& operator=(const HRope& rhs);
+		HRope& operator=(HRope&& rhs) noexcept;
+
+		//==================> compare <==================
+
+		bool operator==(HStringView rhs) const noexcept;
+		bool operator==(const HRope& rhs) const;
+
+		//==================> size & data access <==================
+
+		bool empty() const noexcept;
+		size_type size() const noexcept;
+		size_type text_length() const noexcept;
+
+		value_type at(size_type index) const;
+		value_type operator[](size_type index) const;
+		unicode::UTF8Seq at_text(size_type index) const;
+		size_type buffer_index_to_text(size_type index) const noexcept;
+		size_type text_index_to_buffer(size_type index) const noexcept;
+
+		//! visits the leaves in order as HStringView
+		template<typename F> void for_each_chunk(F&& func) const;
+
+		//==================> modify <==================
+
+		HRope& append(HStringView view);
+		HRope& append(HRope&& rope);
+		HRope& insert(size_type index, HStringView view);
+		HRope& insert(size_type index, HRope&& rope);
+		HRope& erase(size_type index, size_type count = npos);
+		HRope& replace(size_type pos, size_type count, HStringView view);
+		HRope& clear() noexcept;
+
+		//! keeps [0, index) and returns [index, size())
+		HRope split(size_type index);
+
+		//==================> flatten <==================
+
+		HString str() const;
+		//! contiguous copy of the text cached beside the tree, the view stays valid until the next modification
+		HStringView flatten();
+
+	private:
+		friend struct RopeHelper;
+
+		struct Node {
+			std::unique_ptr<Node> left;
+			std::unique_ptr<Node> right;
+			// leaves only
+			HString text;
+			size_type size = 0;
+			size_type length = 0;
+			uint8_t height = 0;
+
+			bool is_leaf() const noexcept { return !left; }
+		};
+
+		template<typename F> static void visit(const Node* node, F& func);
+
+		//! drops the flatten() cache, called by every modification
+		void invalidate() noexcept;
+
+		std::unique_ptr<Node> root_;
+		HString flat_;
+		bool flat_valid_ = false;
+	};
+}
+
+namespace hana
+{
+	inline HRope::value_type HRope::operator[](size_type index) const { return at(index); }
+
+	template<typename F>
+	void HRope::for_each_chunk(F&& func) const {
+		if (root_) {
+			visit(root_.get(), func);
+		}
+	}
+
+	template<typename F>
+	void HRope::visit(const Node* node, F& func) {
+		if (node->is_leaf()) {
+			func(HStringView{node->text});
+		} else {
+			visit(node->left.get(), func);
+			visit(node->right.get(), func);
+		}
+	}
+}
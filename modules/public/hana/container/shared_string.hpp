@@ -0,0 +1,236 @@
+#pragma once
+
+#include "hana/platform/macros.h"
+#include "hana/container/string.hpp"
+#include "hana/utility/hash.hpp"
+
+#include <atomic>
+
+namespace hana
+{
+	/*!
+	 * @brief String whose heap buffer is shared between copies (copy-on-write).
+	 *
+	 * The characters follow a header that holds an atomic reference count, so a copy only bumps the counter and the last
+	 * owner frees the buffer. Members that modify the text unshare first: a buffer with other owners is copied before the
+	 * write, so every copy still behaves as an independent value.
+	 *
+	 * Meant for large, mostly immutable text handed to many owners (module metadata, config blobs); short or frequently
+	 * edited text is better kept in HString, whose SSO copies never allocate.
+	 */
+	class HSharedString {
+	public:
+		//==================> aligns <==================
+
+		using value_type = char8_t;
+		using pointer = value_type*;
+		using const_pointer = const value_type*;
+		using const_reference = const value_type&;
+		using size_type = size_t;
+		using traits_type = std::char_traits<char8_t>;
+
+		static constexpr size_type npos = HStringView::npos;
+
+		//==================> ctor & dtor <==================
+
+		HSharedString() noexcept = default;
+		HANA_BASE_API HSharedString(HStringView view);
+		HSharedString(const char8_t* str);
+		HSharedString(const HString& str);
+		HSharedString(const HSharedString& other) noexcept;
+		HSharedString(HSharedString&& other) noexcept;
+		~HSharedString() noexcept;
+
+		//==================> assign <==================
+
+		HSharedString& operator=(const HSharedString& rhs) noexcept;
+		HSharedString& operator=(HSharedString&& rhs) noexcept;
+		HSharedString& operator=(HStringView view);
+
+		//==================> compare <==================
+
+		bool operator==(HStringView rhs) const noexcept;
+		bool operator==(const HSharedString& rhs) const noexcept;
+		std::strong_ordering operator<=>(HStringView rhs) const noexcept;
+		std::strong_ordering operator<=>(const HSharedString& rhs) const noexcept;
+
+		//==================> size & data access <==================
+
+		bool empty() const noexcept;
+		size_type size() const noexcept;
+		size_type capacity() const noexcept;
+
+		const_pointer data() const noexcept;
+		const_pointer c_str() const noexcept;
+		const_reference operator[](size_type pos) const;
+		const_pointer begin() const noexcept;
+		const_pointer end() const noexcept;
+
+		operator HStringView() const noexcept;
+		HStringView view() const noexcept;
+		HString str() const;
+
+		//==================> sharing <==================
+
+		//! @return owners of the buffer, 0 for an empty string that never allocated
+		uint32_t use_count() const noexcept;
+		bool is_unique() const noexcept;
+
+		//==================> modify <==================
+
+		/*!
+		 * @brief Unshares the buffer and returns it for writes within size().
+		 *
+		 * Like a COW std::string, the pointer is only exclusive until the next copy: a copy made afterwards shares the
+		 * buffer again and sees every later write through it. Prefer resize_and_overwrite, whose pointer can't outlive
+		 * the call.
+		 */
+		HANA_BASE_API pointer mutable_data();
+		/*!
+		 * @brief Unshares the buffer, grows it to count code units and lets op write the content in place.
+		 * @param op called as op(buffer, count), returns the final size (<= count); [0, min(size(), count)) keeps the
+		 * old content, and the buffer must not be used after op returns
+		 */
+		template<typename Op> void resize_and_overwrite(size_type count, Op op);
+		HANA_BASE_API HSharedString& assign(HStringView view);
+		HANA_BASE_API HSharedString& append(HStringView view);
+		HANA_BASE_API void clear() noexcept;
+
+	private:
+		struct Header {
+			std::atomic<uint32_t> counter;
+			size_type size;
+			size_type capacity;
+		};
+
+		pointer chars() const noexcept { return reinterpret_cast<pointer>(header_ + 1); }
+		void add_ref() const noexcept;
+		void release() noexcept;
+
+		// makes the buffer unique with room for capacity code units, keeping the text
+		HANA_BASE_API pointer unshare(size_type capacity);
+		HANA_BASE_API static Header* allocate(size_type capacity);
+		HANA_BASE_API static void deallocate(Header* header) noexcept;
+
+		Header* header_ = nullptr;
+	};
+
+	template<>
+	struct Hash<HSharedString> : StringHash {};
+}
+
+// ctor & dtor
+namespace hana
+{
+	inline HSharedString::HSharedString(const char8_t* str): HSharedString(HStringView{str}) {}
+	inline HSharedString::HSharedString(const HString& str): HSharedString(HStringView{str}) {}
+
+	inline HSharedString::HSharedString(const HSharedString& other) noexcept: header_(other.header_) {
+		add_ref();
+	}
+
+	inline HSharedString::HSharedString(HSharedString&& other) noexcept: header_(other.header_) {
+		other.header_ = nullptr;
+	}
+
+	inline HSharedString::~HSharedString() noexcept {
+		release();
+	}
+}
+
+// assign
+namespace hana
+{
+	inline HSharedString& HSharedString::operator=(const HSharedString& rhs) noexcept {
+		Header* header = rhs.header_;
+		rhs.add_ref();
+		release();
+		header_ = header;
+		return *this;
+	}
+
+	inline HSharedString& HSharedString::operator=(HSharedString&& rhs) noexcept {
+		if (this != &rhs) {
+			release();
+			header_ = rhs.header_;
+			rhs.header_ = nullptr;
+		}
+		return *this;
+	}
+
+	inline HSharedString& HSharedString::operator=(HStringView view) {
+		return assign(view);
+	}
+}
+
+// compare
+namespace hana
+{
+	inline bool HSharedString::operator==(HStringView rhs) const noexcept { return view() == rhs; }
+	inline bool HSharedString::operator==(const HSharedString& rhs) const noexcept { return header_ == rhs.header_ || view() == rhs.view(); }
+	inline std::strong_ordering HSharedString::operator<=>(HStringView rhs) const noexcept { return view() <=> rhs; }
+	inline std::strong_ordering HSharedString::operator<=>(const HSharedString& rhs) const noexcept { return view() <=> rhs.view(); }
+}
+
+// size & data access
+namespace hana
+{
+	inline bool HSharedString::empty() const noexcept { return size() == 0; }
+	inline HSharedString::size_type HSharedString::size() const noexcept { return header_ ? header_->size : 0; }
+	inline HSharedString::size_type HSharedString::capacity() const noexcept { return header_ ? header_->capacity : 0; }
+
+	inline HSharedString::const_pointer HSharedString::data() const noexcept { return header_ ? chars() : u8""; }
+	inline HSharedString::const_pointer HSharedString::c_str() const noexcept { return data(); }
+
+	inline HSharedString::const_reference HSharedString::operator[](size_type pos) const {
+		assert(pos < size() && "undefined behavior accessing out of bounds");
+		return data()[pos];
+	}
+
+	inline HSharedString::const_pointer HSharedString::begin() const noexcept { return data(); }
+	inline HSharedString::const_pointer HSharedString::end() const noexcept { return data() + size(); }
+
+	inline HSharedString::operator HStringView() const noexcept { return view(); }
+	inline HStringView HSharedString::view() const noexcept { return {data(), size()}; }
+	inline HString HSharedString::str() const { return HString{view()}; }
+}
+
+// modify
+namespace hana
+{
+	template<typename Op>
+	void HSharedString::resize_and_overwrite(size_type count, Op op) {
+		pointer buffer = unshare(count);
+		const size_type new_size = std::move(op)(buffer, count);
+		assert(new_size <= count && "undefined behavior writing past count");
+		buffer[new_size] = 0;
+		header_->size = new_size;
+	}
+}
+
+// sharing
+namespace hana
+{
+	inline uint32_t HSharedString::use_count() const noexcept {
+		return header_ ? header_->counter.load(std::memory_order_relaxed) : 0;
+	}
+
+	inline bool HSharedString::is_unique() const noexcept {
+		// acquire pairs with the release in release(), so writes made by a former owner are visible before we mutate
+		return header_ && header_->counter.load(std::memory_order_acquire) == 1;
+	}
+
+	inline void HSharedString::add_ref() const noexcept {
+		if (header_) {
+			header_->counter.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	inline void HSharedString::release() noexcept {
+		if (header_ && header_->counter.fetch_sub(1, std::memory_order_release) == 1) {
+			std::atomic_thread_fence(std::memory_order_acquire);
+			deallocate(header_);
+		}
+		header_ = nullptr;
+	}
+}
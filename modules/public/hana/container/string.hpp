@@ -3,10 +3,87 @@
 #include "hana/platform/macros.h"
 #include "hana/container/string_view.hpp"
 
+#include <bit>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <memory_resource>
+
+namespace hana::fmt
+{
+	template<size_t SIZE, typename Allocator>
+	class memory_buffer;
+}
+
 namespace hana
 {
-	//! @note Strictly prohibit empty assignment
-	class HString {
+	namespace internal
+	{
+		//! heap part of BasicHString, sso_flag_ overlaps the padding after resource_
+		struct StringHeap {
+			static constexpr size_t max_capacity = std::numeric_limits<size_t>::max();
+
+			char8_t* data_;
+			size_t size_;
+			size_t capacity_;
+			// buffer comes from a memory_resource stored right before data_
+			bool resource_;
+
+			size_t size() const noexcept { return size_; }
+			size_t capacity() const noexcept { return capacity_; }
+			bool resource() const noexcept { return resource_; }
+			void set_size(size_t value) noexcept { size_ = value; }
+
+			void set(char8_t* data, size_t size, size_t capacity, bool resource) noexcept {
+				data_ = data;
+				size_ = size;
+				capacity_ = capacity;
+				resource_ = resource;
+			}
+		};
+
+		/*!
+		 * @brief 16-byte heap part of BasicHString<15>.
+		 *
+		 * The last byte of bits_ is the byte of sso_flag_, so bit 24 stays clear and the capacity is split around it:
+		 * bits [0, 24) and [26, 32) hold the capacity, bit 25 the resource flag.
+		 */
+		struct CompactStringHeap {
+			static constexpr size_t max_capacity = (size_t{1} << 30) - 1;
+
+			char8_t* data_;
+			uint32_t size_;
+			uint32_t bits_;
+
+			size_t size() const noexcept { return size_; }
+			size_t capacity() const noexcept { return (bits_ & 0xFFFFFF) | (bits_ >> 26) << 24; }
+			bool resource() const noexcept { return bits_ >> 25 & 1; }
+			void set_size(size_t value) noexcept { size_ = static_cast<uint32_t>(value); }
+
+			void set(char8_t* data, size_t size, size_t capacity, bool resource) noexcept {
+				data_ = data;
+				size_ = static_cast<uint32_t>(size);
+				bits_ = static_cast<uint32_t>((capacity & 0xFFFFFF) | (capacity >> 24) << 26) | static_cast<uint32_t>(resource) << 25;
+			}
+		};
+
+		static_assert(std::endian::native == std::endian::little, "CompactStringHeap expects sso_flag_ in the last byte of bits_");
+	}
+
+	/*!
+	 * @brief UTF-8 string keeping up to Size - 1 code units inline, the object is Size + 1 bytes.
+	 *
+	 * HString (Size 31) is the default. BasicHString<15> is 16 bytes, for containers of many short keys where the object
+	 * size dominates; its heap size and capacity are 32-bit, so its text is limited to max_size(). BasicHString<63> keeps
+	 * longer text inline. The out-of-line members are compiled for these three sizes only.
+	 *
+	 * Heap buffers are allocated the same way for every Size, so moving between sizes hands the buffer over.
+	 *
+	 * @note Strictly prohibit empty assignment
+	 */
+	template<size_t Size>
+	class BasicHString {
 	public:
 		//==================> aligns <==================
 
@@ -41,82 +118,87 @@ namespace hana
 		using reverse_range = unicode::UTF8RangeInv<false>;
 		using const_reverse_range = unicode::UTF8RangeInv<true>;
 
-		static constexpr size_type SSOSize = 31;
+		static constexpr size_type SSOSize = Size;
 		static constexpr size_type SSOBufferSize = SSOSize + 1;
 		static constexpr size_type SSOCapacity = SSOSize - 1;
 		static constexpr size_type npos = HStringView::npos;
 
 		static_assert(SSOBufferSize % 4 == 0, "SSOSize must be 4n - 1");
-		static_assert(SSOBufferSize > sizeof(size_type) * 2 + sizeof(pointer), "SSOSize must be larger than heap data size");
+		static_assert(SSOBufferSize >= sizeof(internal::CompactStringHeap), "SSOSize must be larger than heap data size");
 		static_assert(SSOBufferSize < 128, "SSOBufferSize must be less than 127"); // sso_size_ max
 
 		//==================> join <==================
 
-		template<typename... Args> static HString concat(Args&&... string_or_view);
-		template<typename Container> static HString join(const Container& container, HStringView separator, bool skip_empty = true, HStringView trim_chs = {});
+		template<typename... Args> static BasicHString concat(Args&&... string_or_view);
+		template<typename Container> static BasicHString join(const Container& container, HStringView separator, bool skip_empty = true, HStringView trim_chs = {});
 
 		//==================> ctor & dtor <==================
 
-		HANA_BASE_API HString();
-		HANA_BASE_API HString(size_type count, value_type ch);
-		HString(const HString& other);
-		HANA_BASE_API HString(HString&& rhs) noexcept;
+		BasicHString();
+		BasicHString(size_type count, value_type ch);
+		BasicHString(const BasicHString& other);
+		BasicHString(BasicHString&& rhs) noexcept;
+		template<size_t OtherSize> requires(OtherSize != Size) explicit BasicHString(const BasicHString<OtherSize>& other);
+		template<size_t OtherSize> requires(OtherSize != Size) explicit BasicHString(BasicHString<OtherSize>&& other);
 
-		HString(const char* str);
-		HString(const char8_t* str);
-		HString(const char16_t* str);
-		HString(const char32_t* str);
-		HString(const wchar_t* str);
+		BasicHString(const char* str);
+		BasicHString(const char8_t* str);
+		BasicHString(const char16_t* str);
+		BasicHString(const char32_t* str);
+		BasicHString(const wchar_t* str);
 
-		HString(const char* str, size_type count);
-		HString(const char8_t* str, size_type count);
-		HANA_BASE_API HString(const char16_t* str, size_type count);
-		HANA_BASE_API HString(const char32_t* str, size_type count);
-		HString(const wchar_t* str, size_type count);
+		BasicHString(const char* str, size_type count);
+		BasicHString(const char8_t* str, size_type count);
+		BasicHString(const char16_t* str, size_type count);
+		BasicHString(const char32_t* str, size_type count);
+		BasicHString(const wchar_t* str, size_type count);
 
-		HANA_BASE_API HString(HStringView view);
-		HString(HStringView view, size_type pos);
-		HString(HStringView view, size_type pos, size_type count);
+		BasicHString(HStringView view);
+		BasicHString(HStringView view, size_type pos);
+		BasicHString(HStringView view, size_type pos, size_type count);
 
-		HANA_BASE_API ~HString() noexcept;
+		~BasicHString() noexcept;
 
 		//==================> assign <==================
 
-		HANA_BASE_API HString& assign(HString&& rhs) noexcept;
-		HANA_BASE_API HString& assign(HStringView view);
-		HString& assign(HStringView view, size_type pos, size_type count = npos);
-
-		HString& assign(const char* str);
-		HString& assign(const char8_t* str);
-		HString& assign(const char16_t* str);
-		HString& assign(const char32_t* str);
-		HString& assign(const wchar_t* str);
-
-		HString& assign(const char* str, size_type count);
-		HString& assign(const char8_t* str, size_type count);
-		HANA_BASE_API HString& assign(const char16_t* str, size_type count);
-		HANA_BASE_API HString& assign(const char32_t* str, size_type count);
-		HString& assign(const wchar_t* str, size_type count);
-
-		HString& operator=(const HString& rhs);
-		HString& operator=(HString&& rhs) noexcept;
-		HString& operator=(HStringView view);
-		HString& operator=(const char* str);
-		HString& operator=(const char8_t* str);
-		HString& operator=(const char16_t* str);
-		HString& operator=(const char32_t* str);
-		HString& operator=(const wchar_t* str);
+		BasicHString& assign(BasicHString&& rhs) noexcept;
+		//! takes over the heap buffer of rhs when this size can hold its capacity, copies otherwise
+		template<size_t OtherSize> requires(OtherSize != Size) BasicHString& assign(BasicHString<OtherSize>&& rhs);
+		BasicHString& assign(HStringView view);
+		BasicHString& assign(HStringView view, size_type pos, size_type count = npos);
+
+		BasicHString& assign(const char* str);
+		BasicHString& assign(const char8_t* str);
+		BasicHString& assign(const char16_t* str);
+		BasicHString& assign(const char32_t* str);
+		BasicHString& assign(const wchar_t* str);
+
+		BasicHString& assign(const char* str, size_type count);
+		BasicHString& assign(const char8_t* str, size_type count);
+		BasicHString& assign(const char16_t* str, size_type count);
+		BasicHString& assign(const char32_t* str, size_type count);
+		BasicHString& assign(const wchar_t* str, size_type count);
+
+		BasicHString& operator=(const BasicHString& rhs);
+		BasicHString& operator=(BasicHString&& rhs) noexcept;
+		template<size_t OtherSize> requires(OtherSize != Size) BasicHString& operator=(BasicHString<OtherSize>&& rhs);
+		BasicHString& operator=(HStringView view);
+		BasicHString& operator=(const char* str);
+		BasicHString& operator=(const char8_t* str);
+		BasicHString& operator=(const char16_t* str);
+		BasicHString& operator=(const char32_t* str);
+		BasicHString& operator=(const wchar_t* str);
 
 		//==================> compare <==================
 
 		bool operator==(const char* str) const noexcept;
 		bool operator==(const char8_t* str) const noexcept;
 		bool operator==(HStringView str) const noexcept;
-		bool operator==(const HString& str) const noexcept;
+		bool operator==(const BasicHString& str) const noexcept;
 		std::strong_ordering operator<=>(const char* str) const noexcept;
 		std::strong_ordering operator<=>(const char8_t* str) const noexcept;
 		std::strong_ordering operator<=>(HStringView str) const noexcept;
-		std::strong_ordering operator<=>(const HString& str) const noexcept;
+		std::strong_ordering operator<=>(const BasicHString& str) const noexcept;
 
 		//==================> iterator <==================
 
@@ -190,6 +272,8 @@ namespace hana
 		unicode::UTF8Seq last_text(size_type index) const;
 		bool is_sso() const noexcept;
 		bool is_heap() const noexcept;
+		//! @return resource owning the heap buffer, nullptr for inline text and buffers from allocator_type
+		std::pmr::memory_resource* memory_resource() const noexcept;
 		bool is_valid_index(size_type index) const noexcept;
 		size_type buffer_index_to_text(size_type index) const noexcept;
 		size_type text_index_to_buffer(size_type index) const noexcept;
@@ -200,27 +284,27 @@ namespace hana
 		HStringView first_view(size_type count) const;
 		HStringView last_view(size_type count) const;
 		HStringView subview(size_type start, size_type count = npos) const noexcept;
-		HString first_str(size_type count) const;
-		HString last_str(size_type count) const;
-		HString substr(size_type pos = 0, size_type count = npos) const;
+		BasicHString first_str(size_type count) const;
+		BasicHString last_str(size_type count) const;
+		BasicHString substr(size_type pos = 0, size_type count = npos) const;
 
 		//==================> add <==================
 
-		HANA_BASE_API HString& insert(size_type index, size_type count, value_type ch);
-		HString& insert(size_type index, unicode::UTF8Seq seq);
-		HANA_BASE_API HString& insert(size_type index, HStringView view);
-		HANA_BASE_API HString& insert(size_type index, const char16_t* str);
-		HANA_BASE_API HString& insert(size_type index, const char32_t* str);
-		HString& insert(size_type index, const wchar_t* str);
+		BasicHString& insert(size_type index, size_type count, value_type ch);
+		BasicHString& insert(size_type index, unicode::UTF8Seq seq);
+		BasicHString& insert(size_type index, HStringView view);
+		BasicHString& insert(size_type index, const char16_t* str);
+		BasicHString& insert(size_type index, const char32_t* str);
+		BasicHString& insert(size_type index, const wchar_t* str);
 
-		HANA_BASE_API HString& append(size_type count, value_type ch);
-		HString& append(unicode::UTF8Seq seq);
-		HANA_BASE_API HString& append(HStringView view);
-		HANA_BASE_API HString& append(const char16_t* str);
-		HANA_BASE_API HString& append(const char32_t* str);
-		HString& append(const wchar_t* str);
+		BasicHString& append(size_type count, value_type ch);
+		BasicHString& append(unicode::UTF8Seq seq);
+		BasicHString& append(HStringView view);
+		BasicHString& append(const char16_t* str);
+		BasicHString& append(const char32_t* str);
+		BasicHString& append(const wchar_t* str);
 
-		HString& push_back(value_type ch);
+		BasicHString& push_back(value_type ch);
 
 		void operator+=(value_type ch);
 		void operator+=(unicode::UTF8Seq seq);
@@ -231,17 +315,17 @@ namespace hana
 
 		//==================> remove <==================
 
-		HANA_BASE_API HString& clear() noexcept;
-		HANA_BASE_API HString& pop_back(size_type count = 1);
-		HANA_BASE_API HString& erase(size_type index = 0, size_type count = npos);
+		BasicHString& clear() noexcept;
+		BasicHString& pop_back(size_type count = 1);
+		BasicHString& erase(size_type index = 0, size_type count = npos);
 
 		//==================> replace <==================
 
-		HANA_BASE_API HString& replace(size_type pos, size_type count, const_pointer cstr, size_type count2);
-		HString& replace(size_type pos, size_type count, HStringView view);
+		BasicHString& replace(size_type pos, size_type count, const_pointer cstr, size_type count2);
+		BasicHString& replace(size_type pos, size_type count, HStringView view);
 
-		HString Replace(size_type pos, size_type count, const_pointer cstr, size_type count2) const;
-		HString Replace(size_type pos, size_type count, HStringView view) const;
+		BasicHString Replace(size_type pos, size_type count, const_pointer cstr, size_type count2) const;
+		BasicHString Replace(size_type pos, size_type count, HStringView view) const;
 
 		//==================> starts & ends with <==================
 
@@ -324,23 +408,40 @@ namespace hana
 		const_data_reference find_last_not_of(unicode::UTF8Seq seq, size_type pos = npos) const;
 		const_data_reference find_last_not_of(const_pointer s, size_type pos, size_type count) const;
 
+		//==================> case <==================
+
+		// simple (1:1) case mappings, see unicode::to_lower, unicode::to_upper and unicode::casefold;
+		// to_lower, to_upper and casefold reuse the buffer unless a code point changes its utf-8 length
+		BasicHString& to_lower();
+		BasicHString& to_upper();
+		BasicHString& casefold();
+
+		BasicHString ToLower() const;
+		BasicHString ToUpper() const;
+		BasicHString Casefold() const;
+
+		bool iequals(HStringView rhs) const noexcept;
+		int icompare(HStringView rhs) const noexcept;
+		data_reference ifind(HStringView pattern, size_type pos = 0) noexcept;
+		const_data_reference ifind(HStringView pattern, size_type pos = 0) const noexcept;
+
 		//==================> remove prefix & prefix <==================
 
-		HString& remove_prefix(size_type n);
-		HString& remove_prefix(HStringView prefix);
-		HString& remove_prefix(unicode::UTF8Seq prefix);
+		BasicHString& remove_prefix(size_type n);
+		BasicHString& remove_prefix(HStringView prefix);
+		BasicHString& remove_prefix(unicode::UTF8Seq prefix);
 
-		HString& remove_suffix(size_type n);
-		HString& remove_suffix(HStringView suffix);
-		HString& remove_suffix(unicode::UTF8Seq suffix);
+		BasicHString& remove_suffix(size_type n);
+		BasicHString& remove_suffix(HStringView suffix);
+		BasicHString& remove_suffix(unicode::UTF8Seq suffix);
 
-		HString RemovePrefix(size_type n) const;
-		HString RemovePrefix(HStringView prefix) const;
-		HString RemovePrefix(unicode::UTF8Seq prefix) const;
+		BasicHString RemovePrefix(size_type n) const;
+		BasicHString RemovePrefix(HStringView prefix) const;
+		BasicHString RemovePrefix(unicode::UTF8Seq prefix) const;
 
-		HString RemoveSuffix(size_type n) const;
-		HString RemoveSuffix(HStringView suffix) const;
-		HString RemoveSuffix(unicode::UTF8Seq suffix) const;
+		BasicHString RemoveSuffix(size_type n) const;
+		BasicHString RemoveSuffix(HStringView suffix) const;
+		BasicHString RemoveSuffix(unicode::UTF8Seq suffix) const;
 
 		//==================> partition <==================
 
@@ -349,25 +450,25 @@ namespace hana
 
 		//==================> trim <==================
 
-		HString& trim(HStringView characters = u8" \t");
-		HString& trim_start(HStringView characters = u8" \t");
-		HString& trim_end(HStringView characters = u8" \t");
-		HString& trim(unicode::UTF8Seq seq);
-		HString& trim_start(unicode::UTF8Seq seq);
-		HString& trim_end(unicode::UTF8Seq seq);
-		HString& trim_invalid();
-		HString& trim_invalid_start();
-		HString& trim_invalid_end();
-
-		HString Trim(HStringView characters = u8" \t") const;
-		HString TrimStart(HStringView characters = u8" \t") const;
-		HString TrimEnd(HStringView characters = u8" \t") const;
-		HString Trim(unicode::UTF8Seq seq) const;
-		HString TrimStart(unicode::UTF8Seq seq) const;
-		HString TrimEnd(unicode::UTF8Seq seq) const;
-		HString TrimInvalid() const;
-		HString TrimInvalidStart() const;
-		HString TrimInvalidEnd() const;
+		BasicHString& trim(HStringView characters = u8" \t");
+		BasicHString& trim_start(HStringView characters = u8" \t");
+		BasicHString& trim_end(HStringView characters = u8" \t");
+		BasicHString& trim(unicode::UTF8Seq seq);
+		BasicHString& trim_start(unicode::UTF8Seq seq);
+		BasicHString& trim_end(unicode::UTF8Seq seq);
+		BasicHString& trim_invalid();
+		BasicHString& trim_invalid_start();
+		BasicHString& trim_invalid_end();
+
+		BasicHString Trim(HStringView characters = u8" \t") const;
+		BasicHString TrimStart(HStringView characters = u8" \t") const;
+		BasicHString TrimEnd(HStringView characters = u8" \t") const;
+		BasicHString Trim(unicode::UTF8Seq seq) const;
+		BasicHString TrimStart(unicode::UTF8Seq seq) const;
+		BasicHString TrimEnd(unicode::UTF8Seq seq) const;
+		BasicHString TrimInvalid() const;
+		BasicHString TrimInvalidStart() const;
+		BasicHString TrimInvalidEnd() const;
 
 		//==================> split <==================
 
@@ -383,25 +484,47 @@ namespace hana
 		template<std::invocable<HStringView> F>
 		size_type split_each(F&& func, unicode::UTF8Seq delimiter, bool cull_empty = false, size_type limit = npos) const;
 
+		// lazy ranges viewing the buffer, see HStringView::split_view, not available on temporaries
+		internal::StringPieceRange<internal::SplitCutter> split_view(HStringView delimiter, bool cull_empty = false) const& noexcept;
+		internal::StringPieceRange<internal::TokenCutter> tokens(HStringView separators = u8" \t\r\n") const& noexcept;
+		internal::StringPieceRange<internal::LineCutter> lines() const& noexcept;
+		void split_view(HStringView delimiter, bool cull_empty = false) && = delete;
+		void tokens(HStringView separators = u8" \t\r\n") && = delete;
+		void lines() && = delete;
+
 		//==================> misc <==================
 
-		HANA_BASE_API void reserve(size_type new_cap);
+		void reserve(size_type new_cap);
+		//! like reserve but allocates exactly new_cap code units, for strings whose final size is known
+		void reserve_exact(size_type new_cap);
 		void release(size_type reserve_capacity = 0);
-		HANA_BASE_API void resize(size_type count);
-		HANA_BASE_API void resize(size_type count, value_type ch);
-		void swap(HString& other) noexcept;
-		HString& reverse(size_type start = 0, size_type count = npos);
+		void resize(size_type count);
+		void resize(size_type count, value_type ch);
+		/*!
+		 * @brief Grows to count code units without initializing them and lets op write the content in place.
+		 * @param op called as op(data(), count), returns the final size (<= count); [0, size()) keeps the old content
+		 */
+		template<typename Op> void resize_and_overwrite(size_type count, Op op);
+		void swap(BasicHString& other) noexcept;
+		BasicHString& reverse(size_type start = 0, size_type count = npos);
 		size_type copy(pointer dest, size_type count, size_type pos = 0) const;
 
 	private:
-		friend struct StringHelper;
+		template<typename> friend struct StringHelper;
+		template<size_t> friend class BasicHString;
+		template<size_t, typename> friend class fmt::memory_buffer;
+
+		// the 24-byte heap part does not fit 16-byte strings, they keep size and capacity in 32 bits
+		using Heap = std::conditional_t<SSOBufferSize >= sizeof(internal::StringHeap), internal::StringHeap, internal::CompactStringHeap>;
+
+		// Takes ownership of `capacity` bytes from allocator_type holding `size` chars, size < capacity.
+		static BasicHString adopt(pointer data, size_type size, size_type capacity) noexcept;
+
+		void reset() noexcept;
+		void set_size(size_type value) noexcept;
 
 		union {
-			struct {
-				pointer data_;
-				size_type size_;
-				size_type capacity_;
-			};
+			Heap heap_;
 
 			struct {
 				value_type sso_data_[SSOSize];
@@ -412,6 +535,98 @@ namespace hana
 			uint8_t buffer_[SSOBufferSize];
 		};
 	};
+
+	using HString = BasicHString<31>;
+
+	extern template class HANA_BASE_API BasicHString<15>;
+	extern template class HANA_BASE_API BasicHString<31>;
+	extern template class HANA_BASE_API BasicHString<63>;
+
+	/*!
+	 * @brief Routes HString heap allocations of the calling thread to a memory_resource while alive.
+	 *
+	 * Lets request-scoped strings live in an arena (e.g. std::pmr::monotonic_buffer_resource) without changing the type or
+	 * layout of HString. A heap buffer remembers the resource it came from, so strings can be moved, grown and destroyed
+	 * anywhere; only buffers allocated while the scope is active use the resource, a heap string that grows later keeps
+	 * its original allocator. Scopes nest, the innermost wins, and nullptr restores allocator_type.
+	 *
+	 * @note Strings allocated in the scope must not outlive the resource.
+	 */
+	class HANA_BASE_API HStringResourceScope {
+	public:
+		explicit HStringResourceScope(std::pmr::memory_resource* resource) noexcept;
+		~HStringResourceScope() noexcept;
+
+		HStringResourceScope(const HStringResourceScope&) = delete;
+		HStringResourceScope& operator=(const HStringResourceScope&) = delete;
+
+		//! @return resource new HString buffers of the calling thread come from, nullptr for allocator_type
+		static std::pmr::memory_resource* current() noexcept;
+
+	private:
+		std::pmr::memory_resource* previous_;
+	};
+
+	/*!
+	 * @brief Collects views and concatenates them with a single exact allocation.
+	 *
+	 * For strings assembled piece by piece (paths, messages, generated code) where appending to an HString would regrow
+	 * the buffer several times. Only views are stored, the text they refer to must stay alive until str() or append_to().
+	 * The pieces may view the string passed to append_to(), it builds into a new buffer when growing would free them.
+	 */
+	class HStringBuilder {
+	public:
+		using size_type = HString::size_type;
+
+		HStringBuilder() = default;
+		explicit HStringBuilder(size_type piece_capacity);
+
+		HStringBuilder& append(HStringView view);
+		HStringBuilder& operator+=(HStringView view);
+
+		bool empty() const noexcept;
+		//! code units of the concatenated text
+		size_type size() const noexcept;
+		void clear() noexcept;
+
+		template<typename String = HString> String str() const;
+		template<size_t Size> void append_to(BasicHString<Size>& out) const;
+
+	private:
+		std::vector<HStringView> pieces_;
+		size_type size_ = 0;
+	};
+}
+
+namespace hana::internal
+{
+	template<typename T>
+	concept StringConcatOperand = std::convertible_to<const T&, HStringView>;
+
+	template<typename T> inline constexpr bool is_basic_hstring_v = false;
+	template<size_t Size> inline constexpr bool is_basic_hstring_v<BasicHString<Size>> = true;
+
+	/*!
+	 * @brief Lazy `a + b + c` over HString operands, converting to HString sizes once and allocates once.
+	 *
+	 * Holds views of the operands, which may be temporaries of the same full expression. Only an rvalue can be
+	 * converted or chained, so a concat kept in a named variable (`auto s = a + b;`) fails to compile where it is used
+	 * instead of reading operands that are already destroyed.
+	 */
+	template<size_t N>
+	struct [[nodiscard]] StringConcat {
+		std::array<HStringView, N> pieces;
+
+		HString::size_type size() const noexcept;
+
+		template<typename String = HString> String str() const&&;
+		template<typename String = HString> String str() const& = delete;
+
+		template<size_t Size> operator BasicHString<Size>() const&& { return std::move(*this).template str<BasicHString<Size>>(); }
+		template<size_t Size> operator BasicHString<Size>() const& = delete;
+	};
+
+	HString::pointer write_pieces(HString::pointer out, const HStringView* first, const HStringView* last) noexcept;
 }
 
 namespace hana::internal
@@ -422,209 +637,344 @@ namespace hana::internal
 // join
 namespace hana
 {
+	template<size_t Size>
 	template<typename... Args>
-	HString HString::concat(Args&&... string_or_view) {
-		std::array<HStringView, sizeof...(Args)> args{HStringView{string_or_view}...};
+	BasicHString<Size> BasicHString<Size>::concat(Args&&... string_or_view) {
+		return internal::StringConcat<sizeof...(Args)>{HStringView{string_or_view}...}.template str<BasicHString>();
+	}
+
+	template<size_t Size>
+	template<typename Container>
+	BasicHString<Size> BasicHString<Size>::join(const Container& container, HStringView separator, bool skip_empty, HStringView trim_chs) {
+		const auto for_each_piece = [&](auto&& func) {
+			bool is_first_append = true;
+			for (const auto& str: container) {
+				HStringView view{str};
+
+				// trim
+				if (!trim_chs.empty()) {
+					view = view.trim(trim_chs);
+				}
+
+				// skip empty
+				if (skip_empty && view.empty()) continue;
+
+				// append separator
+				if (is_first_append) {
+					is_first_append = false;
+				} else {
+					func(separator);
+				}
+
+				// append item
+				func(view);
+			}
+		};
+
+		// trim once and keep the views instead of trimming again while copying
+		if (!trim_chs.empty()) {
+			HStringBuilder builder;
+			for_each_piece([&](HStringView view) { builder.append(view); });
+			return builder.str<BasicHString>();
+		}
 
 		// calc size
 		size_type total_size = 0;
-		for (const auto& arg: args) {
-			total_size += arg.size();
-		}
+		for_each_piece([&](HStringView view) { total_size += view.size(); });
 
 		// combine
-		HString result;
-		result.reserve(total_size);
-		for (const auto& arg: args) {
-			result.append(arg);
-		}
-
+		BasicHString result;
+		result.reserve_exact(total_size);
+		result.resize_and_overwrite(total_size, [&](pointer out, size_type) {
+			for_each_piece([&](HStringView view) {
+				out = internal::write_pieces(out, &view, &view + 1);
+			});
+			return total_size;
+		});
 		return result;
 	}
+}
 
-	template<typename Container>
-	HString HString::join(const Container& container, HStringView separator, bool skip_empty, HStringView trim_chs) {
-		// calc size
-		size_type total_size = 0;
-		bool is_first_append = false;
-		for (const auto& str: container) {
-			HStringView view{str};
+// builder
+namespace hana
+{
+	inline HStringBuilder::HStringBuilder(size_type piece_capacity) {
+		pieces_.reserve(piece_capacity);
+	}
 
-			// trim
-			if (!trim_chs.empty()) {
-				view = view.trim(trim_chs);
-			}
+	inline HStringBuilder& HStringBuilder::append(HStringView view) {
+		if (!view.empty()) {
+			pieces_.push_back(view);
+			size_ += view.size();
+		}
+		return *this;
+	}
 
-			// skip empty
-			if (skip_empty && view.empty()) continue;
+	inline HStringBuilder& HStringBuilder::operator+=(HStringView view) { return append(view); }
 
-			// append separator
-			if (!is_first_append) {
-				is_first_append = true;
-			} else {
-				total_size += separator.size();
-			}
+	inline bool HStringBuilder::empty() const noexcept { return size_ == 0; }
+	inline HStringBuilder::size_type HStringBuilder::size() const noexcept { return size_; }
 
-			// append item
-			total_size += view.size();
-		}
+	inline void HStringBuilder::clear() noexcept {
+		pieces_.clear();
+		size_ = 0;
+	}
 
-		// combine
-		HString result;
-		result.reserve(total_size);
-		is_first_append = false;
-		for (const auto& str: container) {
-			HStringView view{str};
-
-			// trim
-			if (!trim_chs.empty()) {
-				view = view.trim(trim_chs);
+	template<typename String>
+	String HStringBuilder::str() const {
+		String result;
+		result.reserve_exact(size_);
+		append_to(result);
+		return result;
+	}
+
+	template<size_t Size>
+	void HStringBuilder::append_to(BasicHString<Size>& out) const {
+		const size_type offset = out.size();
+		if (offset + size_ > out.capacity()) {
+			const std::less<const char8_t*> less;
+			const char8_t* first = out.data();
+			const char8_t* last = first + out.capacity();
+			const bool aliases = std::ranges::any_of(pieces_, [&](const HStringView& piece) {
+				return less(piece.data(), last) && less(first, piece.data() + piece.size());
+			});
+			if (aliases) {
+				// growing frees the buffer the pieces point into, so build the result next to it
+				BasicHString<Size> result;
+				result.reserve_exact(offset + size_);
+				result.resize_and_overwrite(offset + size_, [&](HString::pointer data, size_type count) {
+					HString::traits_type::copy(data, first, offset);
+					internal::write_pieces(data + offset, pieces_.data(), pieces_.data() + pieces_.size());
+					return count;
+				});
+				out = std::move(result);
+				return;
 			}
+		}
 
-			// skip empty
-			if (skip_empty && view.empty()) continue;
+		out.resize_and_overwrite(offset + size_, [&](HString::pointer data, size_type count) {
+			internal::write_pieces(data + offset, pieces_.data(), pieces_.data() + pieces_.size());
+			return count;
+		});
+	}
+}
 
-			// append separator
-			if (!is_first_append) {
-				is_first_append = true;
-			} else {
-				result.append(separator);
+// concat expression
+namespace hana::internal
+{
+	inline HString::pointer write_pieces(HString::pointer out, const HStringView* first, const HStringView* last) noexcept {
+		for (; first != last; ++first) {
+			if (!first->empty()) {
+				HString::traits_type::copy(out, first->data(), first->size());
+				out += first->size();
 			}
+		}
+		return out;
+	}
 
-			// append item
-			result.append(view);
+	template<size_t N>
+	HString::size_type StringConcat<N>::size() const noexcept {
+		HString::size_type total_size = 0;
+		for (const HStringView& piece: pieces) {
+			total_size += piece.size();
 		}
+		return total_size;
+	}
+
+	template<size_t N>
+	template<typename String>
+	String StringConcat<N>::str() const&& {
+		const HString::size_type total_size = size();
+		String result;
+		result.reserve_exact(total_size);
+		result.resize_and_overwrite(total_size, [&](HString::pointer out, HString::size_type) {
+			write_pieces(out, pieces.data(), pieces.data() + N);
+			return total_size;
+		});
+		return result;
+	}
 
-		assert(result.size() == total_size && "Join failed");
+	template<size_t N, StringConcatOperand R>
+	StringConcat<N + 1> operator+(const StringConcat<N>& lhs, const R& rhs) = delete;
 
+	template<size_t N, StringConcatOperand R>
+	StringConcat<N + 1> operator+(StringConcat<N>&& lhs, const R& rhs) {
+		StringConcat<N + 1> result;
+		std::copy(lhs.pieces.begin(), lhs.pieces.end(), result.pieces.begin());
+		result.pieces[N] = HStringView{rhs};
 		return result;
 	}
 }
 
+namespace hana
+{
+	template<internal::StringConcatOperand L, internal::StringConcatOperand R>
+		requires internal::is_basic_hstring_v<L> || internal::is_basic_hstring_v<R>
+	internal::StringConcat<2> operator+(const L& lhs, const R& rhs) {
+		return {HStringView{lhs}, HStringView{rhs}};
+	}
+}
+
 // ctor & dtor
 namespace hana
 {
-	inline HString::HString(const HString& other): HString(other.data(), other.size()) {}
+	template<size_t Size> inline BasicHString<Size>::BasicHString(const BasicHString& other): BasicHString(other.data(), other.size()) {}
 
-	inline HString::HString(const char* str): HString(HStringView{str}) {}
-	inline HString::HString(const char8_t* str): HString(HStringView{str}) {}
-	inline HString::HString(const char16_t* str): HString(str, std::char_traits<char16_t>::length(str)) {}
-	inline HString::HString(const char32_t* str): HString(str, std::char_traits<char32_t>::length(str)) {}
-	inline HString::HString(const wchar_t* str): HString(str, std::char_traits<wchar_t>::length(str)) {}
+	template<size_t Size>
+	template<size_t OtherSize> requires(OtherSize != Size)
+	inline BasicHString<Size>::BasicHString(const BasicHString<OtherSize>& other): BasicHString(other.data(), other.size()) {}
 
-	inline HString::HString(const char* str, size_type count): HString(HStringView{str, count}) {}
-	inline HString::HString(const char8_t* str, size_type count): HString(HStringView{str, count}) {}
-	inline HString::HString(const wchar_t* str, size_type count): HString(reinterpret_cast<internal::const_wchar_ptr>(str), count) {}
+	template<size_t Size>
+	template<size_t OtherSize> requires(OtherSize != Size)
+	inline BasicHString<Size>::BasicHString(BasicHString<OtherSize>&& other): BasicHString() {
+		assign(std::move(other));
+	}
+
+	template<size_t Size> inline BasicHString<Size>::BasicHString(const char* str): BasicHString(HStringView{str}) {}
+	template<size_t Size> inline BasicHString<Size>::BasicHString(const char8_t* str): BasicHString(HStringView{str}) {}
+	template<size_t Size> inline BasicHString<Size>::BasicHString(const char16_t* str): BasicHString(str, std::char_traits<char16_t>::length(str)) {}
+	template<size_t Size> inline BasicHString<Size>::BasicHString(const char32_t* str): BasicHString(str, std::char_traits<char32_t>::length(str)) {}
+	template<size_t Size> inline BasicHString<Size>::BasicHString(const wchar_t* str): BasicHString(str, std::char_traits<wchar_t>::length(str)) {}
 
-	inline HString::HString(HStringView view, size_type pos): HString(view.data() + pos, view.size() - pos) {}
-	inline HString::HString(HStringView view, size_type pos, size_type count): HString(view.data() + pos, count) {}
+	template<size_t Size> inline BasicHString<Size>::BasicHString(const char* str, size_type count): BasicHString(HStringView{str, count}) {}
+	template<size_t Size> inline BasicHString<Size>::BasicHString(const char8_t* str, size_type count): BasicHString(HStringView{str, count}) {}
+	template<size_t Size> inline BasicHString<Size>::BasicHString(const wchar_t* str, size_type count): BasicHString(reinterpret_cast<internal::const_wchar_ptr>(str), count) {}
+
+	template<size_t Size> inline BasicHString<Size>::BasicHString(HStringView view, size_type pos): BasicHString(view.data() + pos, view.size() - pos) {}
+	template<size_t Size> inline BasicHString<Size>::BasicHString(HStringView view, size_type pos, size_type count): BasicHString(view.data() + pos, count) {}
 }
 
 // assign
 namespace hana
 {
-	inline HString& HString::assign(HStringView view, size_type pos, size_type count) { return assign(view.subview(pos, count)); }
-
-	inline HString& HString::assign(const char* str) { return assign(HStringView{str}); }
-	inline HString& HString::assign(const char8_t* str) { return assign(HStringView{str}); }
-	inline HString& HString::assign(const char16_t* str) { return assign(str, std::char_traits<char16_t>::length(str)); }
-	inline HString& HString::assign(const char32_t* str) { return assign(str, std::char_traits<char32_t>::length(str)); }
-	inline HString& HString::assign(const wchar_t* str) { return assign(str, std::char_traits<wchar_t>::length(str)); }
-
-	inline HString& HString::assign(const char* str, size_type count) { return assign(HStringView{str, count}); }
-	inline HString& HString::assign(const char8_t* str, size_type count) { return assign(HStringView{str, count}); }
-	inline HString& HString::assign(const wchar_t* str, size_type count) { return assign(reinterpret_cast<internal::const_wchar_ptr>(str), count); }
-
-	inline HString& HString::operator=(const HString& rhs) { return assign(rhs); }
-	inline HString& HString::operator=(HString&& rhs) noexcept { return assign(std::move(rhs)); }
-	inline HString& HString::operator=(HStringView view) { return assign(view); }
-	inline HString& HString::operator=(const char* str) { return assign(str); }
-	inline HString& HString::operator=(const char8_t* str) { return assign(str); }
-	inline HString& HString::operator=(const char16_t* str) { return assign(str); }
-	inline HString& HString::operator=(const char32_t* str) { return assign(str); }
-	inline HString& HString::operator=(const wchar_t* str) { return assign(str); }
+	template<size_t Size>
+	template<size_t OtherSize> requires(OtherSize != Size)
+	inline BasicHString<Size>& BasicHString<Size>::assign(BasicHString<OtherSize>&& rhs) {
+		if (rhs.is_sso() || rhs.heap_.capacity() > Heap::max_capacity) {
+			return assign(HStringView{rhs});
+		}
+
+		BasicHString result;
+		result.heap_.set(rhs.heap_.data_, rhs.heap_.size(), rhs.heap_.capacity(), rhs.heap_.resource());
+		result.sso_flag_ = 0;
+		rhs.reset();
+		return assign(std::move(result));
+	}
+
+	template<size_t Size> inline BasicHString<Size>& BasicHString<Size>::assign(HStringView view, size_type pos, size_type count) { return assign(view.subview(pos, count)); }
+
+	template<size_t Size> inline BasicHString<Size>& BasicHString<Size>::assign(const char* str) { return assign(HStringView{str}); }
+	template<size_t Size> inline BasicHString<Size>& BasicHString<Size>::assign(const char8_t* str) { return assign(HStringView{str}); }
+	template<size_t Size> inline BasicHString<Size>& BasicHString<Size>::assign(const char16_t* str) { return assign(str, std::char_traits<char16_t>::length(str)); }
+	template<size_t Size> inline BasicHString<Size>& BasicHString<Size>::assign(const char32_t* str) { return assign(str, std::char_traits<char32_t>::length(str)); }
+	template<size_t Size> inline BasicHString<Size>& BasicHString<Size>::assign(const wchar_t* str) { return assign(str, std::char_traits<wchar_t>::length(str)); }
+
+	template<size_t Size> inline BasicHString<Size>& BasicHString<Size>::assign(const char* str, size_type count) { return assign(HStringView{str, count}); }
+	template<size_t Size> inline BasicHString<Size>& BasicHString<Size>::assign(const char8_t* str, size_type count) { return assign(HStringView{str, count}); }
+	template<size_t Size> inline BasicHString<Size>& BasicHString<Size>::assign(const wchar_t* str, size_type count) { return assign(reinterpret_cast<internal::const_wchar_ptr>(str), count); }
+
+	template<size_t Size> inline BasicHString<Size>& BasicHString<Size>::operator=(const BasicHString& rhs) { return assign(rhs); }
+	template<size_t Size> inline BasicHString<Size>& BasicHString<Size>::operator=(BasicHString&& rhs) noexcept { return assign(std::move(rhs)); }
+	template<size_t Size> inline BasicHString<Size>& BasicHString<Size>::operator=(HStringView view) { return assign(view); }
+	template<size_t Size> inline BasicHString<Size>& BasicHString<Size>::operator=(const char* str) { return assign(str); }
+	template<size_t Size> inline BasicHString<Size>& BasicHString<Size>::operator=(const char8_t* str) { return assign(str); }
+	template<size_t Size> inline BasicHString<Size>& BasicHString<Size>::operator=(const char16_t* str) { return assign(str); }
+	template<size_t Size> inline BasicHString<Size>& BasicHString<Size>::operator=(const char32_t* str) { return assign(str); }
+	template<size_t Size> inline BasicHString<Size>& BasicHString<Size>::operator=(const wchar_t* str) { return assign(str); }
+
+	template<size_t Size>
+	template<size_t OtherSize> requires(OtherSize != Size)
+	inline BasicHString<Size>& BasicHString<Size>::operator=(BasicHString<OtherSize>&& rhs) { return assign(std::move(rhs)); }
 }
 
 // compare
 namespace hana
 {
-	inline bool HString::operator==(const char* str) const noexcept { return HStringView(*this) == str; }
-	inline bool HString::operator==(const char8_t* str) const noexcept { return HStringView(*this) == str; }
-	inline bool HString::operator==(HStringView str) const noexcept { return HStringView(*this) == str; }
-	inline bool HString::operator==(const HString& str) const noexcept { return HStringView(*this) == HStringView(str); }
-	inline std::strong_ordering HString::operator<=>(const char* str) const noexcept { return HStringView(*this) <=> str; }
-	inline std::strong_ordering HString::operator<=>(const char8_t* str) const noexcept { return HStringView(*this) <=> str; }
-	inline std::strong_ordering HString::operator<=>(HStringView str) const noexcept { return HStringView(*this) <=> str; }
-	inline std::strong_ordering HString::operator<=>(const HString& str) const noexcept { return HStringView(*this) <=> HStringView(str); }
+	template<size_t Size> inline bool BasicHString<Size>::operator==(const char* str) const noexcept { return HStringView(*this) == str; }
+	template<size_t Size> inline bool BasicHString<Size>::operator==(const char8_t* str) const noexcept { return HStringView(*this) == str; }
+	template<size_t Size> inline bool BasicHString<Size>::operator==(HStringView str) const noexcept { return HStringView(*this) == str; }
+	template<size_t Size> inline bool BasicHString<Size>::operator==(const BasicHString& str) const noexcept { return HStringView(*this) == HStringView(str); }
+	template<size_t Size> inline std::strong_ordering BasicHString<Size>::operator<=>(const char* str) const noexcept { return HStringView(*this) <=> str; }
+	template<size_t Size> inline std::strong_ordering BasicHString<Size>::operator<=>(const char8_t* str) const noexcept { return HStringView(*this) <=> str; }
+	template<size_t Size> inline std::strong_ordering BasicHString<Size>::operator<=>(HStringView str) const noexcept { return HStringView(*this) <=> str; }
+	template<size_t Size> inline std::strong_ordering BasicHString<Size>::operator<=>(const BasicHString& str) const noexcept { return HStringView(*this) <=> HStringView(str); }
 }
 
 // iterator
 namespace hana
 {
-	inline HString::pointer HString::begin() noexcept { return data(); }
-	inline HString::const_pointer HString::begin() const noexcept { return data(); }
-	inline HString::const_pointer HString::cbegin() const noexcept { return data(); }
-
-	inline HString::pointer HString::end() noexcept { return data() + size(); }
-	inline HString::const_pointer HString::end() const noexcept { return data() + size(); }
-	inline HString::const_pointer HString::cend() const noexcept { return data() + size(); }
-
-	inline std::reverse_iterator<HString::pointer> HString::rbegin() noexcept { return std::reverse_iterator(end()); }
-	inline std::reverse_iterator<HString::const_pointer> HString::rbegin() const noexcept { return std::reverse_iterator(end()); }
-	inline std::reverse_iterator<HString::const_pointer> HString::crbegin() const noexcept { return std::reverse_iterator(end()); }
-
-	inline std::reverse_iterator<HString::pointer> HString::rend() noexcept { return std::reverse_iterator(begin()); }
-	inline std::reverse_iterator<HString::const_pointer> HString::rend() const noexcept { return std::reverse_iterator(begin()); }
-	inline std::reverse_iterator<HString::const_pointer> HString::crend() const noexcept { return std::reverse_iterator(begin()); }
-
-	inline HString::cursor HString::cursor_begin() { return cursor::Begin(data(), size()); }
-	inline HString::cursor HString::cursor_end() { return cursor::End(data(), size()); }
-	inline HString::iterator HString::iter() { return cursor::Begin(data(), size()).as_iter(); }
-	inline HString::reverse_iterator HString::iter_inv() { return cursor::End(data(), size()).as_iter_inv(); }
-	inline HString::range_t HString::range() { return cursor::Begin(data(), size()).as_range(); }
-	inline HString::reverse_range HString::range_inv() { return cursor::End(data(), size()).as_range_inv(); }
-
-	inline HString::const_cursor HString::cursor_begin() const { return const_cursor::Begin(data(), size()); }
-	inline HString::const_cursor HString::cursor_end() const { return const_cursor::End(data(), size()); }
-	inline HString::const_iterator HString::iter() const { return const_cursor::Begin(data(), size()).as_iter(); }
-	inline HString::const_reverse_iterator HString::iter_inv() const { return const_cursor::End(data(), size()).as_iter_inv(); }
-	inline HString::const_range HString::range() const { return const_cursor::Begin(data(), size()).as_range(); }
-	inline HString::const_reverse_range HString::range_inv() const { return const_cursor::End(data(), size()).as_range_inv(); }
+	template<size_t Size> inline typename BasicHString<Size>::pointer BasicHString<Size>::begin() noexcept { return data(); }
+	template<size_t Size> inline typename BasicHString<Size>::const_pointer BasicHString<Size>::begin() const noexcept { return data(); }
+	template<size_t Size> inline typename BasicHString<Size>::const_pointer BasicHString<Size>::cbegin() const noexcept { return data(); }
+
+	template<size_t Size> inline typename BasicHString<Size>::pointer BasicHString<Size>::end() noexcept { return data() + size(); }
+	template<size_t Size> inline typename BasicHString<Size>::const_pointer BasicHString<Size>::end() const noexcept { return data() + size(); }
+	template<size_t Size> inline typename BasicHString<Size>::const_pointer BasicHString<Size>::cend() const noexcept { return data() + size(); }
+
+	template<size_t Size> inline std::reverse_iterator<typename BasicHString<Size>::pointer> BasicHString<Size>::rbegin() noexcept { return std::reverse_iterator(end()); }
+	template<size_t Size> inline std::reverse_iterator<typename BasicHString<Size>::const_pointer> BasicHString<Size>::rbegin() const noexcept { return std::reverse_iterator(end()); }
+	template<size_t Size> inline std::reverse_iterator<typename BasicHString<Size>::const_pointer> BasicHString<Size>::crbegin() const noexcept { return std::reverse_iterator(end()); }
+
+	template<size_t Size> inline std::reverse_iterator<typename BasicHString<Size>::pointer> BasicHString<Size>::rend() noexcept { return std::reverse_iterator(begin()); }
+	template<size_t Size> inline std::reverse_iterator<typename BasicHString<Size>::const_pointer> BasicHString<Size>::rend() const noexcept { return std::reverse_iterator(begin()); }
+	template<size_t Size> inline std::reverse_iterator<typename BasicHString<Size>::const_pointer> BasicHString<Size>::crend() const noexcept { return std::reverse_iterator(begin()); }
+
+	template<size_t Size> inline typename BasicHString<Size>::cursor BasicHString<Size>::cursor_begin() { return cursor::Begin(data(), size()); }
+	template<size_t Size> inline typename BasicHString<Size>::cursor BasicHString<Size>::cursor_end() { return cursor::End(data(), size()); }
+	template<size_t Size> inline typename BasicHString<Size>::iterator BasicHString<Size>::iter() { return cursor::Begin(data(), size()).as_iter(); }
+	template<size_t Size> inline typename BasicHString<Size>::reverse_iterator BasicHString<Size>::iter_inv() { return cursor::End(data(), size()).as_iter_inv(); }
+	template<size_t Size> inline typename BasicHString<Size>::range_t BasicHString<Size>::range() { return cursor::Begin(data(), size()).as_range(); }
+	template<size_t Size> inline typename BasicHString<Size>::reverse_range BasicHString<Size>::range_inv() { return cursor::End(data(), size()).as_range_inv(); }
+
+	template<size_t Size> inline typename BasicHString<Size>::const_cursor BasicHString<Size>::cursor_begin() const { return const_cursor::Begin(data(), size()); }
+	template<size_t Size> inline typename BasicHString<Size>::const_cursor BasicHString<Size>::cursor_end() const { return const_cursor::End(data(), size()); }
+	template<size_t Size> inline typename BasicHString<Size>::const_iterator BasicHString<Size>::iter() const { return const_cursor::Begin(data(), size()).as_iter(); }
+	template<size_t Size> inline typename BasicHString<Size>::const_reverse_iterator BasicHString<Size>::iter_inv() const { return const_cursor::End(data(), size()).as_iter_inv(); }
+	template<size_t Size> inline typename BasicHString<Size>::const_range BasicHString<Size>::range() const { return const_cursor::Begin(data(), size()).as_range(); }
+	template<size_t Size> inline typename BasicHString<Size>::const_reverse_range BasicHString<Size>::range_inv() const { return const_cursor::End(data(), size()).as_range_inv(); }
 }
 
 // size
 namespace hana
 {
-	inline bool HString::empty() const noexcept {
+	template<size_t Size>
+	inline bool BasicHString<Size>::empty() const noexcept {
 		return !size();
 	}
 
-	inline HString::size_type HString::length() const noexcept {
+	template<size_t Size>
+	inline typename BasicHString<Size>::size_type BasicHString<Size>::length() const noexcept {
 		return size();
 	}
 
-	inline HString::size_type HString::text_length() const noexcept {
+	template<size_t Size>
+	inline typename BasicHString<Size>::size_type BasicHString<Size>::text_length() const noexcept {
 		return HStringView(*this).text_length();
 	}
 
-	inline HString::size_type HString::capacity() const noexcept {
-		return is_sso() ? SSOCapacity : capacity_;
+	template<size_t Size>
+	inline typename BasicHString<Size>::size_type BasicHString<Size>::capacity() const noexcept {
+		return is_sso() ? SSOCapacity : heap_.capacity();
 	}
 
-	inline HString::size_type HString::slack() const noexcept {
+	template<size_t Size>
+	inline typename BasicHString<Size>::size_type BasicHString<Size>::slack() const noexcept {
 		return capacity() - size();
 	}
 
-	inline HString::size_type HString::size() const noexcept {
-		return is_sso() ? sso_size_ : size_;
+	template<size_t Size>
+	inline typename BasicHString<Size>::size_type BasicHString<Size>::size() const noexcept {
+		return is_sso() ? sso_size_ : heap_.size();
 	}
 
-	inline HString::size_type HString::max_size() const noexcept {
-		return HStringView(*this).max_size();
+	template<size_t Size>
+	inline typename BasicHString<Size>::size_type BasicHString<Size>::max_size() const noexcept {
+		return std::min<size_type>(HStringView(*this).max_size(), Heap::max_capacity);
 	}
 
+	template<size_t Size>
 	template<is_char_v Char>
-	HString::size_type HString::to_size() const noexcept {
+	typename BasicHString<Size>::size_type BasicHString<Size>::to_size() const noexcept {
 		return HStringView(*this).to_size<Char>();
 	}
 }
@@ -632,111 +982,145 @@ namespace hana
 // access
 namespace hana
 {
-	inline HString::reference HString::at(size_type pos) {
+	template<size_t Size>
+	inline typename BasicHString<Size>::reference BasicHString<Size>::at(size_type pos) {
 		assert(is_valid_index(pos));
 		return data()[pos];
 	}
 
-	inline HString::reference HString::operator[](size_type pos) {
+	template<size_t Size>
+	inline typename BasicHString<Size>::reference BasicHString<Size>::operator[](size_type pos) {
 		return at(pos);
 	}
 
-	inline HString::reference HString::front() {
+	template<size_t Size>
+	inline typename BasicHString<Size>::reference BasicHString<Size>::front() {
 		return at(0);
 	}
 
-	inline HString::reference HString::back() {
+	template<size_t Size>
+	inline typename BasicHString<Size>::reference BasicHString<Size>::back() {
 		return at(size() - 1);
 	}
 
-	inline HString::pointer HString::data() noexcept {
-		return is_sso() ? sso_data_ : data_;
+	template<size_t Size>
+	inline typename BasicHString<Size>::pointer BasicHString<Size>::data() noexcept {
+		return is_sso() ? sso_data_ : heap_.data_;
 	}
 
-	inline HString::const_reference HString::at(size_type pos) const {
+	template<size_t Size>
+	inline typename BasicHString<Size>::const_reference BasicHString<Size>::at(size_type pos) const {
 		assert(is_valid_index(pos));
 		return data()[pos];
 	}
 
-	inline HString::const_reference HString::operator[](size_type pos) const {
+	template<size_t Size>
+	inline typename BasicHString<Size>::const_reference BasicHString<Size>::operator[](size_type pos) const {
 		return at(pos);
 	}
 
-	inline HString::const_reference HString::front() const {
+	template<size_t Size>
+	inline typename BasicHString<Size>::const_reference BasicHString<Size>::front() const {
 		return at(0);
 	}
 
-	inline HString::const_reference HString::back() const {
+	template<size_t Size>
+	inline typename BasicHString<Size>::const_reference BasicHString<Size>::back() const {
 		return at(size() - 1);
 	}
 
-	inline HString::const_pointer HString::data() const noexcept {
-		return is_sso() ? sso_data_ : data_;
+	template<size_t Size>
+	inline typename BasicHString<Size>::const_pointer BasicHString<Size>::data() const noexcept {
+		return is_sso() ? sso_data_ : heap_.data_;
 	}
 
-	inline HString::raw_reference HString::raw_at(size_type pos) {
+	template<size_t Size>
+	inline typename BasicHString<Size>::raw_reference BasicHString<Size>::raw_at(size_type pos) {
 		assert(is_valid_index(pos));
 		return raw_data()[pos];
 	}
 
-	inline HString::raw_reference HString::raw_front() {
+	template<size_t Size>
+	inline typename BasicHString<Size>::raw_reference BasicHString<Size>::raw_front() {
 		return raw_at(0);
 	}
 
-	inline HString::raw_reference HString::raw_back() {
+	template<size_t Size>
+	inline typename BasicHString<Size>::raw_reference BasicHString<Size>::raw_back() {
 		return raw_at(size() - 1);
 	}
 
-	inline HString::raw_pointer HString::raw_data() noexcept {
+	template<size_t Size>
+	inline typename BasicHString<Size>::raw_pointer BasicHString<Size>::raw_data() noexcept {
 		return reinterpret_cast<raw_pointer>(data());
 	}
 
-	inline HString::raw_const_reference HString::raw_at(size_type pos) const {
+	template<size_t Size>
+	inline typename BasicHString<Size>::raw_const_reference BasicHString<Size>::raw_at(size_type pos) const {
 		assert(is_valid_index(pos));
 		return raw_data()[pos];
 	}
 
-	inline HString::raw_const_reference HString::raw_front() const {
+	template<size_t Size>
+	inline typename BasicHString<Size>::raw_const_reference BasicHString<Size>::raw_front() const {
 		return raw_at(0);
 	}
 
-	inline HString::raw_const_reference HString::raw_back() const {
+	template<size_t Size>
+	inline typename BasicHString<Size>::raw_const_reference BasicHString<Size>::raw_back() const {
 		return raw_at(size() - 1);
 	}
 
-	inline HString::raw_const_pointer HString::raw_data() const noexcept {
+	template<size_t Size>
+	inline typename BasicHString<Size>::raw_const_pointer BasicHString<Size>::raw_data() const noexcept {
 		return reinterpret_cast<raw_const_pointer>(data());
 	}
 
-	inline HString::const_pointer HString::c_str() const noexcept {
+	template<size_t Size>
+	inline typename BasicHString<Size>::const_pointer BasicHString<Size>::c_str() const noexcept {
 		return data();
 	}
 
-	inline unicode::UTF8Seq HString::at_text(size_type index) const {
+	template<size_t Size>
+	inline unicode::UTF8Seq BasicHString<Size>::at_text(size_type index) const {
 		return HStringView(*this).at_text(index);
 	}
 
-	inline unicode::UTF8Seq HString::last_text(size_type index) const {
+	template<size_t Size>
+	inline unicode::UTF8Seq BasicHString<Size>::last_text(size_type index) const {
 		return HStringView(*this).last_text(index);
 	}
 
-	inline bool HString::is_sso() const noexcept {
+	template<size_t Size>
+	inline bool BasicHString<Size>::is_sso() const noexcept {
 		return sso_flag_;
 	}
 
-	inline bool HString::is_heap() const noexcept {
+	template<size_t Size>
+	inline bool BasicHString<Size>::is_heap() const noexcept {
 		return !sso_flag_;
 	}
 
-	inline bool HString::is_valid_index(size_type index) const noexcept {
+	template<size_t Size>
+	inline std::pmr::memory_resource* BasicHString<Size>::memory_resource() const noexcept {
+		if (is_sso() || !heap_.resource()) {
+			return nullptr;
+		}
+		return *reinterpret_cast<std::pmr::memory_resource* const*>(heap_.data_ - sizeof(std::pmr::memory_resource*));
+	}
+
+	template<size_t Size>
+	inline bool BasicHString<Size>::is_valid_index(size_type index) const noexcept {
 		return HStringView(*this).is_valid_index(index);
 	}
 
-	inline HString::size_type HString::buffer_index_to_text(size_type index) const noexcept {
+	template<size_t Size>
+	inline typename BasicHString<Size>::size_type BasicHString<Size>::buffer_index_to_text(size_type index) const noexcept {
 		return HStringView(*this).buffer_index_to_text(index);
 	}
 
-	inline HString::size_type HString::text_index_to_buffer(size_type index) const noexcept {
+	template<size_t Size>
+	inline typename BasicHString<Size>::size_type BasicHString<Size>::text_index_to_buffer(size_type index) const noexcept {
 		return HStringView(*this).text_index_to_buffer(index);
 	}
 }
@@ -744,39 +1128,47 @@ namespace hana
 // substr
 namespace hana
 {
-	inline HString::operator HStringView() const noexcept {
+	template<size_t Size>
+	inline BasicHString<Size>::operator HStringView() const noexcept {
 		return {data(), size()};
 	}
 
-	inline HStringView HString::first_view(size_type count) const {
+	template<size_t Size>
+	inline HStringView BasicHString<Size>::first_view(size_type count) const {
 		return HStringView(*this).first_view(count);
 	}
 
-	inline HStringView HString::last_view(size_type count) const {
+	template<size_t Size>
+	inline HStringView BasicHString<Size>::last_view(size_type count) const {
 		return HStringView(*this).last_view(count);
 	}
 
-	inline HStringView HString::subview(size_type start, size_type count) const noexcept {
+	template<size_t Size>
+	inline HStringView BasicHString<Size>::subview(size_type start, size_type count) const noexcept {
 		return HStringView(*this).subview(start, count);
 	}
 
-	inline HString HString::first_str(size_type count) const {
-		return HString{first_view(count)};
+	template<size_t Size>
+	inline BasicHString<Size> BasicHString<Size>::first_str(size_type count) const {
+		return BasicHString{first_view(count)};
 	}
 
-	inline HString HString::last_str(size_type count) const {
-		return HString{last_view(count)};
+	template<size_t Size>
+	inline BasicHString<Size> BasicHString<Size>::last_str(size_type count) const {
+		return BasicHString{last_view(count)};
 	}
 
-	inline HString HString::substr(size_type pos, size_type count) const {
-		return HString{subview(pos, count)};
+	template<size_t Size>
+	inline BasicHString<Size> BasicHString<Size>::substr(size_type pos, size_type count) const {
+		return BasicHString{subview(pos, count)};
 	}
 }
 
 // add
 namespace hana
 {
-	inline HString& HString::insert(size_type index, unicode::UTF8Seq seq) {
+	template<size_t Size>
+	inline BasicHString<Size>& BasicHString<Size>::insert(size_type index, unicode::UTF8Seq seq) {
 		assert(index <= size());
 		if (seq.is_valid()) {
 			return insert(index, HStringView{seq.data, seq.len});
@@ -784,46 +1176,56 @@ namespace hana
 		return *this;
 	}
 
-	inline HString& HString::insert(size_type index, const wchar_t* str) {
+	template<size_t Size>
+	inline BasicHString<Size>& BasicHString<Size>::insert(size_type index, const wchar_t* str) {
 		return insert(index, reinterpret_cast<internal::const_wchar_ptr>(str));
 	}
 
-	inline HString& HString::append(unicode::UTF8Seq seq) {
+	template<size_t Size>
+	inline BasicHString<Size>& BasicHString<Size>::append(unicode::UTF8Seq seq) {
 		if (seq.is_valid()) {
 			return append(HStringView(seq.data, seq.len));
 		}
 		return *this;
 	}
 
-	inline HString& HString::append(const wchar_t* str) {
+	template<size_t Size>
+	inline BasicHString<Size>& BasicHString<Size>::append(const wchar_t* str) {
 		return append(reinterpret_cast<internal::const_wchar_ptr>(str));
 	}
 
-	inline HString& HString::push_back(value_type ch) {
+	template<size_t Size>
+	inline BasicHString<Size>& BasicHString<Size>::push_back(value_type ch) {
 		return append(1, ch);
 	}
 
-	inline void HString::operator+=(value_type ch) {
+	template<size_t Size>
+	inline void BasicHString<Size>::operator+=(value_type ch) {
 		push_back(ch);
 	}
 
-	inline void HString::operator+=(unicode::UTF8Seq seq) {
+	template<size_t Size>
+	inline void BasicHString<Size>::operator+=(unicode::UTF8Seq seq) {
 		append(seq);
 	}
 
-	inline void HString::operator+=(HStringView view) {
+	template<size_t Size>
+	inline void BasicHString<Size>::operator+=(HStringView view) {
 		append(view);
 	}
 
-	inline void HString::operator+=(const char16_t* str) {
+	template<size_t Size>
+	inline void BasicHString<Size>::operator+=(const char16_t* str) {
 		append(str);
 	}
 
-	inline void HString::operator+=(const char32_t* str) {
+	template<size_t Size>
+	inline void BasicHString<Size>::operator+=(const char32_t* str) {
 		append(str);
 	}
 
-	inline void HString::operator+=(const wchar_t* str) {
+	template<size_t Size>
+	inline void BasicHString<Size>::operator+=(const wchar_t* str) {
 		append(str);
 	}
 }
@@ -831,43 +1233,52 @@ namespace hana
 // replace
 namespace hana
 {
-	inline HString& HString::replace(size_type pos, size_type count, HStringView view) {
+	template<size_t Size>
+	inline BasicHString<Size>& BasicHString<Size>::replace(size_type pos, size_type count, HStringView view) {
 		return replace(pos, count, view.data(), view.size());
 	}
 
-	inline HString HString::Replace(size_type pos, size_type count, const_pointer cstr, size_type count2) const {
-		return HString(*this).replace(pos, count, cstr, count2);
+	template<size_t Size>
+	inline BasicHString<Size> BasicHString<Size>::Replace(size_type pos, size_type count, const_pointer cstr, size_type count2) const {
+		return BasicHString(*this).replace(pos, count, cstr, count2);
 	}
 
-	inline HString HString::Replace(size_type pos, size_type count, HStringView view) const {
-		return HString(*this).replace(pos, count, view);
+	template<size_t Size>
+	inline BasicHString<Size> BasicHString<Size>::Replace(size_type pos, size_type count, HStringView view) const {
+		return BasicHString(*this).replace(pos, count, view);
 	}
 }
 
 // starts with
 namespace hana
 {
-	inline bool HString::starts_with(HStringView sv) const noexcept {
+	template<size_t Size>
+	inline bool BasicHString<Size>::starts_with(HStringView sv) const noexcept {
 		return HStringView(*this).starts_with(sv);
 	}
 
-	inline bool HString::starts_with(value_type ch) const noexcept {
+	template<size_t Size>
+	inline bool BasicHString<Size>::starts_with(value_type ch) const noexcept {
 		return HStringView(*this).starts_with(ch);
 	}
 
-	inline bool HString::starts_with(unicode::UTF8Seq seq) const {
+	template<size_t Size>
+	inline bool BasicHString<Size>::starts_with(unicode::UTF8Seq seq) const {
 		return HStringView(*this).starts_with(seq);
 	}
 
-	inline bool HString::ends_with(HStringView sv) const noexcept {
+	template<size_t Size>
+	inline bool BasicHString<Size>::ends_with(HStringView sv) const noexcept {
 		return HStringView(*this).ends_with(sv);
 	}
 
-	inline bool HString::ends_with(value_type ch) const noexcept {
+	template<size_t Size>
+	inline bool BasicHString<Size>::ends_with(value_type ch) const noexcept {
 		return HStringView(*this).ends_with(ch);
 	}
 
-	inline bool HString::ends_with(unicode::UTF8Seq seq) const {
+	template<size_t Size>
+	inline bool BasicHString<Size>::ends_with(unicode::UTF8Seq seq) const {
 		return HStringView(*this).ends_with(seq);
 	}
 }
@@ -875,23 +1286,28 @@ namespace hana
 // contains & count
 namespace hana
 {
-	inline bool HString::contains(HStringView sv) const noexcept {
+	template<size_t Size>
+	inline bool BasicHString<Size>::contains(HStringView sv) const noexcept {
 		return HStringView(*this).contains(sv);
 	}
 
-	inline bool HString::contains(value_type ch) const noexcept {
+	template<size_t Size>
+	inline bool BasicHString<Size>::contains(value_type ch) const noexcept {
 		return HStringView(*this).contains(ch);
 	}
 
-	inline bool HString::contains(unicode::UTF8Seq seq) const {
+	template<size_t Size>
+	inline bool BasicHString<Size>::contains(unicode::UTF8Seq seq) const {
 		return HStringView(*this).contains(seq);
 	}
 
-	inline HString::size_type HString::count(HStringView pattern) const {
+	template<size_t Size>
+	inline typename BasicHString<Size>::size_type BasicHString<Size>::count(HStringView pattern) const {
 		return HStringView(*this).count(pattern);
 	}
 
-	inline HString::size_type HString::count(unicode::UTF8Seq seq) const {
+	template<size_t Size>
+	inline typename BasicHString<Size>::size_type BasicHString<Size>::count(unicode::UTF8Seq seq) const {
 		return HStringView(*this).count(seq);
 	}
 }
@@ -899,15 +1315,15 @@ namespace hana
 // find
 namespace hana
 {
-#define HANA_STRING_FIND(name)																																\
-	inline HString::data_reference HString::name(HStringView v, size_type pos) noexcept { return HStringView(*this).name(v, pos); }							\
-	inline HString::data_reference HString::name(value_type ch, size_type pos) noexcept { return HStringView(*this).name(ch, pos); }						\
-	inline HString::data_reference HString::name(unicode::UTF8Seq seq, size_type pos) { return HStringView(*this).name(seq, pos); }							\
-	inline HString::data_reference HString::name(const_pointer s, size_type pos, size_type count) { return HStringView(*this).name(s, pos, count); }		\
-	inline HString::const_data_reference HString::name(HStringView v, size_type pos) const noexcept { return HStringView(*this).name(v, pos); }				\
-	inline HString::const_data_reference HString::name(value_type ch, size_type pos) const noexcept { return HStringView(*this).name(ch, pos); }			\
-	inline HString::const_data_reference HString::name(unicode::UTF8Seq seq, size_type pos) const { return HStringView(*this).name(seq, pos); }				\
-	inline HString::const_data_reference HString::name(const_pointer s, size_type pos, size_type count) const { return HStringView(*this).name(s, pos, count); }
+#define HANA_STRING_FIND(name)																																									\
+	template<size_t Size> inline typename BasicHString<Size>::data_reference BasicHString<Size>::name(HStringView v, size_type pos) noexcept { return HStringView(*this).name(v, pos); }							\
+	template<size_t Size> inline typename BasicHString<Size>::data_reference BasicHString<Size>::name(value_type ch, size_type pos) noexcept { return HStringView(*this).name(ch, pos); }						\
+	template<size_t Size> inline typename BasicHString<Size>::data_reference BasicHString<Size>::name(unicode::UTF8Seq seq, size_type pos) { return HStringView(*this).name(seq, pos); }							\
+	template<size_t Size> inline typename BasicHString<Size>::data_reference BasicHString<Size>::name(const_pointer s, size_type pos, size_type count) { return HStringView(*this).name(s, pos, count); }		\
+	template<size_t Size> inline typename BasicHString<Size>::const_data_reference BasicHString<Size>::name(HStringView v, size_type pos) const noexcept { return HStringView(*this).name(v, pos); }				\
+	template<size_t Size> inline typename BasicHString<Size>::const_data_reference BasicHString<Size>::name(value_type ch, size_type pos) const noexcept { return HStringView(*this).name(ch, pos); }			\
+	template<size_t Size> inline typename BasicHString<Size>::const_data_reference BasicHString<Size>::name(unicode::UTF8Seq seq, size_type pos) const { return HStringView(*this).name(seq, pos); }				\
+	template<size_t Size> inline typename BasicHString<Size>::const_data_reference BasicHString<Size>::name(const_pointer s, size_type pos, size_type count) const { return HStringView(*this).name(s, pos, count); }
 
 	HANA_STRING_FIND(find)
 	HANA_STRING_FIND(find_first_of)
@@ -919,78 +1335,101 @@ namespace hana
 #undef HANA_STRING_FIND
 }
 
+// case
+namespace hana
+{
+	template<size_t Size> inline bool BasicHString<Size>::iequals(HStringView rhs) const noexcept { return HStringView(*this).iequals(rhs); }
+	template<size_t Size> inline int BasicHString<Size>::icompare(HStringView rhs) const noexcept { return HStringView(*this).icompare(rhs); }
+	template<size_t Size> inline typename BasicHString<Size>::data_reference BasicHString<Size>::ifind(HStringView pattern, size_type pos) noexcept { return HStringView(*this).ifind(pattern, pos); }
+	template<size_t Size> inline typename BasicHString<Size>::const_data_reference BasicHString<Size>::ifind(HStringView pattern, size_type pos) const noexcept { return HStringView(*this).ifind(pattern, pos); }
+}
+
 // remove prefix & prefix
 namespace hana
 {
-	inline HString& HString::remove_prefix(size_type n) {
+	template<size_t Size>
+	inline BasicHString<Size>& BasicHString<Size>::remove_prefix(size_type n) {
 		return erase(0, n);
 	}
 
-	inline HString& HString::remove_prefix(HStringView prefix) {
+	template<size_t Size>
+	inline BasicHString<Size>& BasicHString<Size>::remove_prefix(HStringView prefix) {
 		if (starts_with(prefix)) {
 			return erase(0, prefix.size());
 		}
 		return *this;
 	}
 
-	inline HString& HString::remove_prefix(unicode::UTF8Seq prefix) {
+	template<size_t Size>
+	inline BasicHString<Size>& BasicHString<Size>::remove_prefix(unicode::UTF8Seq prefix) {
 		if (prefix.is_valid()) {
 			return remove_prefix(HStringView(prefix.data, prefix.len));
 		}
 		return *this;
 	}
 
-	inline HString& HString::remove_suffix(size_type n) {
+	template<size_t Size>
+	inline BasicHString<Size>& BasicHString<Size>::remove_suffix(size_type n) {
 		return erase(size() - n);
 	}
 
-	inline HString& HString::remove_suffix(HStringView suffix) {
+	template<size_t Size>
+	inline BasicHString<Size>& BasicHString<Size>::remove_suffix(HStringView suffix) {
 		if (ends_with(suffix)) {
 			return erase(size() - suffix.size());
 		}
 		return *this;
 	}
 
-	inline HString& HString::remove_suffix(unicode::UTF8Seq suffix) {
+	template<size_t Size>
+	inline BasicHString<Size>& BasicHString<Size>::remove_suffix(unicode::UTF8Seq suffix) {
 		if (suffix.is_valid()) {
 			return remove_suffix(HStringView(suffix.data, suffix.len));
 		}
 		return *this;
 	}
 
-	inline HString HString::RemovePrefix(size_type n) const {
-		return HString{HStringView(*this).RemovePrefix(n)};
+	template<size_t Size>
+	inline BasicHString<Size> BasicHString<Size>::RemovePrefix(size_type n) const {
+		return BasicHString{HStringView(*this).RemovePrefix(n)};
 	}
 
-	inline HString HString::RemovePrefix(HStringView prefix) const {
-		return HString{HStringView(*this).RemovePrefix(prefix)};
+	template<size_t Size>
+	inline BasicHString<Size> BasicHString<Size>::RemovePrefix(HStringView prefix) const {
+		return BasicHString{HStringView(*this).RemovePrefix(prefix)};
 	}
 
-	inline HString HString::RemovePrefix(unicode::UTF8Seq prefix) const {
-		return HString{HStringView(*this).RemovePrefix(prefix)};
+	template<size_t Size>
+	inline BasicHString<Size> BasicHString<Size>::RemovePrefix(unicode::UTF8Seq prefix) const {
+		return BasicHString{HStringView(*this).RemovePrefix(prefix)};
 	}
 
-	inline HString HString::RemoveSuffix(size_type n) const {
-		return HString{HStringView(*this).RemoveSuffix(n)};
+	template<size_t Size>
+	inline BasicHString<Size> BasicHString<Size>::RemoveSuffix(size_type n) const {
+		return BasicHString{HStringView(*this).RemoveSuffix(n)};
 	}
 
-	inline HString HString::RemoveSuffix(HStringView suffix) const {
-		return HString{HStringView(*this).RemoveSuffix(suffix)};
+	template<size_t Size>
+	inline BasicHString<Size> BasicHString<Size>::RemoveSuffix(HStringView suffix) const {
+		return BasicHString{HStringView(*this).RemoveSuffix(suffix)};
 	}
 
-	inline HString HString::RemoveSuffix(unicode::UTF8Seq suffix) const {
-		return HString{HStringView(*this).RemoveSuffix(suffix)};
+	template<size_t Size>
+	inline BasicHString<Size> BasicHString<Size>::RemoveSuffix(unicode::UTF8Seq suffix) const {
+		return BasicHString{HStringView(*this).RemoveSuffix(suffix)};
 	}
 }
 
 // partition
 namespace hana
 {
-	inline std::array<HStringView, 3> HString::partition(HStringView delimiter) const {
+	template<size_t Size>
+	inline std::array<HStringView, 3> BasicHString<Size>::partition(HStringView delimiter) const {
 		return HStringView(*this).partition(delimiter);
 	}
 
-	inline std::array<HStringView, 3> HString::partition(unicode::UTF8Seq delimiter) const {
+	template<size_t Size>
+	inline std::array<HStringView, 3> BasicHString<Size>::partition(unicode::UTF8Seq delimiter) const {
 		return HStringView(*this).partition(delimiter);
 	}
 }
@@ -998,131 +1437,207 @@ namespace hana
 // trim
 namespace hana
 {
-	inline HString& HString::trim(HStringView characters) {
+	template<size_t Size>
+	inline BasicHString<Size>& BasicHString<Size>::trim(HStringView characters) {
 		return trim_start(characters).trim_end(characters);
 	}
 
-	inline HString& HString::trim_start(HStringView characters) {
+	template<size_t Size>
+	inline BasicHString<Size>& BasicHString<Size>::trim_start(HStringView characters) {
 		auto target = HStringView(*this).trim_start(characters);
 		auto count = size() - target.size();
 		return count ? erase(0, count) : *this;
 	}
 
-	inline HString& HString::trim_end(HStringView characters) {
+	template<size_t Size>
+	inline BasicHString<Size>& BasicHString<Size>::trim_end(HStringView characters) {
 		auto target = HStringView(*this).trim_end(characters);
 		return target.size() == size() ? *this : erase(target.size());
 	}
 
-	inline HString& HString::trim(unicode::UTF8Seq seq) {
+	template<size_t Size>
+	inline BasicHString<Size>& BasicHString<Size>::trim(unicode::UTF8Seq seq) {
 		if (seq.is_valid()) {
 			return trim(HStringView(seq.data, seq.len));
 		}
 		return *this;
 	}
 
-	inline HString& HString::trim_start(unicode::UTF8Seq seq) {
+	template<size_t Size>
+	inline BasicHString<Size>& BasicHString<Size>::trim_start(unicode::UTF8Seq seq) {
 		if (seq.is_valid()) {
 			return trim_start(HStringView(seq.data, seq.len));
 		}
 		return *this;
 	}
 
-	inline HString& HString::trim_end(unicode::UTF8Seq seq) {
+	template<size_t Size>
+	inline BasicHString<Size>& BasicHString<Size>::trim_end(unicode::UTF8Seq seq) {
 		if (seq.is_valid()) {
 			return trim_end(HStringView(seq.data, seq.len));
 		}
 		return *this;
 	}
 
-	inline HString& HString::trim_invalid() {
+	template<size_t Size>
+	inline BasicHString<Size>& BasicHString<Size>::trim_invalid() {
 		return trim_invalid_start().trim_invalid_end();
 	}
 
-	inline HString& HString::trim_invalid_start() {
+	template<size_t Size>
+	inline BasicHString<Size>& BasicHString<Size>::trim_invalid_start() {
 		auto target = HStringView(*this).trim_invalid_start();
 		auto count = size() - target.size();
 		return count ? erase(0, count) : *this;
 	}
 
-	inline HString& HString::trim_invalid_end() {
+	template<size_t Size>
+	inline BasicHString<Size>& BasicHString<Size>::trim_invalid_end() {
 		auto target = HStringView(*this).trim_invalid_end();
 		return target.size() == size() ? *this : erase(target.size());
 	}
 
-	inline HString HString::Trim(HStringView characters) const {
-		return HString{HStringView(*this).trim(characters)};
+	template<size_t Size>
+	inline BasicHString<Size> BasicHString<Size>::Trim(HStringView characters) const {
+		return BasicHString{HStringView(*this).trim(characters)};
 	}
 
-	inline HString HString::TrimStart(HStringView characters) const {
-		return HString{HStringView(*this).trim_start(characters)};
+	template<size_t Size>
+	inline BasicHString<Size> BasicHString<Size>::TrimStart(HStringView characters) const {
+		return BasicHString{HStringView(*this).trim_start(characters)};
 	}
 
-	inline HString HString::TrimEnd(HStringView characters) const {
-		return HString{HStringView(*this).trim_end(characters)};
+	template<size_t Size>
+	inline BasicHString<Size> BasicHString<Size>::TrimEnd(HStringView characters) const {
+		return BasicHString{HStringView(*this).trim_end(characters)};
 	}
 
-	inline HString HString::Trim(unicode::UTF8Seq seq) const {
-		return HString{HStringView(*this).trim(seq)};
+	template<size_t Size>
+	inline BasicHString<Size> BasicHString<Size>::Trim(unicode::UTF8Seq seq) const {
+		return BasicHString{HStringView(*this).trim(seq)};
 	}
 
-	inline HString HString::TrimStart(unicode::UTF8Seq seq) const {
-		return HString{HStringView(*this).trim_start(seq)};
+	template<size_t Size>
+	inline BasicHString<Size> BasicHString<Size>::TrimStart(unicode::UTF8Seq seq) const {
+		return BasicHString{HStringView(*this).trim_start(seq)};
 	}
 
-	inline HString HString::TrimEnd(unicode::UTF8Seq seq) const {
-		return HString{HStringView(*this).trim_end(seq)};
+	template<size_t Size>
+	inline BasicHString<Size> BasicHString<Size>::TrimEnd(unicode::UTF8Seq seq) const {
+		return BasicHString{HStringView(*this).trim_end(seq)};
 	}
 
-	inline HString HString::TrimInvalid() const {
-		return HString{HStringView(*this).trim_invalid()};
+	template<size_t Size>
+	inline BasicHString<Size> BasicHString<Size>::TrimInvalid() const {
+		return BasicHString{HStringView(*this).trim_invalid()};
 	}
 
-	inline HString HString::TrimInvalidStart() const {
-		return HString{HStringView(*this).trim_invalid_start()};
+	template<size_t Size>
+	inline BasicHString<Size> BasicHString<Size>::TrimInvalidStart() const {
+		return BasicHString{HStringView(*this).trim_invalid_start()};
 	}
 
-	inline HString HString::TrimInvalidEnd() const {
-		return HString{HStringView(*this).trim_invalid_end()};
+	template<size_t Size>
+	inline BasicHString<Size> BasicHString<Size>::TrimInvalidEnd() const {
+		return BasicHString{HStringView(*this).trim_invalid_end()};
 	}
 }
 
 // split
 namespace hana
 {
+	template<size_t Size>
 	template<internal::CanAdd<HStringView> Buffer>
-	HString::size_type HString::split(Buffer& out, HStringView delimiter, bool cull_empty, size_type limit) const {
+	typename BasicHString<Size>::size_type BasicHString<Size>::split(Buffer& out, HStringView delimiter, bool cull_empty, size_type limit) const {
 		return HStringView(*this).split(out, delimiter, cull_empty, limit);
 	}
 
+	template<size_t Size>
 	template<std::invocable<HStringView> F>
-	HString::size_type HString::split_each(F&& func, HStringView delimiter, bool cull_empty, size_type limit) const {
+	typename BasicHString<Size>::size_type BasicHString<Size>::split_each(F&& func, HStringView delimiter, bool cull_empty, size_type limit) const {
 		return HStringView(*this).split(std::forward<F>(func), delimiter, cull_empty, limit);
 	}
 
+	template<size_t Size>
 	template<internal::CanAdd<HStringView> Buffer>
-	HString::size_type HString::split(Buffer& out, unicode::UTF8Seq delimiter, bool cull_empty, size_type limit) const {
+	typename BasicHString<Size>::size_type BasicHString<Size>::split(Buffer& out, unicode::UTF8Seq delimiter, bool cull_empty, size_type limit) const {
 		return HStringView(*this).split(out, delimiter, cull_empty, limit);
 	}
 
+	template<size_t Size>
 	template<std::invocable<HStringView> F>
-	HString::size_type HString::split_each(F&& func, unicode::UTF8Seq delimiter, bool cull_empty, size_type limit) const {
+	typename BasicHString<Size>::size_type BasicHString<Size>::split_each(F&& func, unicode::UTF8Seq delimiter, bool cull_empty, size_type limit) const {
 		return HStringView(*this).split(std::forward<F>(func), delimiter, cull_empty, limit);
 	}
+
+	template<size_t Size>
+	inline internal::StringPieceRange<internal::SplitCutter> BasicHString<Size>::split_view(HStringView delimiter, bool cull_empty) const& noexcept {
+		return HStringView(*this).split_view(delimiter, cull_empty);
+	}
+
+	template<size_t Size>
+	inline internal::StringPieceRange<internal::TokenCutter> BasicHString<Size>::tokens(HStringView separators) const& noexcept {
+		return HStringView(*this).tokens(separators);
+	}
+
+	template<size_t Size>
+	inline internal::StringPieceRange<internal::LineCutter> BasicHString<Size>::lines() const& noexcept {
+		return HStringView(*this).lines();
+	}
 }
 
 // misc
 namespace hana
 {
-	inline void HString::release(size_type reserve_capacity) {
+	template<size_t Size>
+	inline void BasicHString<Size>::release(size_type reserve_capacity) {
 		reserve(reserve_capacity);
 		clear();
 	}
 
-	inline void HString::swap(HString& other) noexcept {
+	template<size_t Size>
+	template<typename Op>
+	void BasicHString<Size>::resize_and_overwrite(size_type count, Op op) {
+		reserve(count);
+		const size_type new_size = std::move(op)(data(), count);
+		assert(new_size <= count && "undefined behavior writing past count");
+		set_size(new_size);
+	}
+
+	template<size_t Size>
+	inline BasicHString<Size> BasicHString<Size>::adopt(pointer data, size_type size, size_type capacity) noexcept {
+		assert(size < capacity && size > SSOCapacity);
+		BasicHString result;
+		result.heap_.set(data, size, capacity - 1, false);
+		result.sso_flag_ = 0;
+		data[size] = 0;
+		return result;
+	}
+
+	template<size_t Size>
+	inline void BasicHString<Size>::reset() noexcept {
+		std::memset(buffer_, 0, SSOBufferSize);
+		sso_flag_ = 1;
+	}
+
+	template<size_t Size>
+	inline void BasicHString<Size>::set_size(size_type value) noexcept {
+		if (is_sso()) {
+			sso_data_[value] = 0;
+			sso_size_ = value;
+		} else {
+			heap_.data_[value] = 0;
+			heap_.set_size(value);
+		}
+	}
+
+	template<size_t Size>
+	inline void BasicHString<Size>::swap(BasicHString& other) noexcept {
 		std::swap(buffer_, other.buffer_);
 	}
 
-	inline HString& HString::reverse(size_type start, size_type count) {
+	template<size_t Size>
+	inline BasicHString<Size>& BasicHString<Size>::reverse(size_type start, size_type count) {
 		assert(is_valid_index(start) && "undefined behaviour accessing out of bounds");
 		assert(count == npos || count <= size() - start && "undefined behaviour exceeding size of string view");
 		count = count == npos ? size() - start : count;
@@ -1131,7 +1646,8 @@ namespace hana
 		return *this;
 	}
 
-	inline HString::size_type HString::copy(pointer dest, size_type count, size_type pos) const {
+	template<size_t Size>
+	inline typename BasicHString<Size>::size_type BasicHString<Size>::copy(pointer dest, size_type count, size_type pos) const {
 		return HStringView(*this).copy(dest, count, pos);
 	}
 }
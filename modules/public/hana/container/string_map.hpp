@@ -0,0 +1,21 @@
+#pragma once
+
+#include "hana/container/string.hpp"
+#include "hana/utility/hash.hpp"
+
+#include <parallel_hashmap/phmap.h>
+
+namespace hana
+{
+	/*!
+	 * @brief Flat hash map keyed by HString, searchable with any char or char8_t string.
+	 *
+	 * find, contains, count and erase take an HStringView, a literal or a std::string as is and never allocate a
+	 * temporary key; only inserting a missing key builds an HString.
+	 */
+	template<typename V>
+	using HStringMap = phmap::flat_hash_map<HString, V, StringHash, StringEqualTo>;
+
+	//! @brief Flat hash set of HString with the same heterogeneous lookup as HStringMap.
+	using HStringSet = phmap::flat_hash_set<HString, StringHash, StringEqualTo>;
+}
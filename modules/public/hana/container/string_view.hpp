@@ -2,6 +2,56 @@
 
 #include "hana/unicode/iterator.hpp"
 
+#include <ranges>
+
+namespace hana::internal
+{
+	// Runtime search kernels (SSE2/AVX2/NEON picked by cpu features), std::u8string_view is used in constant evaluation.
+	// return: index of the first match at or after pos, npos if there is none
+	HANA_BASE_API size_t string_find(const char8_t* str, size_t size, const char8_t* pattern, size_t count, size_t pos) noexcept;
+	HANA_BASE_API size_t string_find_first_of(const char8_t* str, size_t size, const char8_t* set, size_t count, size_t pos) noexcept;
+	HANA_BASE_API size_t string_find_first_not_of(const char8_t* str, size_t size, const char8_t* set, size_t count, size_t pos) noexcept;
+
+	constexpr size_t view_find(std::u8string_view str, std::u8string_view pattern, size_t pos) noexcept {
+		if (std::is_constant_evaluated()) {
+			return str.find(pattern, pos);
+		}
+		return string_find(str.data(), str.size(), pattern.data(), pattern.size(), pos);
+	}
+
+	constexpr size_t view_find_first_of(std::u8string_view str, std::u8string_view set, size_t pos) noexcept {
+		if (std::is_constant_evaluated()) {
+			return str.find_first_of(set, pos);
+		}
+		return string_find_first_of(str.data(), str.size(), set.data(), set.size(), pos);
+	}
+
+	constexpr size_t view_find_first_not_of(std::u8string_view str, std::u8string_view set, size_t pos) noexcept {
+		if (std::is_constant_evaluated()) {
+			return str.find_first_not_of(set, pos);
+		}
+		return string_find_first_not_of(str.data(), str.size(), set.data(), set.size(), pos);
+	}
+
+	// backward searches stay with the standard library
+	constexpr size_t view_rfind(std::u8string_view str, std::u8string_view pattern, size_t pos) noexcept {
+		return str.rfind(pattern, pos);
+	}
+
+	constexpr size_t view_find_last_of(std::u8string_view str, std::u8string_view set, size_t pos) noexcept {
+		return str.find_last_of(set, pos);
+	}
+
+	constexpr size_t view_find_last_not_of(std::u8string_view str, std::u8string_view set, size_t pos) noexcept {
+		return str.find_last_not_of(set, pos);
+	}
+
+	template<typename Cutter> class StringPieceRange;
+	struct SplitCutter;
+	struct TokenCutter;
+	struct LineCutter;
+}
+
 namespace hana
 {
 	/*!
@@ -200,6 +250,13 @@ namespace hana
 		constexpr const_data_reference find_last_not_of(unicode::UTF8Seq pattern, size_type pos = npos) const;
 		constexpr const_data_reference find_last_not_of(const_pointer s, size_type pos, size_type count) const;
 
+		//==================> case-insensitive <==================
+
+		// compare the simple case folding of the code points (unicode::casefold), ill-formed code units only match themselves
+		bool iequals(HStringView rhs) const noexcept;
+		int icompare(HStringView rhs) const noexcept;
+		const_data_reference ifind(HStringView pattern, size_type pos = 0) const noexcept;
+
 		//==================> partition <==================
 
 		constexpr std::array<HStringView, 3> partition(HStringView delimiter) const;
@@ -231,6 +288,16 @@ namespace hana
 		template<std::invocable<HStringView> F>
 		constexpr size_type split_each(F&& func, unicode::UTF8Seq delimiter, bool cull_empty = false, size_type limit = npos) const;
 
+		// Lazy forward ranges of the pieces, nothing is allocated and iteration can stop at any piece. The pieces view this
+		// text, so the ranges stay valid as long as the text does and can be used in std::views pipelines.
+
+		//! the pieces split() produces, an empty delimiter gives the whole text
+		constexpr internal::StringPieceRange<internal::SplitCutter> split_view(HStringView delimiter, bool cull_empty = false) const noexcept;
+		//! non-empty runs of code units not in separators, separators are matched per code unit like find_first_of
+		constexpr internal::StringPieceRange<internal::TokenCutter> tokens(HStringView separators = u8" \t\r\n") const noexcept;
+		//! lines ended by \n or \r\n without the line break, a break at the end does not start another line
+		constexpr internal::StringPieceRange<internal::LineCutter> lines() const noexcept;
+
 		//==================> misc <==================
 
 		constexpr void swap(HStringView& v) noexcept;
@@ -241,6 +308,137 @@ namespace hana
 	};
 }
 
+namespace hana::internal
+{
+	//! a piece [begin, end) of the text and where the search for the following piece starts, npos after the last piece
+	struct StringPiece {
+		size_t begin;
+		size_t end;
+		size_t next;
+	};
+
+	struct SplitCutter {
+		HStringView delimiter;
+		bool cull_empty;
+
+		// same pieces as HStringView::split: nothing follows a delimiter that ends the text
+		constexpr StringPiece cut(HStringView text, size_t pos) const noexcept {
+			while (true) {
+				const size_t found = delimiter.empty() ? HStringView::npos : internal::view_find(text.view(), delimiter.view(), pos);
+				const size_t end = found == HStringView::npos ? text.size() : found;
+				const size_t next = found == HStringView::npos || found + delimiter.size() == text.size() ? HStringView::npos : found + delimiter.size();
+				if (!cull_empty || end != pos) {
+					return {pos, end, next};
+				}
+				if (next == HStringView::npos) {
+					return {HStringView::npos, HStringView::npos, HStringView::npos};
+				}
+				pos = next;
+			}
+		}
+	};
+
+	struct TokenCutter {
+		HStringView separators;
+
+		constexpr StringPiece cut(HStringView text, size_t pos) const noexcept {
+			const size_t begin = internal::view_find_first_not_of(text.view(), separators.view(), pos);
+			if (begin == HStringView::npos) {
+				return {HStringView::npos, HStringView::npos, HStringView::npos};
+			}
+			const size_t end = internal::view_find_first_of(text.view(), separators.view(), begin);
+			return end == HStringView::npos ? StringPiece{begin, text.size(), HStringView::npos} : StringPiece{begin, end, end};
+		}
+	};
+
+	struct LineCutter {
+		constexpr StringPiece cut(HStringView text, size_t pos) const noexcept {
+			if (pos >= text.size()) {
+				return {HStringView::npos, HStringView::npos, HStringView::npos};
+			}
+			const size_t found = internal::view_find(text.view(), u8"\n", pos);
+			const size_t end = found == HStringView::npos ? text.size() : found;
+			const size_t trimmed = end > pos && text.data()[end - 1] == u8'\r' ? end - 1 : end;
+			return {pos, trimmed, found == HStringView::npos ? HStringView::npos : found + 1};
+		}
+	};
+
+	/*!
+	 * @brief Lazy forward range over the pieces Cutter cuts from a text.
+	 *
+	 * The iterator carries the text and the cutter, so pieces outlive the range object and the range is borrowed.
+	 * Each increment runs one vectorized search from the end of the previous piece.
+	 */
+	template<typename Cutter>
+	class StringPieceRange : public std::ranges::view_interface<StringPieceRange<Cutter>> {
+	public:
+		class iterator {
+		public:
+			using value_type = HStringView;
+			using difference_type = ptrdiff_t;
+			using iterator_concept = std::forward_iterator_tag;
+			using iterator_category = std::input_iterator_tag;
+
+			constexpr iterator() noexcept = default;
+
+			constexpr iterator(HStringView text, Cutter cutter) noexcept: text_(text), cutter_(cutter) {
+				load(0);
+			}
+
+			constexpr HStringView operator*() const noexcept {
+				return text_.subview(begin_, end_ - begin_);
+			}
+
+			constexpr iterator& operator++() noexcept {
+				load(next_);
+				return *this;
+			}
+
+			constexpr iterator operator++(int) noexcept {
+				iterator old = *this;
+				++*this;
+				return old;
+			}
+
+			//! pieces start at distinct offsets, the end iterator at npos
+			constexpr bool operator==(const iterator& rhs) const noexcept {
+				return begin_ == rhs.begin_;
+			}
+
+		private:
+			constexpr void load(size_t pos) noexcept {
+				if (pos == HStringView::npos) {
+					begin_ = HStringView::npos;
+					return;
+				}
+				const StringPiece piece = cutter_.cut(text_, pos);
+				begin_ = piece.begin;
+				end_ = piece.end;
+				next_ = piece.next;
+			}
+
+			HStringView text_;
+			Cutter cutter_{};
+			size_t begin_ = HStringView::npos;
+			size_t end_ = HStringView::npos;
+			size_t next_ = HStringView::npos;
+		};
+
+		constexpr StringPieceRange() noexcept = default;
+		constexpr StringPieceRange(HStringView text, Cutter cutter) noexcept: text_(text), cutter_(cutter) {}
+
+		constexpr iterator begin() const noexcept { return {text_, cutter_}; }
+		constexpr iterator end() const noexcept { return {}; }
+
+	private:
+		HStringView text_;
+		Cutter cutter_{};
+	};
+}
+
+template<typename Cutter>
+inline constexpr bool std::ranges::enable_borrowed_range<hana::internal::StringPieceRange<Cutter>> = true;
+
 // ctor & dtor
 namespace hana
 {
@@ -312,7 +510,7 @@ namespace hana
 {
 	constexpr bool HStringView::empty() const noexcept { return data_.empty(); }
 	constexpr HStringView::size_type HStringView::length() const noexcept { return data_.length(); }
-	constexpr HStringView::size_type HStringView::text_length() const noexcept { return empty() ? 0 : unicode::utf8_code_point_index(data(), size(), size() - 1) + 1; }
+	constexpr HStringView::size_type HStringView::text_length() const noexcept { return unicode::utf8_code_point_count(data(), size()); }
 	constexpr HStringView::size_type HStringView::size() const noexcept { return data_.size(); }
 	constexpr HStringView::size_type HStringView::max_size() const noexcept { return data_.max_size(); }
 
@@ -546,19 +744,19 @@ namespace hana
 {
 #define HANA_STRING_VIEW_FIND(name)																							\
 	constexpr HStringView::const_data_reference HStringView::name(HStringView v, size_type pos) const noexcept {			\
-		if (const auto index = data_.name(v.data_, pos); index != npos) {													\
+		if (const auto index = internal::view_##name(data_, v.data_, pos); index != npos) {									\
 			return {data(), index};																							\
 		}																													\
 		return {};																											\
 	}																														\
 	constexpr HStringView::const_data_reference HStringView::name(value_type ch, size_type pos) const noexcept {			\
-		if (const auto index = data_.name(ch, pos); index != npos) {														\
+		if (const auto index = internal::view_##name(data_, {&ch, 1}, pos); index != npos) {								\
 			return {data(), index};																							\
 		}																													\
 		return {};																											\
 	}																														\
 	constexpr HStringView::const_data_reference HStringView::name(const_pointer s, size_type pos, size_type count) const {	\
-		if (const auto index = data_.name(s, pos, count); index != npos) {													\
+		if (const auto index = internal::view_##name(data_, {s, count}, pos); index != npos) {								\
 			return {data(), index};																							\
 		}																													\
 		return {};																											\
@@ -580,6 +778,25 @@ namespace hana
 #undef HANA_STRING_VIEW_FIND
 }
 
+// case-insensitive
+namespace hana
+{
+	inline bool HStringView::iequals(HStringView rhs) const noexcept {
+		return unicode::internal::utf8_iequals(data(), size(), rhs.data(), rhs.size());
+	}
+
+	inline int HStringView::icompare(HStringView rhs) const noexcept {
+		return unicode::internal::utf8_icompare(data(), size(), rhs.data(), rhs.size());
+	}
+
+	inline HStringView::const_data_reference HStringView::ifind(HStringView pattern, size_type pos) const noexcept {
+		if (const auto index = unicode::internal::utf8_ifind(data(), size(), pattern.data(), pattern.size(), pos); index != npos) {
+			return {data(), index};
+		}
+		return {};
+	}
+}
+
 // partition
 namespace hana
 {
@@ -664,6 +881,9 @@ namespace hana
 	}
 
 	constexpr HStringView HStringView::trim_invalid() const {
+		if (!empty() && unicode::utf8_validate(data(), size())) {
+			return *this;
+		}
 		return trim_invalid_start().trim_invalid_end();
 	}
 
@@ -792,6 +1012,18 @@ namespace hana
 			limit
 		);
 	}
+
+	constexpr internal::StringPieceRange<internal::SplitCutter> HStringView::split_view(HStringView delimiter, bool cull_empty) const noexcept {
+		return {*this, {delimiter, cull_empty}};
+	}
+
+	constexpr internal::StringPieceRange<internal::TokenCutter> HStringView::tokens(HStringView separators) const noexcept {
+		return {*this, {separators}};
+	}
+
+	constexpr internal::StringPieceRange<internal::LineCutter> HStringView::lines() const noexcept {
+		return {*this, {}};
+	}
 }
 
 // misc
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "hana/platform/macros.h"
+#include "hana/container/string.hpp"
+
+#include <vector>
+
+namespace hana
+{
+	/*!
+	 * @brief Opt-in sidecar of HString for random access by code point.
+	 *
+	 * HString::text_index_to_buffer and friends scan from the start of the text, so a loop indexing by code point is O(n^2).
+	 * The index keeps the code unit offset of every Stride-th code point and walks at most Stride - 1 sequences from the
+	 * nearest checkpoint, with the same lenient handling of ill-formed code units as the HString functions.
+	 *
+	 * The table is built on the first lookup. HString has no mutation counter to watch, so the index cannot notice every
+	 * edit: it rebuilds by itself only when the data pointer or size changed, and an edit that keeps both (assigning
+	 * text of the same size within the same buffer, writes through data() or operator[]) leaves it stale. Call reset()
+	 * after modifying the string. Pure ASCII text keeps no table at all since code point and code unit indices coincide.
+	 *
+	 * @note The string must outlive the index.
+	 */
+	class HANA_BASE_API HStringTextIndex {
+	public:
+		using size_type = HString::size_type;
+
+		static constexpr size_type Stride = 64;
+
+		explicit HStringTextIndex(const HString& str) noexcept : str_(&str) {}
+
+		size_type text_length();
+		unicode::UTF8Seq at_text(size_type index);
+		size_type buffer_index_to_text(size_type index);
+		size_type text_index_to_buffer(size_type index);
+
+		//! drops the table, the next lookup rebuilds it; required after any change to the string
+		void reset() noexcept;
+
+	private:
+		void sync();
+
+		const HString* str_;
+		const char8_t* data_ = nullptr;
+		size_type size_ = HString::npos;
+		size_type length_ = 0;
+		bool ascii_ = false;
+		// checkpoints_[i] is the code unit offset of code point i * Stride
+		std::vector<size_type> checkpoints_;
+	};
+}
@@ -2,6 +2,7 @@
 
 #include <array>
 #include <cassert>
+#include <type_traits>
 
 namespace hana::unicode
 {
@@ -33,6 +34,10 @@ namespace hana::unicode
 	constexpr uint64_t utf8_code_point_index(const char8_t* seq, uint32_t size, uint64_t index) noexcept;
 	// return: index in code unit
 	constexpr uint64_t utf8_code_unit_index(const char8_t* seq, uint32_t size, uint64_t index) noexcept;
+	// return: whether seq is well-formed utf-8 (no overlong, surrogate, out of range or truncated sequence)
+	constexpr bool utf8_validate(const char8_t* seq, uint64_t size) noexcept;
+	// return: code point count, ill-formed code units are counted like utf8_code_point_index does
+	constexpr uint64_t utf8_code_point_count(const char8_t* seq, uint64_t size) noexcept;
 
 	//==================> utf-16 <==================
 	// is ch a leading surrogate
@@ -54,6 +59,59 @@ namespace hana::unicode
 	// return: index in code unit
 	constexpr uint64_t utf16_code_unit_index(const char16_t* seq, uint32_t size, uint64_t index) noexcept;
 
+	//==================> case <==================
+	// return: simple (1:1) lowercase mapping of ch, ch itself if it has none
+	HANA_BASE_API char32_t to_lower(char32_t ch) noexcept;
+	// return: simple (1:1) uppercase mapping of ch, ch itself if it has none
+	HANA_BASE_API char32_t to_upper(char32_t ch) noexcept;
+	// return: simple case folding of ch (status C and S of CaseFolding.txt), ch itself if it has none
+	HANA_BASE_API char32_t casefold(char32_t ch) noexcept;
+
+	//==================> simd <==================
+	namespace internal
+	{
+		// Runtime kernels (SSE2/AVX2/NEON picked by cpu features), the constexpr scalar path is used in constant evaluation.
+		// return: whether seq is well-formed utf-8, non-continuation code units are added to code_points
+		HANA_BASE_API bool utf8_scan(const char8_t* seq, uint64_t size, uint64_t& code_points) noexcept;
+		// return: whether seq is well-formed up to the code_points-th code point, whose code unit index is written to index
+		HANA_BASE_API bool utf8_skip(const char8_t* seq, uint64_t size, uint64_t code_points, uint64_t& index) noexcept;
+
+		// Transcoding kernels, same results as the UTF16Cursor/UTF8Seq walk in unicode::text_size and unicode::transcode_to_utf8.
+		// return: utf-8 size of the text
+		HANA_BASE_API uint64_t utf16_utf8_size(const char16_t* seq, uint64_t size) noexcept;
+		HANA_BASE_API uint64_t utf32_utf8_size(const char32_t* seq, uint64_t size) noexcept;
+		// return: code units written to dst, dst must hold 3 units per utf-16 unit or 4 per utf-32 unit
+		HANA_BASE_API uint64_t utf16_to_utf8(const char16_t* seq, uint64_t size, char8_t* dst) noexcept;
+		HANA_BASE_API uint64_t utf32_to_utf8(const char32_t* seq, uint64_t size, char8_t* dst) noexcept;
+		// return: code units written to dst, dst must hold size units, ill-formed input decodes to U+FFFD like decode_utf
+		HANA_BASE_API uint64_t utf8_to_utf16(const char8_t* seq, uint64_t size, char16_t* dst) noexcept;
+		HANA_BASE_API uint64_t utf8_to_utf32(const char8_t* seq, uint64_t size, char32_t* dst) noexcept;
+
+		// Case kernels, ASCII blocks take the vector path and other code points the case tables. Ill-formed code units are
+		// copied as is and compare by value, above every code point.
+		enum class CaseMapping : uint8_t {
+			Lower,
+			Upper,
+			Fold,
+		};
+		// return: utf-8 size of seq after mapping
+		HANA_BASE_API uint64_t utf8_case_size(const char8_t* seq, uint64_t size, CaseMapping mapping) noexcept;
+		// return: code units written to dst, dst must hold utf8_case_size units and must not overlap seq
+		HANA_BASE_API uint64_t utf8_case_map(const char8_t* seq, uint64_t size, char8_t* dst, CaseMapping mapping) noexcept;
+		// Maps seq in place up to the first code point whose utf-8 length would change.
+		// return: code units mapped, size if the whole sequence was mapped
+		HANA_BASE_API uint64_t utf8_case_map_in_place(char8_t* seq, uint64_t size, CaseMapping mapping) noexcept;
+		// return: <0, 0 or >0 as the casefolded code points of lhs compare to those of rhs
+		HANA_BASE_API int utf8_icompare(const char8_t* lhs, uint64_t lhs_size, const char8_t* rhs, uint64_t rhs_size) noexcept;
+		HANA_BASE_API bool utf8_iequals(const char8_t* lhs, uint64_t lhs_size, const char8_t* rhs, uint64_t rhs_size) noexcept;
+		// return: index of the first case-insensitive match at or after pos, npos if there is none
+		HANA_BASE_API uint64_t utf8_ifind(const char8_t* seq, uint64_t size, const char8_t* pattern, uint64_t count, uint64_t pos) noexcept;
+
+		constexpr bool utf8_validate_scalar(const char8_t* seq, uint64_t size) noexcept;
+		constexpr uint64_t utf8_code_point_index_scalar(const char8_t* seq, uint64_t size, uint64_t index) noexcept;
+		constexpr uint64_t utf8_code_unit_index_scalar(const char8_t* seq, uint64_t size, uint64_t index) noexcept;
+	}
+
 	//==================> sequence <==================
 	struct UTF8Seq;
 	struct UTF16Seq;
@@ -264,6 +322,61 @@ namespace hana::unicode
 	constexpr uint64_t utf8_code_point_index(const char8_t* seq, uint32_t size, uint64_t index) noexcept {
 		assert(index < size);
 
+		if (!std::is_constant_evaluated()) {
+			// extend to the end of the sequence holding index so the scanned prefix is complete
+			uint64_t end = index + 1;
+			while (end < size && end - index < 4 && utf8_seq_len(seq[end]) == 0) {
+				++end;
+			}
+
+			// in well-formed text every code point owns exactly one non-continuation code unit
+			uint64_t code_points = 0;
+			if (internal::utf8_scan(seq, end, code_points)) {
+				return code_points - 1;
+			}
+		}
+
+		return internal::utf8_code_point_index_scalar(seq, size, index);
+	}
+
+	constexpr uint64_t utf8_code_unit_index(const char8_t* seq, uint32_t size, uint64_t index) noexcept {
+		assert(index < size);
+
+		if (!std::is_constant_evaluated()) {
+			uint64_t unit_index = 0;
+			if (internal::utf8_skip(seq, size, index, unit_index)) {
+				return unit_index;
+			}
+		}
+
+		return internal::utf8_code_unit_index_scalar(seq, size, index);
+	}
+
+	constexpr bool utf8_validate(const char8_t* seq, uint64_t size) noexcept {
+		if (std::is_constant_evaluated()) {
+			return internal::utf8_validate_scalar(seq, size);
+		}
+
+		uint64_t code_points = 0;
+		return internal::utf8_scan(seq, size, code_points);
+	}
+
+	constexpr uint64_t utf8_code_point_count(const char8_t* seq, uint64_t size) noexcept {
+		if (size == 0) {
+			return 0;
+		}
+
+		if (!std::is_constant_evaluated()) {
+			uint64_t code_points = 0;
+			if (internal::utf8_scan(seq, size, code_points)) {
+				return code_points;
+			}
+		}
+
+		return internal::utf8_code_point_index_scalar(seq, size, size - 1) + 1;
+	}
+
+	constexpr uint64_t internal::utf8_code_point_index_scalar(const char8_t* seq, uint64_t size, uint64_t index) noexcept {
 		uint64_t cur_idx = 0;
 		uint64_t code_point_count = 0;
 
@@ -281,9 +394,7 @@ namespace hana::unicode
 		return code_point_count - 1;
 	}
 
-	constexpr uint64_t utf8_code_unit_index(const char8_t* seq, uint32_t size, uint64_t index) noexcept {
-		assert(index < size);
-
+	constexpr uint64_t internal::utf8_code_unit_index_scalar(const char8_t* seq, uint64_t size, uint64_t index) noexcept {
 		uint64_t cur_idx = 0;
 		uint64_t code_point_count = 0;
 		while (cur_idx < size && code_point_count < index) {
@@ -745,4 +856,17 @@ namespace hana::unicode
 		assert(next - first <= 4);
 		return is_usv ? static_cast<int>(next - first) : -1;
 	}
+
+	constexpr bool internal::utf8_validate_scalar(const char8_t* seq, uint64_t size) noexcept {
+		const char8_t* first = seq;
+		const char8_t* const last = seq + size;
+		while (first != last) {
+			const int len = utf8_code_units_in_next_character(first, last);
+			if (len < 0) {
+				return false;
+			}
+			first += len;
+		}
+		return true;
+	}
 }
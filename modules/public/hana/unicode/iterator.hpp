@@ -303,6 +303,9 @@ namespace hana::unicode
 		if constexpr (sizeof(Char) == sizeof(char8_t)) {
 			return len;
 		} else if constexpr (sizeof(Char) == sizeof(char16_t)) {
+			if (!std::is_constant_evaluated()) {
+				return internal::utf16_utf8_size(reinterpret_cast<const char16_t*>(str), len);
+			}
 			// parse utf8 str len
 			size_t utf8_len = 0;
 			for (UTF16Seq utf16_seq: UTF16Cursor<true>{reinterpret_cast<const char16_t*>(str), len, 0}.as_range()) {
@@ -314,6 +317,9 @@ namespace hana::unicode
 			}
 			return utf8_len;
 		} else if constexpr (sizeof(Char) == sizeof(char32_t)) {
+			if (!std::is_constant_evaluated()) {
+				return internal::utf32_utf8_size(reinterpret_cast<const char32_t*>(str), len);
+			}
 			size_t utf8_len = 0;
 			for (size_t i = 0; i < len; ++i) {
 				utf8_len += utf8_seq_len(reinterpret_cast<const char32_t*>(str)[i]);
@@ -329,11 +335,30 @@ namespace hana::unicode
 		return text_length(str, std::char_traits<Char>::length(str));
 	}
 
+	//! @return byte size that always holds len code units of Char transcoded to utf-8, used to transcode without sizing first
 	template<is_char_v Char>
-	constexpr void parse_to_utf8(const Char* str, size_t len, char8_t* dst) noexcept {
+	constexpr size_t text_size_bound(size_t len) noexcept {
+		if constexpr (sizeof(Char) == sizeof(char8_t)) {
+			return len;
+		} else if constexpr (sizeof(Char) == sizeof(char16_t)) {
+			// a surrogate pair takes 4 bytes, any other unit at most 3
+			return len * 3;
+		} else {
+			return len * 4;
+		}
+	}
+
+	//! transcodes str to utf-8 in a single pass, dst must hold text_size(str, len) or text_size_bound<Char>(len) bytes
+	//! @return bytes written to dst
+	template<is_char_v Char>
+	constexpr size_t transcode_to_utf8(const Char* str, size_t len, char8_t* dst) noexcept {
 		if constexpr (sizeof(Char) == sizeof(char8_t)) {
 			std::char_traits<char8_t>::copy(dst, reinterpret_cast<const char8_t*>(str), len);
+			return len;
 		} else if constexpr (sizeof(Char) == sizeof(char16_t)) {
+			if (!std::is_constant_evaluated()) {
+				return internal::utf16_to_utf8(reinterpret_cast<const char16_t*>(str), len, dst);
+			}
 			size_t write_index = 0;
 			for (UTF16Seq utf16_seq: UTF16Cursor<true>{reinterpret_cast<const char16_t*>(str), len, 0}.as_range()) {
 				if (utf16_seq.is_valid()) {
@@ -345,13 +370,54 @@ namespace hana::unicode
 					++write_index;
 				}
 			}
+			return write_index;
 		} else if constexpr (sizeof(Char) == sizeof(char32_t)) {
+			if (!std::is_constant_evaluated()) {
+				return internal::utf32_to_utf8(reinterpret_cast<const char32_t*>(str), len, dst);
+			}
 			size_t write_index = 0;
 			for (size_t i = 0; i < len; ++i) {
 				UTF8Seq utf8_seq = reinterpret_cast<const char32_t*>(str)[i];
 				std::char_traits<char8_t>::copy(dst + write_index, utf8_seq.data, utf8_seq.len);
 				write_index += utf8_seq.len;
 			}
+			return write_index;
+		} else {
+			return 0;
+		}
+	}
+
+	template<is_char_v Char>
+	constexpr void parse_to_utf8(const Char* str, size_t len, char8_t* dst) noexcept {
+		transcode_to_utf8(str, len, dst);
+	}
+
+	//! transcodes utf-8 str to utf-16 or utf-32, ill-formed sequences become U+FFFD, dst must hold len code units
+	//! @return code units written to dst
+	template<is_char_v Char>
+		requires(sizeof(Char) != sizeof(char8_t))
+	constexpr size_t transcode_from_utf8(const char8_t* str, size_t len, Char* dst) noexcept {
+		if (!std::is_constant_evaluated()) {
+			if constexpr (sizeof(Char) == sizeof(char16_t)) {
+				return internal::utf8_to_utf16(str, len, reinterpret_cast<char16_t*>(dst));
+			} else {
+				return internal::utf8_to_utf32(str, len, reinterpret_cast<char32_t*>(dst));
+			}
+		}
+
+		size_t write_index = 0;
+		for (const char8_t* first = str, *last = str + len; first != last;) {
+			char32_t value;
+			first = decode_utf(first, last, value).next_ptr_;
+			if constexpr (sizeof(Char) == sizeof(char16_t)) {
+				const UTF16Seq utf16_seq{value};
+				for (uint8_t i = 0; i < utf16_seq.len; ++i) {
+					dst[write_index++] = static_cast<Char>(utf16_seq.data[i]);
+				}
+			} else {
+				dst[write_index++] = static_cast<Char>(value);
+			}
 		}
+		return write_index;
 	}
 }
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "hana/container/string.hpp"
+#include "hana/container/fixed_string.hpp"
 
 #include <span>
 #include <optional>
@@ -89,7 +89,8 @@ namespace hana
 			return guid_t{data};
 		}
 
-		[[nodiscard]] HANA_BASE_API HString to_string() const noexcept;
+		// xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx in lower case, call str() on the result where an HString is needed
+		[[nodiscard]] HANA_BASE_API HFixedString<36> to_string() const noexcept;
 
 		constexpr guid_t() noexcept = default;
 
@@ -1,8 +1,14 @@
 #pragma once
 
 #include "hana/container/string.hpp"
+#include "hana/container/fixed_string.hpp"
 
 #include <bit>
+#include <array>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <span>
 
 namespace hana::internal
 {
@@ -42,7 +48,7 @@ namespace hana::internal
 #if defined __GNUC__ && __WORDSIZE >= 64
 		// It appears both GCC and Clang support evaluating __int128 as constexpr
 		const auto product = static_cast<unsigned __int128>(lhs) * rhs;
-		return static_cast<uint64_t>(product >> 64) & static_cast<uint64_t>(product);
+		return static_cast<uint64_t>(product >> 64) ^ static_cast<uint64_t>(product);
 #else
 		auto [lower, upper] = mult64to128(lhs, rhs);
 		return lower ^ upper;
@@ -157,6 +163,7 @@ namespace hana::internal
 
 		inline constexpr size_t SECRET_DEFAULT_SIZE = 192;
 		inline constexpr size_t SECRET_SIZE_MIN = 136;
+		inline constexpr size_t MIDSIZE_MAX = 240;
 
 		inline constexpr uint8_t kSecret[SECRET_DEFAULT_SIZE]{
 			0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c,
@@ -218,9 +225,24 @@ namespace hana::internal
 			}
 		}
 
+		template<typename S>
+		constexpr void scramble_acc(uint64_t* acc, const S* secret) noexcept {
+			for (size_t i = 0; i < ACC_NB; i++)
+				acc[i] = (acc[i] ^ (acc[i] >> 47) ^ internal::read64(secret + 8 * i)) * xxh32::PRIME1;
+		}
+
+		inline constexpr size_t SECRET_MERGEACCS_START = 11;
+
+		template<typename S>
+		constexpr uint64_t merge_accs(const uint64_t* acc, const S* secret, uint64_t start) noexcept {
+			uint64_t result = start;
+			for (size_t i = 0; i < 4; i++)
+				result += internal::mul128_fold64(acc[2 * i] ^ internal::read64(secret + 16 * i), acc[2 * i + 1] ^ internal::read64(secret + 16 * i + 8));
+			return XXH3_avalanche(result);
+		}
+
 		template<typename T, typename S>
-		constexpr uint64_t hashLong_64b_internal(const T* input, size_t len, const S* secret, size_t secretSize) noexcept {
-			uint64_t acc[ACC_NB]{xxh32::PRIME3, PRIME64_1, PRIME64_2, PRIME64_3, PRIME64_4, xxh32::PRIME2, PRIME64_5, xxh32::PRIME1};
+		constexpr void hashLong_internal_loop(uint64_t* acc, const T* input, size_t len, const S* secret, size_t secretSize) noexcept {
 			const size_t nbStripesPerBlock = (secretSize - STRIPE_LEN) / SECRET_CONSUME_RATE;
 			const size_t block_len = STRIPE_LEN * nbStripesPerBlock;
 			const size_t nb_blocks = (len - 1) / block_len;
@@ -228,18 +250,137 @@ namespace hana::internal
 			for (size_t n = 0; n < nb_blocks; n++) {
 				for (size_t i = 0; i < nbStripesPerBlock; i++)
 					constexpr_xxh3::accumulate_512(acc, input + n * block_len + i * STRIPE_LEN, secret + i * SECRET_CONSUME_RATE);
-				for (size_t i = 0; i < ACC_NB; i++)
-					acc[i] = (acc[i] ^ (acc[i] >> 47) ^ internal::read64(secret + secretSize - STRIPE_LEN + 8 * i)) * xxh32::PRIME1;
+				constexpr_xxh3::scramble_acc(acc, secret + secretSize - STRIPE_LEN);
 			}
 
 			const size_t nbStripes = ((len - 1) - (block_len * nb_blocks)) / STRIPE_LEN;
 			for (size_t i = 0; i < nbStripes; i++)
 				constexpr_xxh3::accumulate_512(acc, input + nb_blocks * block_len + i * STRIPE_LEN, secret + i * SECRET_CONSUME_RATE);
 			constexpr_xxh3::accumulate_512(acc, input + len - STRIPE_LEN, secret + secretSize - STRIPE_LEN - 7);
-			uint64_t result = len * PRIME64_1;
-			for (size_t i = 0; i < 4; i++)
-				result += internal::mul128_fold64(acc[2 * i] ^ internal::read64(secret + 11 + 16 * i), acc[2 * i + 1] ^ internal::read64(secret + 11 + 16 * i + 8));
-			return XXH3_avalanche(result);
+		}
+
+		template<typename T, typename S>
+		constexpr uint64_t hashLong_64b_internal(const T* input, size_t len, const S* secret, size_t secretSize) noexcept {
+			uint64_t acc[ACC_NB]{xxh32::PRIME3, PRIME64_1, PRIME64_2, PRIME64_3, PRIME64_4, xxh32::PRIME2, PRIME64_5, xxh32::PRIME1};
+			constexpr_xxh3::hashLong_internal_loop(acc, input, len, secret, secretSize);
+			return constexpr_xxh3::merge_accs(acc, secret + SECRET_MERGEACCS_START, len * PRIME64_1);
+		}
+
+		// 128-bit results are {low64, high64}, like mult64to128
+		using hash128_t = std::pair<uint64_t, uint64_t>;
+
+		inline constexpr uint64_t PRIME_MX2 = 0x9FB21C651E98DF25ULL;
+
+		template<typename T, typename S>
+		constexpr hash128_t hashLong_128b_internal(const T* input, size_t len, const S* secret, size_t secretSize) noexcept {
+			uint64_t acc[ACC_NB]{xxh32::PRIME3, PRIME64_1, PRIME64_2, PRIME64_3, PRIME64_4, xxh32::PRIME2, PRIME64_5, xxh32::PRIME1};
+			constexpr_xxh3::hashLong_internal_loop(acc, input, len, secret, secretSize);
+			return {
+				constexpr_xxh3::merge_accs(acc, secret + SECRET_MERGEACCS_START, len * PRIME64_1),
+				constexpr_xxh3::merge_accs(acc, secret + secretSize - sizeof(acc) - SECRET_MERGEACCS_START, ~(len * PRIME64_2))
+			};
+		}
+
+		template<typename T, typename S>
+		constexpr hash128_t len_1to3_128b(const T* input, size_t len, const S* secret, uint64_t seed) noexcept {
+			auto get = [](T value) { return static_cast<uint32_t>(static_cast<uint8_t>(value)); };
+			const uint32_t combinedl = (get(input[0]) << 16) | (get(input[len >> 1]) << 24) | get(input[len - 1]) | (static_cast<uint32_t>(len) << 8);
+			const uint32_t combinedh = std::rotl(swap32(combinedl), 13);
+			const uint64_t bitflipl = (internal::read32(secret) ^ internal::read32(secret + 4)) + seed;
+			const uint64_t bitfliph = (internal::read32(secret + 8) ^ internal::read32(secret + 12)) - seed;
+			return {XXH64_avalanche(combinedl ^ bitflipl), XXH64_avalanche(combinedh ^ bitfliph)};
+		}
+
+		template<typename T, typename S>
+		constexpr hash128_t len_4to8_128b(const T* input, size_t len, const S* secret, uint64_t seed) noexcept {
+			seed ^= static_cast<uint64_t>(swap32(static_cast<uint32_t>(seed))) << 32;
+			const uint64_t input_64 = internal::read32(input) + (static_cast<uint64_t>(internal::read32(input + len - 4)) << 32);
+			const uint64_t bitflip = (internal::read64(secret + 16) ^ internal::read64(secret + 24)) + seed;
+			auto [low, high] = internal::mult64to128(input_64 ^ bitflip, PRIME64_1 + (len << 2));
+			high += low << 1;
+			low ^= high >> 3;
+			low ^= low >> 35;
+			low *= PRIME_MX2;
+			low ^= low >> 28;
+			return {low, XXH3_avalanche(high)};
+		}
+
+		template<typename T, typename S>
+		constexpr hash128_t len_9to16_128b(const T* input, size_t len, const S* secret, uint64_t seed) noexcept {
+			const uint64_t bitflipl = (internal::read64(secret + 32) ^ internal::read64(secret + 40)) - seed;
+			const uint64_t bitfliph = (internal::read64(secret + 48) ^ internal::read64(secret + 56)) + seed;
+			const uint64_t input_lo = internal::read64(input);
+			uint64_t input_hi = internal::read64(input + len - 8);
+			auto [low, high] = internal::mult64to128(input_lo ^ input_hi ^ bitflipl, PRIME64_1);
+			low += static_cast<uint64_t>(len - 1) << 54;
+			input_hi ^= bitfliph;
+			if constexpr (sizeof(void*) < sizeof(uint64_t)) {
+				high += (input_hi & 0xFFFFFFFF00000000ULL) + static_cast<uint64_t>(static_cast<uint32_t>(input_hi)) * xxh32::PRIME2;
+			} else {
+				high += input_hi + static_cast<uint64_t>(static_cast<uint32_t>(input_hi)) * (xxh32::PRIME2 - 1);
+			}
+			low ^= swap64(high);
+			auto [h_low, h_high] = internal::mult64to128(low, PRIME64_2);
+			h_high += high * PRIME64_2;
+			return {XXH3_avalanche(h_low), XXH3_avalanche(h_high)};
+		}
+
+		template<typename T, typename S>
+		constexpr hash128_t mix32B(hash128_t acc, const T* input_1, const T* input_2, const S* secret, uint64_t seed) noexcept {
+			acc.first += constexpr_xxh3::mix16B(input_1, secret, seed);
+			acc.first ^= internal::read64(input_2) + internal::read64(input_2 + 8);
+			acc.second += constexpr_xxh3::mix16B(input_2, secret + 16, seed);
+			acc.second ^= internal::read64(input_1) + internal::read64(input_1 + 8);
+			return acc;
+		}
+
+		constexpr hash128_t finalize_midsize_128b(hash128_t acc, size_t len, uint64_t seed) noexcept {
+			const uint64_t low = acc.first + acc.second;
+			const uint64_t high = acc.first * PRIME64_1 + acc.second * PRIME64_4 + (len - seed) * PRIME64_2;
+			return {XXH3_avalanche(low), uint64_t{0} - XXH3_avalanche(high)};
+		}
+
+		template<typename T, typename S>
+		constexpr hash128_t len_0to16_128b(const T* input, size_t len, const S* secret, uint64_t seed) noexcept {
+			if (len > 8) return constexpr_xxh3::len_9to16_128b(input, len, secret, seed);
+			if (len >= 4) return constexpr_xxh3::len_4to8_128b(input, len, secret, seed);
+			if (len) return constexpr_xxh3::len_1to3_128b(input, len, secret, seed);
+			return {
+				XXH64_avalanche(seed ^ (internal::read64(secret + 64) ^ internal::read64(secret + 72))),
+				XXH64_avalanche(seed ^ (internal::read64(secret + 80) ^ internal::read64(secret + 88)))
+			};
+		}
+
+		template<typename T, typename S, typename HashLong>
+		constexpr hash128_t XXH3_128bits_internal(const T* input, size_t len, uint64_t seed, const S* secret, size_t secretLen, HashLong f_hashLong) noexcept {
+			if (len <= 16) {
+				return constexpr_xxh3::len_0to16_128b(input, len, secret, seed);
+			}
+			if (len <= 128) {
+				hash128_t acc{len * PRIME64_1, 0};
+				if (len > 32) {
+					if (len > 64) {
+						if (len > 96) {
+							acc = constexpr_xxh3::mix32B(acc, input + 48, input + len - 64, secret + 96, seed);
+						}
+						acc = constexpr_xxh3::mix32B(acc, input + 32, input + len - 48, secret + 64, seed);
+					}
+					acc = constexpr_xxh3::mix32B(acc, input + 16, input + len - 32, secret + 32, seed);
+				}
+				acc = constexpr_xxh3::mix32B(acc, input, input + len - 16, secret, seed);
+				return constexpr_xxh3::finalize_midsize_128b(acc, len, seed);
+			}
+			if (len <= MIDSIZE_MAX) {
+				hash128_t acc{len * PRIME64_1, 0};
+				for (size_t i = 32; i < 160; i += 32)
+					acc = constexpr_xxh3::mix32B(acc, input + i - 32, input + i - 16, secret + i - 32, seed);
+				acc = {XXH3_avalanche(acc.first), XXH3_avalanche(acc.second)};
+				for (size_t i = 160; i <= len; i += 32)
+					acc = constexpr_xxh3::mix32B(acc, input + i - 32, input + i - 16, secret + 3 + i - 160, seed);
+				acc = constexpr_xxh3::mix32B(acc, input + len - 16, input + len - 32, secret + SECRET_SIZE_MIN - 17 - 16, uint64_t{0} - seed);
+				return constexpr_xxh3::finalize_midsize_128b(acc, len, seed);
+			}
+			return f_hashLong(input, len, seed, secret, secretLen);
 		}
 
 		template<typename T, typename S, typename HashLong>
@@ -304,6 +445,33 @@ namespace hana::internal
 			return (N ? N - 1 : 0);
 		}
 
+		inline constexpr size_t INTERNAL_BUFFER_SIZE = 256;
+		inline constexpr size_t INTERNAL_BUFFER_STRIPES = INTERNAL_BUFFER_SIZE / STRIPE_LEN;
+
+		// XXH3_consumeStripes: accumulates stripes that may continue a partially consumed block
+		template<typename T, typename S>
+		constexpr const T* consume_stripes(uint64_t* acc, size_t& nbStripesSoFar, size_t nbStripesPerBlock, const T* input, size_t nbStripes,
+										   const S* secret, size_t secretLimit) noexcept {
+			const S* initialSecret = secret + nbStripesSoFar * SECRET_CONSUME_RATE;
+			if (nbStripes >= nbStripesPerBlock - nbStripesSoFar) {
+				size_t nbStripesThisIter = nbStripesPerBlock - nbStripesSoFar;
+				do {
+					for (size_t i = 0; i < nbStripesThisIter; i++)
+						constexpr_xxh3::accumulate_512(acc, input + i * STRIPE_LEN, initialSecret + i * SECRET_CONSUME_RATE);
+					constexpr_xxh3::scramble_acc(acc, secret + secretLimit);
+					input += nbStripesThisIter * STRIPE_LEN;
+					nbStripes -= nbStripesThisIter;
+					nbStripesThisIter = nbStripesPerBlock;
+					initialSecret = secret;
+				} while (nbStripes >= nbStripesPerBlock);
+				nbStripesSoFar = 0;
+			}
+			for (size_t i = 0; i < nbStripes; i++)
+				constexpr_xxh3::accumulate_512(acc, input + i * STRIPE_LEN, initialSecret + i * SECRET_CONSUME_RATE);
+			nbStripesSoFar += nbStripes;
+			return input + nbStripes * STRIPE_LEN;
+		}
+
 		/// Basic interfaces
 
 		template<ByteType T>
@@ -359,10 +527,53 @@ namespace hana::internal
 			return constexpr_xxh3::XXH3_64bits_withSeed_const(std::data(input), constexpr_xxh3::bytes_size(input), seed);
 		}
 	}
+
+	// objects hashed through their bytes, padding would make equal values hash differently
+	template<typename T>
+	concept HashableObject = !constexpr_xxh3::BytesType<T> && !std::is_pointer_v<T> && std::is_trivially_copyable_v<T> &&
+							 std::has_unique_object_representations_v<T>;
+
+	// float and double are hashed by value with -0.0 folded into 0.0; long double is left out since its padding bytes differ by platform
+	template<typename T>
+	concept HashableFloat = std::same_as<T, float> || std::same_as<T, double>;
+
+	template<HashableFloat T>
+	constexpr T normalize_zero(T value) noexcept {
+		return value == T{} ? T{} : value;
+	}
 }
 
 namespace hana
 {
+	/*!
+	 * @brief 128-bit XXH3 digest, for content-addressed caches where collisions of 64-bit hashes are not acceptable.
+	 */
+	struct Fingerprint128 {
+		uint64_t low = 0;
+		uint64_t high = 0;
+
+		constexpr bool operator==(const Fingerprint128& rhs) const noexcept = default;
+
+		constexpr std::strong_ordering operator<=>(const Fingerprint128& rhs) const noexcept {
+			if (const auto order = high <=> rhs.high; order != 0) {
+				return order;
+			}
+			return low <=> rhs.low;
+		}
+
+		//! 32 lowercase hex digits, high half first like XXH128_canonicalFromHash
+		constexpr HFixedString<32> to_string() const noexcept {
+			constexpr char8_t digits[] = u8"0123456789abcdef";
+			HFixedString<32> result;
+			for (const uint64_t half: {high, low}) {
+				for (int shift = 60; shift >= 0; shift -= 4) {
+					result.push_back(digits[(half >> shift) & 0xF]);
+				}
+			}
+			return result;
+		}
+	};
+
 	class XXHash {
 	public:
 		static constexpr uint32_t default_seed = 1610612741;
@@ -418,6 +629,40 @@ namespace hana
 			return XXHash::xxhash64(std::data(input), internal::constexpr_xxh3::bytes_size(input), seed);
 		}
 
+		template<typename T>
+		[[nodiscard]] static constexpr Fingerprint128 xxhash128(const T* input, size_t length) noexcept {
+			if constexpr (internal::constexpr_xxh3::ByteType<T>) {
+				if (std::is_constant_evaluated()) {
+					return XXHash::_XXH3_128bits_withSeed_const(input, length, 0);
+				}
+				return XXHash::_xxhash128(input, length);
+			} else {
+				return XXHash::_xxhash128(input, length * sizeof(T));
+			}
+		}
+
+		template<typename T>
+		[[nodiscard]] static constexpr Fingerprint128 xxhash128(const T* input, size_t length, uint64_t seed) noexcept {
+			if constexpr (internal::constexpr_xxh3::ByteType<T>) {
+				if (std::is_constant_evaluated()) {
+					return XXHash::_XXH3_128bits_withSeed_const(input, length, seed);
+				}
+				return XXHash::_xxhash128(input, length, seed);
+			} else {
+				return XXHash::_xxhash128(input, length * sizeof(T), seed);
+			}
+		}
+
+		template<internal::constexpr_xxh3::BytesType Bytes>
+		[[nodiscard]] static constexpr Fingerprint128 xxhash128(const Bytes& input) noexcept {
+			return XXHash::xxhash128(std::data(input), internal::constexpr_xxh3::bytes_size(input));
+		}
+
+		template<internal::constexpr_xxh3::BytesType Bytes>
+		[[nodiscard]] static constexpr Fingerprint128 xxhash128(const Bytes& input, uint64_t seed) noexcept {
+			return XXHash::xxhash128(std::data(input), internal::constexpr_xxh3::bytes_size(input), seed);
+		}
+
 		template<typename T>
 		[[nodiscard]] static constexpr size_t xxhash(const T* input, size_t length) noexcept {
 			if constexpr (sizeof(size_t) == 4) {
@@ -446,10 +691,27 @@ namespace hana
 			return XXHash::xxhash(std::data(input), internal::constexpr_xxh3::bytes_size(input), seed);
 		}
 
+		/*!
+		 * @brief Batch xxhash64, out[i] = xxhash64(keys[i], seed).
+		 *
+		 * One call into the library for the whole batch instead of one per key, with XXH3 inlined into the loop, for
+		 * building indices over many short keys. out must hold at least keys.size() values.
+		 */
+		HANA_BASE_API static void hash_many(std::span<const HStringView> keys, std::span<uint64_t> out, uint64_t seed = 0) noexcept;
+
+		/*!
+		 * @brief Batch xxhash64 over out.size() keys of width bytes each, stored back to back from keys.
+		 *
+		 * Widths of 4, 8, 16, 24, 32 and 64 bytes run a loop specialized for that length.
+		 */
+		HANA_BASE_API static void hash_many(const void* keys, size_t width, std::span<uint64_t> out, uint64_t seed = 0) noexcept;
+
 	private:
 		HANA_BASE_API static uint32_t _xxhash32(const void* input, size_t length, uint32_t seed) noexcept;
 		HANA_BASE_API static uint64_t _xxhash64(const void* input, size_t length) noexcept;
 		HANA_BASE_API static uint64_t _xxhash64(const void* input, size_t length, uint64_t seed) noexcept;
+		HANA_BASE_API static Fingerprint128 _xxhash128(const void* input, size_t length) noexcept;
+		HANA_BASE_API static Fingerprint128 _xxhash128(const void* input, size_t length, uint64_t seed) noexcept;
 
 		template<internal::constexpr_xxh3::ByteType T>
 		static constexpr uint64_t _XXH3_64bits_const(const T* input, size_t len) noexcept {
@@ -475,6 +737,196 @@ namespace hana
 
 			return internal::constexpr_xxh3::XXH3_64bits_internal(input, len, seed, internal::constexpr_xxh3::kSecret, sizeof(internal::constexpr_xxh3::kSecret), hashlong);
 		}
+
+		template<internal::constexpr_xxh3::ByteType T>
+		static constexpr Fingerprint128 _XXH3_128bits_withSeed_const(const T* input, size_t len, uint64_t seed) noexcept {
+			auto hashlong = [](const T* input, size_t len, uint64_t seed, const void*, size_t) constexpr noexcept {
+				uint8_t secret[internal::constexpr_xxh3::SECRET_DEFAULT_SIZE];
+				for (size_t i = 0; i < internal::constexpr_xxh3::SECRET_DEFAULT_SIZE; i += 16) {
+					internal::constexpr_xxh3::writeLE64(secret + i, internal::read64(internal::constexpr_xxh3::kSecret + i) + seed);
+					internal::constexpr_xxh3::writeLE64(secret + i + 8, internal::read64(internal::constexpr_xxh3::kSecret + i + 8) - seed);
+				}
+				return internal::constexpr_xxh3::hashLong_128b_internal(input, len, secret, sizeof(secret));
+			};
+
+			const auto [low, high] = internal::constexpr_xxh3::XXH3_128bits_internal(input, len, seed, internal::constexpr_xxh3::kSecret, sizeof(internal::constexpr_xxh3::kSecret), hashlong);
+			return {low, high};
+		}
+	};
+
+	/*!
+	 * @brief Incremental XXH3 64-bit hash, for input that is not contiguous or too large to load at once.
+	 *
+	 * Feeding the bytes in any number of update() calls gives XXHash::xxhash64 of their concatenation, with the same seed.
+	 * digest() does not change the state, so more input can follow. The state is 576 bytes and uses the SIMD kernels of
+	 * xxHash; ConstexprXXHashState produces the same values in constant evaluation.
+	 *
+	 * @code
+	 *		XXHashState state;
+	 *		state.update(module_name).update(version).update(binary.data(), binary.size());
+	 *		const uint64_t fingerprint = state.digest();
+	 * @endcode
+	 */
+	class XXHashState {
+	public:
+		HANA_BASE_API XXHashState() noexcept;
+		HANA_BASE_API explicit XXHashState(uint64_t seed) noexcept;
+
+		HANA_BASE_API void reset(uint64_t seed = 0) noexcept;
+
+		XXHashState& update(const void* input, size_t length) noexcept {
+			update_bytes(input, length);
+			return *this;
+		}
+
+		template<internal::constexpr_xxh3::BytesType Bytes>
+		XXHashState& update(const Bytes& input) noexcept {
+			update_bytes(std::data(input), internal::constexpr_xxh3::bytes_size(input) * sizeof(*std::data(input)));
+			return *this;
+		}
+
+		template<internal::HashableObject T>
+		XXHashState& update(const T& value) noexcept {
+			update_bytes(&value, sizeof(T));
+			return *this;
+		}
+
+		template<internal::HashableFloat T>
+		XXHashState& update(T value) noexcept {
+			const T normalized = internal::normalize_zero(value);
+			update_bytes(&normalized, sizeof(T));
+			return *this;
+		}
+
+		[[nodiscard]] HANA_BASE_API uint64_t digest() const noexcept;
+
+	private:
+		HANA_BASE_API void update_bytes(const void* input, size_t length) noexcept;
+
+		// storage of XXH3_state_t, checked in hash.cpp
+		alignas(64) unsigned char state_[576];
+	};
+
+	/*!
+	 * @brief XXHashState for constant evaluation, built on the scalar constexpr_xxh3 kernels.
+	 *
+	 * Gives the same digests as XXHashState and works at runtime as well, but without SIMD; prefer XXHashState there.
+	 */
+	class ConstexprXXHashState {
+	public:
+		constexpr ConstexprXXHashState() noexcept { reset(); }
+		constexpr explicit ConstexprXXHashState(uint64_t seed) noexcept { reset(seed); }
+
+		constexpr void reset(uint64_t seed = 0) noexcept {
+			using namespace internal::constexpr_xxh3;
+			acc_[0] = internal::xxh32::PRIME3;
+			acc_[1] = PRIME64_1;
+			acc_[2] = PRIME64_2;
+			acc_[3] = PRIME64_3;
+			acc_[4] = PRIME64_4;
+			acc_[5] = internal::xxh32::PRIME2;
+			acc_[6] = PRIME64_5;
+			acc_[7] = internal::xxh32::PRIME1;
+			// the default secret with the seed mixed in, as XXH3_initCustomSecret does
+			for (size_t i = 0; i < SECRET_DEFAULT_SIZE; i += 16) {
+				writeLE64(secret_ + i, internal::read64(kSecret + i) + seed);
+				writeLE64(secret_ + i + 8, internal::read64(kSecret + i + 8) - seed);
+			}
+			seed_ = seed;
+			buffered_size_ = 0;
+			stripes_so_far_ = 0;
+			total_length_ = 0;
+		}
+
+		template<internal::constexpr_xxh3::ByteType T>
+		constexpr ConstexprXXHashState& update(const T* input, size_t length) noexcept {
+			using namespace internal::constexpr_xxh3;
+			const T* const end = input + length;
+			total_length_ += length;
+
+			if (length <= INTERNAL_BUFFER_SIZE - buffered_size_) {
+				buffer(input, length, buffered_size_);
+				buffered_size_ += length;
+				return *this;
+			}
+
+			if (buffered_size_) {
+				const size_t load_size = INTERNAL_BUFFER_SIZE - buffered_size_;
+				buffer(input, load_size, buffered_size_);
+				input += load_size;
+				consume_stripes(acc_, stripes_so_far_, stripes_per_block, buffer_, INTERNAL_BUFFER_STRIPES, secret_, secret_limit);
+				buffered_size_ = 0;
+			}
+			if (static_cast<size_t>(end - input) > INTERNAL_BUFFER_SIZE) {
+				const size_t stripes = static_cast<size_t>(end - 1 - input) / STRIPE_LEN;
+				input = consume_stripes(acc_, stripes_so_far_, stripes_per_block, input, stripes, secret_, secret_limit);
+				// keeps the last consumed stripe, digest() needs it when fewer than STRIPE_LEN bytes follow
+				buffer(input - STRIPE_LEN, STRIPE_LEN, INTERNAL_BUFFER_SIZE - STRIPE_LEN);
+			}
+			buffer(input, static_cast<size_t>(end - input), 0);
+			buffered_size_ = static_cast<size_t>(end - input);
+			return *this;
+		}
+
+		template<internal::constexpr_xxh3::BytesType Bytes>
+		constexpr ConstexprXXHashState& update(const Bytes& input) noexcept {
+			return update(std::data(input), internal::constexpr_xxh3::bytes_size(input));
+		}
+
+		template<internal::HashableObject T>
+		constexpr ConstexprXXHashState& update(const T& value) noexcept {
+			const auto bytes = std::bit_cast<std::array<uint8_t, sizeof(T)>>(value);
+			return update(bytes.data(), bytes.size());
+		}
+
+		template<internal::HashableFloat T>
+		constexpr ConstexprXXHashState& update(T value) noexcept {
+			const auto bytes = std::bit_cast<std::array<uint8_t, sizeof(T)>>(internal::normalize_zero(value));
+			return update(bytes.data(), bytes.size());
+		}
+
+		[[nodiscard]] constexpr uint64_t digest() const noexcept {
+			using namespace internal::constexpr_xxh3;
+			if (total_length_ > MIDSIZE_MAX) {
+				uint64_t acc[ACC_NB]{};
+				std::copy_n(acc_, ACC_NB, acc);
+				uint8_t last_stripe[STRIPE_LEN]{};
+				const uint8_t* last_stripe_ptr = last_stripe;
+				if (buffered_size_ >= STRIPE_LEN) {
+					size_t stripes_so_far = stripes_so_far_;
+					consume_stripes(acc, stripes_so_far, stripes_per_block, buffer_, (buffered_size_ - 1) / STRIPE_LEN, secret_, secret_limit);
+					last_stripe_ptr = buffer_ + buffered_size_ - STRIPE_LEN;
+				} else {
+					const size_t catchup_size = STRIPE_LEN - buffered_size_;
+					std::copy_n(buffer_ + INTERNAL_BUFFER_SIZE - catchup_size, catchup_size, last_stripe);
+					std::copy_n(buffer_, buffered_size_, last_stripe + catchup_size);
+				}
+				accumulate_512(acc, last_stripe_ptr, secret_ + secret_limit - 7);
+				return merge_accs(acc, secret_ + SECRET_MERGEACCS_START, total_length_ * PRIME64_1);
+			}
+			// short input is all in the buffer, the seed still applies through the default secret
+			auto unused_long = [](const uint8_t*, size_t, uint64_t, const uint8_t*, size_t) constexpr noexcept { return uint64_t{0}; };
+			return XXH3_64bits_internal(buffer_, static_cast<size_t>(total_length_), seed_, kSecret, SECRET_DEFAULT_SIZE, unused_long);
+		}
+
+	private:
+		static constexpr size_t secret_limit = internal::constexpr_xxh3::SECRET_DEFAULT_SIZE - internal::constexpr_xxh3::STRIPE_LEN;
+		static constexpr size_t stripes_per_block = secret_limit / internal::constexpr_xxh3::SECRET_CONSUME_RATE;
+
+		template<typename T>
+		constexpr void buffer(const T* input, size_t length, size_t offset) noexcept {
+			for (size_t i = 0; i < length; ++i) {
+				buffer_[offset + i] = static_cast<uint8_t>(input[i]);
+			}
+		}
+
+		uint64_t acc_[internal::constexpr_xxh3::ACC_NB]{};
+		uint8_t secret_[internal::constexpr_xxh3::SECRET_DEFAULT_SIZE]{};
+		uint8_t buffer_[internal::constexpr_xxh3::INTERNAL_BUFFER_SIZE]{};
+		size_t buffered_size_ = 0;
+		size_t stripes_so_far_ = 0;
+		uint64_t total_length_ = 0;
+		uint64_t seed_ = 0;
 	};
 
 	class Fnv1aHash {
@@ -556,22 +1008,178 @@ namespace hana
 	}
 }
 
+namespace hana::internal
+{
+	//! converts to any field type, only used unevaluated to count the fields of an aggregate
+	struct AnyField {
+		template<typename T>
+		constexpr operator T() const noexcept;
+	};
+
+	template<typename T, typename... Fields>
+	consteval size_t field_count() noexcept {
+		if constexpr (requires { T{Fields{}..., AnyField{}}; }) {
+			return internal::field_count<T, Fields..., AnyField>();
+		} else {
+			return sizeof...(Fields);
+		}
+	}
+
+	inline constexpr size_t MAX_HASHED_FIELDS = 16;
+
+	//! calls fn with every field of an aggregate, through structured bindings
+	template<typename T, typename Fn>
+	constexpr decltype(auto) visit_fields(const T& value, Fn&& fn) {
+		constexpr size_t count = internal::field_count<T>();
+		static_assert(count <= MAX_HASHED_FIELDS, "hash_value supports aggregates of up to 16 fields");
+
+		if constexpr (count == 0) {
+			return fn();
+		} else if constexpr (count == 1) {
+			const auto& [f0] = value;
+			return fn(f0);
+		} else if constexpr (count == 2) {
+			const auto& [f0, f1] = value;
+			return fn(f0, f1);
+		} else if constexpr (count == 3) {
+			const auto& [f0, f1, f2] = value;
+			return fn(f0, f1, f2);
+		} else if constexpr (count == 4) {
+			const auto& [f0, f1, f2, f3] = value;
+			return fn(f0, f1, f2, f3);
+		} else if constexpr (count == 5) {
+			const auto& [f0, f1, f2, f3, f4] = value;
+			return fn(f0, f1, f2, f3, f4);
+		} else if constexpr (count == 6) {
+			const auto& [f0, f1, f2, f3, f4, f5] = value;
+			return fn(f0, f1, f2, f3, f4, f5);
+		} else if constexpr (count == 7) {
+			const auto& [f0, f1, f2, f3, f4, f5, f6] = value;
+			return fn(f0, f1, f2, f3, f4, f5, f6);
+		} else if constexpr (count == 8) {
+			const auto& [f0, f1, f2, f3, f4, f5, f6, f7] = value;
+			return fn(f0, f1, f2, f3, f4, f5, f6, f7);
+		} else if constexpr (count == 9) {
+			const auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8] = value;
+			return fn(f0, f1, f2, f3, f4, f5, f6, f7, f8);
+		} else if constexpr (count == 10) {
+			const auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9] = value;
+			return fn(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9);
+		} else if constexpr (count == 11) {
+			const auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10] = value;
+			return fn(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10);
+		} else if constexpr (count == 12) {
+			const auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11] = value;
+			return fn(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11);
+		} else if constexpr (count == 13) {
+			const auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12] = value;
+			return fn(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12);
+		} else if constexpr (count == 14) {
+			const auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13] = value;
+			return fn(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13);
+		} else if constexpr (count == 15) {
+			const auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14] = value;
+			return fn(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14);
+		} else {
+			const auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15] = value;
+			return fn(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15);
+		}
+	}
+
+	template<typename T>
+	concept HashableAggregate = std::is_aggregate_v<T> && std::is_class_v<T> && !std::is_default_constructible_v<std::hash<T>>;
+
+	// integers, enums and aggregates made only of them, without padding: equal values have equal bytes
+	template<typename T>
+	consteval bool is_bytewise_hashable() noexcept {
+		if constexpr (std::is_array_v<T>) {
+			return internal::is_bytewise_hashable<std::remove_extent_t<T>>();
+		} else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+			return std::has_unique_object_representations_v<T>;
+		} else if constexpr (std::is_aggregate_v<T> && std::has_unique_object_representations_v<T>) {
+			using Fields = decltype(internal::visit_fields(std::declval<const T&>(), []<typename... Fs>(const Fs&...) {
+				return std::bool_constant<(internal::is_bytewise_hashable<Fs>() && ...)>{};
+			}));
+			return Fields::value;
+		} else {
+			return false;
+		}
+	}
+
+	template<typename T>
+	concept NarrowString = std::is_convertible_v<const T&, HStringView> || std::is_convertible_v<const T&, std::u8string_view> || std::is_convertible_v<const T&, std::string_view>;
+
+	template<NarrowString T>
+	constexpr HStringView narrow_view(const T& value) noexcept {
+		if constexpr (std::is_convertible_v<const T&, HStringView>) {
+			return value;
+		} else if constexpr (std::is_convertible_v<const T&, std::u8string_view>) {
+			const std::u8string_view view = value;
+			return {view.data(), view.size()};
+		} else {
+			const std::string_view view = value;
+			return {view.data(), view.size()};
+		}
+	}
+}
+
 namespace hana
 {
+	/*!
+	 * @brief Transparent hash over the code units of any char or char8_t string.
+	 *
+	 * Equal bytes hash the same whatever holds them, so a map keyed by HString can be searched with an HStringView,
+	 * a literal or a std::string without building a key.
+	 */
+	struct StringHash {
+		using is_transparent = void;
+
+		template<internal::NarrowString T>
+		constexpr size_t operator()(const T& value) const noexcept {
+			return XXHash::xxhash(internal::narrow_view(value));
+		}
+	};
+
+	//! @brief Transparent equality matching StringHash.
+	struct StringEqualTo {
+		using is_transparent = void;
+
+		template<internal::NarrowString L, internal::NarrowString R>
+		constexpr bool operator()(const L& lhs, const R& rhs) const noexcept {
+			return internal::narrow_view(lhs) == internal::narrow_view(rhs);
+		}
+	};
+
+	template<typename T>
+	[[nodiscard]] size_t hash_value(const T& value) noexcept;
+
 	template<typename T>
 	struct Hash : std::hash<T> {};
 
-	template<>
-	struct Hash<HStringView> {
-		constexpr size_t operator()(HStringView value) const noexcept {
-			return XXHash::xxhash(value);
+	template<internal::HashableAggregate T>
+	struct Hash<T> {
+		size_t operator()(const T& value) const noexcept {
+			return hana::hash_value(value);
 		}
 	};
 
 	template<>
-	struct Hash<HString> {
-		size_t operator()(const HString& value) const noexcept {
-			return XXHash::xxhash(value);
+	struct Hash<HStringView> : StringHash {};
+
+	template<size_t Size>
+	struct Hash<BasicHString<Size>> : StringHash {};
+
+	template<size_t N>
+	template<typename T>
+	constexpr size_t Hash<HFixedString<N>>::operator()(const T& value) const noexcept {
+		return StringHash{}(value);
+	}
+
+	template<>
+	struct Hash<Fingerprint128> {
+		constexpr size_t operator()(const Fingerprint128& value) const noexcept {
+			// every bit of a digest is already mixed
+			return static_cast<size_t>(value.low);
 		}
 	};
 
@@ -602,3 +1210,29 @@ namespace hana
 	template<is_char_v Char>
 	struct Hash<Char*> : Hash<std::basic_string_view<Char>> {};
 }
+
+namespace hana
+{
+	/*!
+	 * @brief Hashes a value without a hand-written Hash specialization.
+	 *
+	 * An aggregate made only of integers, enums and such aggregates, without padding, is hashed by a single xxhash over
+	 * its bytes. Any other aggregate combines the Hash of each field, found through structured bindings, so nested
+	 * aggregates, strings and floats hash by value. Aggregates with C array members are not supported; any other type
+	 * goes to Hash<T>.
+	 */
+	template<typename T>
+	size_t hash_value(const T& value) noexcept {
+		if constexpr ((std::is_class_v<T> || std::is_array_v<T>) && internal::is_bytewise_hashable<T>()) {
+			return XXHash::xxhash(std::addressof(value), 1);
+		} else if constexpr (std::is_aggregate_v<T> && std::is_class_v<T>) {
+			return internal::visit_fields(value, [](const auto&... fields) noexcept {
+				size_t seed = sizeof...(fields);
+				((seed = hana::hash_combine(seed, Hash<std::remove_cvref_t<decltype(fields)>>{}(fields))), ...);
+				return seed;
+			});
+		} else {
+			return Hash<T>{}(value);
+		}
+	}
+}
@@ -11,7 +11,11 @@ do
     add_deps("compile-flags", { public = true })
     add_packages("cr")
     add_packages("xxhash")
-    add_packages("parallel-hashmap")
+    add_packages("parallel-hashmap", { public = true })
+
+    if has_config("fmt_no_locale") then
+        add_defines("HANA_FMT_NO_LOCALE", { public = true })
+    end
 
     add_files("private/*.cpp")
     add_includedirs("private")
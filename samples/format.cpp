@@ -0,0 +1,108 @@
+#include <hana/archive/format.hpp>
+
+#include <deque>
+#include <chrono>
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+
+static size_t allocations = 0;
+
+void* operator new(size_t size) {
+	++allocations;
+	if (void* ptr = std::malloc(size)) return ptr;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+template<typename Fn>
+void runBenchmark(const char* name, Fn&& fn) {
+	constexpr int RECORDS = 1000000;
+	size_t written = 0;
+
+	const size_t allocations_before = allocations;
+	const auto t0 = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < RECORDS; ++i) {
+		written += fn(i);
+	}
+	const auto t1 = std::chrono::high_resolution_clock::now();
+
+	double span = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+	const double allocs = static_cast<double>(allocations - allocations_before) / RECORDS;
+	std::cout << "benchmark, " << name << ": " << (span / RECORDS) * 1e9 << " ns/op, " << allocs << " allocs/op (" << written << " bytes)\n";
+}
+
+int main() {
+	using namespace hana;
+	char8_t out[256];
+
+	runBenchmark("int", [&](int i) {
+		return static_cast<size_t>(format_to(out, u8"{}", i).out - out);
+	});
+	runBenchmark("int with specs", [&](int i) {
+		return static_cast<size_t>(format_to(out, u8"{:>12x}", i).out - out);
+	});
+	runBenchmark("double", [&](int i) {
+		return static_cast<size_t>(format_to(out, u8"{}", i * 0.25).out - out);
+	});
+	runBenchmark("mixed", [&](int i) {
+		return static_cast<size_t>(format_to(out, u8"[{}] {} took {:.3f}ms", i, u8"frame", i * 0.001).out - out);
+	});
+
+	HString str;
+	runBenchmark("back_inserter(HString)", [&](int i) {
+		str.clear();
+		format_to(std::back_inserter(str), u8"[{}] {} took {:.3f}ms", i, u8"frame", i * 0.001);
+		return str.size();
+	});
+	std::u8string u8str;
+	runBenchmark("back_inserter(std::u8string)", [&](int i) {
+		u8str.clear();
+		format_to(std::back_inserter(u8str), u8"[{}] {} took {:.3f}ms", i, u8"frame", i * 0.001);
+		return u8str.size();
+	});
+	std::vector<char8_t> vec;
+	runBenchmark("back_inserter(std::vector<char8_t>)", [&](int i) {
+		vec.clear();
+		format_to(std::back_inserter(vec), u8"[{}] {} took {:.3f}ms", i, u8"frame", i * 0.001);
+		return vec.size();
+	});
+	// not contiguous, so this one still goes through the generic per-character path
+	std::deque<char8_t> deq;
+	runBenchmark("back_inserter(std::deque<char8_t>)", [&](int i) {
+		deq.clear();
+		format_to(std::back_inserter(deq), u8"[{}] {} took {:.3f}ms", i, u8"frame", i * 0.001);
+		return deq.size();
+	});
+
+	// longer than the SSO capacity, so every format() result hits the heap
+	runBenchmark("format", [&](int i) {
+		return format(u8"[{}] {} took {:.3f}ms on the render thread", i, u8"frame", i * 0.001).size();
+	});
+	runBenchmark("format_scratch", [&](int i) {
+		return format_scratch(u8"[{}] {} took {:.3f}ms on the render thread", i, u8"frame", i * 0.001).size();
+	});
+
+	// custom formatters parse their spec on every call
+	const HString name{u8"render"};
+	runBenchmark("custom type with specs", [&](int i) {
+		return static_cast<size_t>(format_to(out, u8"{:>12}|{:^8}", name, name).out - out);
+	});
+	const std::vector<int> values{1, 2, 3, 4};
+	runBenchmark("range with specs", [&](int i) {
+		return static_cast<size_t>(format_to(out, u8"{::>4}", values).out - out);
+	});
+	const std::chrono::seconds elapsed{3725};
+	runBenchmark("chrono with specs", [&](int i) {
+		return static_cast<size_t>(format_to(out, u8"{:%H:%M:%S}", elapsed).out - out);
+	});
+
+#ifndef HANA_FMT_NO_LOCALE
+	const auto& loc = std::locale::classic();
+	runBenchmark("int with 'L'", [&](int i) {
+		return static_cast<size_t>(format_to(out, loc, u8"{:L}", i).out - out);
+	});
+#endif
+}
@@ -0,0 +1,119 @@
+#include <hana/utility/hash.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+template<typename Fn>
+void runBenchmark(const char* name, size_t bytes, int rounds, Fn&& fn) {
+	uint64_t result = 0;
+
+	const auto t0 = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < rounds; ++i) {
+		result += fn();
+	}
+	const auto t1 = std::chrono::high_resolution_clock::now();
+
+	double span = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+	std::cout << "benchmark, " << name << ": " << (static_cast<double>(bytes) * rounds / span) / 1e9 << " GB/s (" << result / rounds << ")\n";
+}
+
+struct VertexKey {
+	uint32_t mesh;
+	uint32_t lod;
+	uint32_t material;
+	uint32_t flags;
+};
+
+int main() {
+	using namespace hana;
+
+	constexpr size_t big = 4 * 1024 * 1024;
+	std::vector<uint8_t> data(big + 64);
+	for (size_t i = 0; i < data.size(); ++i) {
+		data[i] = static_cast<uint8_t>(i * 31 + (i >> 7));
+	}
+
+	// short keys, the mid-size path and bulk content
+	for (const size_t size: {size_t{16}, size_t{100}, size_t{240}, size_t{4096}, big}) {
+		const int rounds = static_cast<int>(std::max<size_t>(64 * 1024 * 1024 / size, 50));
+		std::cout << size << " bytes\n";
+
+		// a moving start keeps the hash from being hoisted out of the loop
+		size_t offset = 0;
+		const auto next = [&] {
+			offset = (offset + 1) & 63;
+			return data.data() + offset;
+		};
+
+		runBenchmark("xxhash64", size, rounds, [&] {
+			return XXHash::xxhash64(next(), size);
+		});
+		runBenchmark("xxhash128", size, rounds, [&] {
+			const Fingerprint128 hash = XXHash::xxhash128(next(), size);
+			return hash.low ^ hash.high;
+		});
+	}
+
+	// many short keys, one call per key against one call per batch
+	std::vector<HStringView> keys16;
+	size_t key_bytes = 0;
+	for (size_t i = 0; i + 16 <= big; i += 16) {
+		keys16.emplace_back(reinterpret_cast<const char8_t*>(data.data() + i), 8 + (i / 16) % 25);
+		key_bytes += keys16.back().size();
+	}
+	std::vector<uint64_t> hashes(keys16.size());
+	std::cout << keys16.size() << " keys of 8 to 32 bytes\n";
+
+	runBenchmark("xxhash64 per key", key_bytes, 50, [&] {
+		for (size_t i = 0; i < keys16.size(); ++i) {
+			hashes[i] = XXHash::xxhash64(keys16[i]);
+		}
+		return hashes.back();
+	});
+	runBenchmark("hash_many", key_bytes, 50, [&] {
+		XXHash::hash_many(keys16, hashes);
+		return hashes.back();
+	});
+	runBenchmark("xxhash64 per 16-byte key", hashes.size() * 16, 50, [&] {
+		for (size_t i = 0; i < hashes.size(); ++i) {
+			hashes[i] = XXHash::xxhash64(data.data() + i * 16, 16);
+		}
+		return hashes.back();
+	});
+	runBenchmark("hash_many, 16-byte keys", hashes.size() * 16, 50, [&] {
+		XXHash::hash_many(data.data(), 16, hashes);
+		return hashes.back();
+	});
+
+	// a padding free key, one xxhash over its bytes against mixing each field
+	std::vector<VertexKey> keys(4096);
+	for (uint32_t i = 0; i < keys.size(); ++i) {
+		keys[i] = {i, i & 3, i * 7, i >> 4};
+	}
+	std::cout << "VertexKey, " << sizeof(VertexKey) << " bytes\n";
+
+	runBenchmark("hash_value", sizeof(VertexKey) * keys.size(), 5000, [&] {
+		size_t result = 0;
+		for (const VertexKey& key: keys) {
+			result += hash_value(key);
+		}
+		return result;
+	});
+	runBenchmark("hash_combine per field", sizeof(VertexKey) * keys.size(), 5000, [&] {
+		size_t result = 0;
+		for (const VertexKey& key: keys) {
+			result += hash_combine(Hash<uint32_t>{}(key.mesh), Hash<uint32_t>{}(key.lod), Hash<uint32_t>{}(key.material), Hash<uint32_t>{}(key.flags));
+		}
+		return result;
+	});
+	runBenchmark("xxhash per field", sizeof(VertexKey) * keys.size(), 5000, [&] {
+		size_t result = 0;
+		for (const VertexKey& key: keys) {
+			result += hash_combine(XXHash::xxhash(&key.mesh, 1), XXHash::xxhash(&key.lod, 1), XXHash::xxhash(&key.material, 1), XXHash::xxhash(&key.flags, 1));
+		}
+		return result;
+	});
+
+	return 0;
+}
@@ -0,0 +1,295 @@
+#include <hana/container/string.hpp>
+#include <hana/container/shared_string.hpp>
+#include <hana/container/name.hpp>
+#include <hana/container/rope.hpp>
+
+#include <cctype>
+#include <chrono>
+#include <memory_resource>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+template<typename Fn>
+void runBenchmark(const char* name, size_t bytes, int rounds, Fn&& fn) {
+	uint64_t result = 0;
+
+	const auto t0 = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < rounds; ++i) {
+		result += fn();
+	}
+	const auto t1 = std::chrono::high_resolution_clock::now();
+
+	double span = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+	std::cout << "benchmark, " << name << ": " << (static_cast<double>(bytes) * rounds / span) / 1e9 << " GB/s (" << result / rounds << ")\n";
+}
+
+int main() {
+	using namespace hana;
+
+	const HStringView line = u8"2024-05-01 12:00:00.123 [info] request GET /api/v1/items?id=42 took 3.2ms status=200 user=guest";
+	HString big;
+	while (big.size() < 4 * 1024 * 1024) {
+		big.append(line);
+		big.append(u8"\n");
+	}
+	big.append(u8"needle in the haystack");
+
+	struct Input {
+		const char* name;
+		HStringView text;
+		int rounds;
+	};
+	for (const Input& input: {Input{"log line", line, 2000000}, Input{"4 MiB", big, 100}}) {
+		const HStringView text = input.text;
+		const std::u8string_view std_text = text.view();
+		std::cout << input.name << ", " << text.size() << " bytes\n";
+
+		const auto index = [&](HStringView::const_data_reference found) -> uint64_t { return found ? found.index() : text.size(); };
+		const auto std_index = [&](size_t found) -> uint64_t { return found != std_text.npos ? found : text.size(); };
+
+		runBenchmark("find", text.size(), input.rounds, [&] {
+			return index(text.find(HStringView{u8"needle"}));
+		});
+		runBenchmark("find (std)", text.size(), input.rounds, [&] {
+			return std_index(std_text.find(u8"needle"));
+		});
+		runBenchmark("find_first_of", text.size(), input.rounds, [&] {
+			return index(text.find_first_of(HStringView{u8"#!|"}));
+		});
+		runBenchmark("find_first_of (std)", text.size(), input.rounds, [&] {
+			return std_index(std_text.find_first_of(u8"#!|"));
+		});
+		runBenchmark("find_first_not_of", text.size(), input.rounds, [&] {
+			return index(text.find_first_not_of(HStringView{u8"0123456789-:. []abcdefghijklmnopqrstuvwxyzGET/?=\n"}));
+		});
+		runBenchmark("find_first_not_of (std)", text.size(), input.rounds, [&] {
+			return std_index(std_text.find_first_not_of(u8"0123456789-:. []abcdefghijklmnopqrstuvwxyzGET/?=\n"));
+		});
+		runBenchmark("count", text.size(), input.rounds, [&] {
+			return static_cast<uint64_t>(text.count(HStringView{u8"status"}));
+		});
+	}
+
+	// copies of a 4 KiB blob, handed to several owners
+	HString blob;
+	while (blob.size() < 4096) {
+		blob.append(line);
+	}
+	const HSharedString shared_blob{blob};
+	std::cout << "copy, " << blob.size() << " bytes\n";
+	runBenchmark("copy HString", blob.size(), 1000000, [&] {
+		HString copy{blob};
+		return static_cast<uint64_t>(copy.size());
+	});
+	runBenchmark("copy HSharedString", blob.size(), 1000000, [&] {
+		HSharedString copy{shared_blob};
+		return static_cast<uint64_t>(copy.size());
+	});
+
+	// map lookups keyed by module-like names
+	std::unordered_map<HString, int, Hash<HString>> by_string;
+	std::unordered_map<HName, int> by_name;
+	std::vector<HString> keys;
+	for (int i = 0; i < 64; ++i) {
+		keys.emplace_back(HString::concat(u8"HanaModule.Subsystem.", HString{std::to_string(i).c_str()}));
+		by_string.emplace(keys.back(), i);
+		by_name.emplace(HName{keys.back()}, i);
+	}
+	std::vector<HName> names{keys.begin(), keys.end()};
+	std::cout << "lookup, " << keys.size() << " keys\n";
+	runBenchmark("find HString key", keys.size(), 100000, [&] {
+		uint64_t sum = 0;
+		for (const HString& key: keys) {
+			sum += by_string.find(key)->second;
+		}
+		return sum;
+	});
+	runBenchmark("find HName key", keys.size(), 100000, [&] {
+		uint64_t sum = 0;
+		for (const HName name: names) {
+			sum += by_name.find(name)->second;
+		}
+		return sum;
+	});
+
+	// a request parses a query into fields and builds a response, thousands of small heap strings each
+	HString query;
+	for (int i = 0; i < 2000; ++i) {
+		query.append(HString::concat(u8"field_", HString{std::to_string(i).c_str()}, u8"=value that does not fit inline&"));
+	}
+	const auto handle_request = [&](std::pmr::memory_resource* resource) {
+		std::pmr::vector<HString> values{resource};
+		HStringView{query}.split_each([&](HStringView field) {
+			const auto [key, sep, value] = field.partition(u8"=");
+			values.emplace_back(HString::concat(value, u8" (", key, u8")"));
+		}, u8"&", true);
+
+		HString response;
+		for (const HString& value: values) {
+			response.append(value);
+			response.append(u8"\n");
+		}
+		return static_cast<uint64_t>(response.size());
+	};
+	std::cout << "request, " << query.size() << " bytes\n";
+	runBenchmark("request (default)", query.size(), 1000, [&] {
+		return handle_request(std::pmr::new_delete_resource());
+	});
+	std::vector<std::byte> arena_buffer(1024 * 1024);
+	runBenchmark("request (arena)", query.size(), 1000, [&] {
+		std::pmr::monotonic_buffer_resource arena{arena_buffer.data(), arena_buffer.size()};
+		const HStringResourceScope scope{&arena};
+		return handle_request(&arena);
+	});
+
+	// a 4 MiB document built from lines inserted in the middle
+	constexpr size_t document_lines = 40000;
+	std::cout << "document, " << document_lines * (line.size() + 1) << " bytes\n";
+	runBenchmark("build HString", document_lines * (line.size() + 1), 1, [&] {
+		HString document;
+		for (size_t i = 0; i < document_lines; ++i) {
+			const size_t at = document.size() / 2 / (line.size() + 1) * (line.size() + 1);
+			document.insert(at, line);
+			document.insert(at + line.size(), u8"\n");
+		}
+		return static_cast<uint64_t>(document.size());
+	});
+	runBenchmark("build HRope", document_lines * (line.size() + 1), 1, [&] {
+		HRope document;
+		for (size_t i = 0; i < document_lines; ++i) {
+			const size_t at = document.size() / 2 / (line.size() + 1) * (line.size() + 1);
+			document.insert(at, line);
+			document.insert(at + line.size(), u8"\n");
+		}
+		return static_cast<uint64_t>(document.flatten().size());
+	});
+
+	// a path assembled from several pieces
+	const HString directory{u8"/var/lib/hana/modules/"};
+	const HString module{u8"HanaGraphvizExporter"};
+	const HString version{u8"1.12.0-preview"};
+	const size_t path_size = directory.size() + module.size() * 2 + version.size() + 5;
+	std::cout << "path, " << path_size << " bytes\n";
+	runBenchmark("append chain", path_size, 1000000, [&] {
+		HString path{directory};
+		path.append(module);
+		path.append(u8"/");
+		path.append(version);
+		path.append(u8"/");
+		path.append(module);
+		path.append(u8".so");
+		return static_cast<uint64_t>(path.size());
+	});
+	runBenchmark("operator+", path_size, 1000000, [&] {
+		HString path = directory + module + u8"/" + version + u8"/" + module + u8".so";
+		return static_cast<uint64_t>(path.size());
+	});
+
+	// case-insensitive header matching and lowering the whole log
+	const HStringView headers[] = {
+		u8"Accept", u8"Accept-Encoding", u8"Authorization", u8"Cache-Control", u8"Connection", u8"Content-Length",
+		u8"Content-Type", u8"Cookie", u8"Host", u8"If-None-Match", u8"User-Agent", u8"X-Request-Id",
+	};
+	const HStringView wanted = u8"CONTENT-TYPE";
+	size_t headers_size = 0;
+	for (const auto& header: headers) {
+		headers_size += header.size();
+	}
+	std::cout << "headers, " << headers_size << " bytes\n";
+	runBenchmark("per-byte tolower loop", headers_size, 1000000, [&] {
+		uint64_t found = 0;
+		for (const auto& header: headers) {
+			bool equal = header.size() == wanted.size();
+			for (size_t i = 0; equal && i < header.size(); ++i) {
+				equal = std::tolower(header[i]) == std::tolower(wanted[i]);
+			}
+			found += equal;
+		}
+		return found;
+	});
+	runBenchmark("iequals", headers_size, 1000000, [&] {
+		uint64_t found = 0;
+		for (const auto& header: headers) {
+			found += header.iequals(wanted);
+		}
+		return found;
+	});
+	runBenchmark("per-byte tolower, 4 MiB", big.size(), 20, [&] {
+		HString lower{big.size(), u8' '};
+		for (size_t i = 0; i < big.size(); ++i) {
+			lower.data()[i] = static_cast<char8_t>(std::tolower(big[i]));
+		}
+		return static_cast<uint64_t>(lower.size());
+	});
+	runBenchmark("ToLower, 4 MiB", big.size(), 20, [&] {
+		return static_cast<uint64_t>(big.ToLower().size());
+	});
+	runBenchmark("ifind, 4 MiB", big.size(), 20, [&] {
+		return static_cast<uint64_t>(big.ifind(u8"NEEDLE IN THE").index());
+	});
+
+	// short keys, one in ten longer than 15 bytes, stored with each inline capacity
+	std::vector<HString> short_keys;
+	size_t short_keys_size = 0;
+	for (int i = 0; i < 200000; ++i) {
+		const HString number{std::to_string(i * 7919 % 200000).c_str()};
+		short_keys.emplace_back(i % 10 ? HString::concat(u8"key_", number) : HString::concat(u8"module.subsystem.", number));
+		short_keys_size += short_keys.back().size();
+	}
+	std::cout << "short keys, " << short_keys.size() << " keys, " << short_keys_size << " bytes\n";
+	const auto bench_sso_size = [&]<size_t Size>() {
+		using String = BasicHString<Size>;
+		const std::string suffix = " <" + std::to_string(Size) + ">";
+
+		std::vector<String> strings;
+		strings.reserve(short_keys.size());
+		size_t heap_bytes = 0;
+		for (const HString& key: short_keys) {
+			const String& string = strings.emplace_back(HStringView{key});
+			heap_bytes += string.is_heap() ? string.capacity() + 1 : 0;
+		}
+		std::cout << "footprint" << suffix << ": " << sizeof(String) << " bytes inline, "
+				  << (sizeof(String) * strings.size() + heap_bytes) / 1e6 << " MB\n";
+
+		runBenchmark(("construct" + suffix).c_str(), short_keys_size, 20, [&] {
+			std::vector<String> built;
+			built.reserve(short_keys.size());
+			for (const HString& key: short_keys) {
+				built.emplace_back(HStringView{key});
+			}
+			return static_cast<uint64_t>(built.size());
+		});
+		runBenchmark(("compare" + suffix).c_str(), short_keys_size, 20, [&] {
+			uint64_t less = 0;
+			for (size_t i = 1; i < strings.size(); ++i) {
+				less += strings[i - 1] < strings[i];
+			}
+			return less;
+		});
+	};
+	bench_sso_size.template operator()<15>();
+	bench_sso_size.template operator()<31>();
+	bench_sso_size.template operator()<63>();
+
+	// splitting the query into fields, collected into a vector, visited and walked lazily
+	std::cout << "split, " << query.size() << " bytes\n";
+	std::vector<HStringView> fields;
+	runBenchmark("split into vector", query.size(), 1000, [&] {
+		fields.clear();
+		return static_cast<uint64_t>(HStringView{query}.split(fields, u8"&", true));
+	});
+	runBenchmark("split_each", query.size(), 1000, [&] {
+		uint64_t count = 0;
+		HStringView{query}.split_each([&](HStringView) { ++count; }, u8"&", true);
+		return count;
+	});
+	runBenchmark("split_view", query.size(), 1000, [&] {
+		uint64_t count = 0;
+		for (HStringView field: HStringView{query}.split_view(u8"&", true)) {
+			count += !field.empty();
+		}
+		return count;
+	});
+}
\ No newline at end of file
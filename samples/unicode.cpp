@@ -0,0 +1,93 @@
+#include <hana/container/string.hpp>
+#include <hana/container/text_index.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+template<typename Fn>
+void runBenchmark(const char* name, size_t bytes, Fn&& fn) {
+	constexpr int ROUNDS = 200;
+	uint64_t result = 0;
+
+	const auto t0 = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < ROUNDS; ++i) {
+		result += fn();
+	}
+	const auto t1 = std::chrono::high_resolution_clock::now();
+
+	double span = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+	std::cout << "benchmark, " << name << ": " << (static_cast<double>(bytes) * ROUNDS / span) / 1e9 << " GB/s (" << result / ROUNDS << ")\n";
+}
+
+int main() {
+	using namespace hana;
+
+	HString ascii;
+	HString mixed;
+	for (int i = 0; i < 16 * 1024; ++i) {
+		ascii.append(u8"plain ascii text ");
+		mixed.append(u8"Gĝ鸡🐓 текст ");
+	}
+
+	for (const HString* text: {&ascii, &mixed}) {
+		const auto* data = text->data();
+		const auto size = text->size();
+		std::cout << (text == &ascii ? "ascii" : "mixed") << ", " << size << " bytes\n";
+
+		runBenchmark("utf8_validate", size, [&] {
+			return static_cast<uint64_t>(unicode::utf8_validate(data, size));
+		});
+		runBenchmark("text_length", size, [&] {
+			return HStringView{*text}.text_length();
+		});
+		runBenchmark("text_length (scalar)", size, [&] {
+			return unicode::internal::utf8_code_point_index_scalar(data, size, size - 1) + 1;
+		});
+		runBenchmark("text_index_to_buffer", size, [&] {
+			return HStringView{*text}.text_index_to_buffer(HStringView{*text}.text_length() - 1);
+		});
+
+		// 256 lookups spread over the text, the index is built once per string
+		const auto length = text->text_length();
+		runBenchmark("text_index_to_buffer x256", size, [&] {
+			uint64_t total = 0;
+			for (size_t i = 0; i < length; i += length / 256) {
+				total += text->text_index_to_buffer(i);
+			}
+			return total;
+		});
+		HStringTextIndex index{*text};
+		runBenchmark("text_index_to_buffer x256 (HStringTextIndex)", size, [&] {
+			uint64_t total = 0;
+			for (size_t i = 0; i < length; i += length / 256) {
+				total += index.text_index_to_buffer(i);
+			}
+			return total;
+		});
+	}
+
+	std::u16string ascii16;
+	std::u16string mixed16;
+	for (int i = 0; i < 16 * 1024; ++i) {
+		ascii16.append(u"plain ascii text ");
+		mixed16.append(u"Gĝ鸡🐓 текст ");
+	}
+
+	for (const std::u16string* text: {&ascii16, &mixed16}) {
+		const auto* data = text->data();
+		const auto size = text->size();
+		std::cout << (text == &ascii16 ? "ascii" : "mixed") << " utf-16, " << size * sizeof(char16_t) << " bytes\n";
+
+		runBenchmark("HString(const char16_t*)", size * sizeof(char16_t), [&] {
+			return HString{data, size}.size();
+		});
+		runBenchmark("HString(const char16_t*) short", size * sizeof(char16_t), [&] {
+			uint64_t total = 0;
+			for (size_t i = 0; i + 40 <= size; i += 40) {
+				total += HString{data + i, 40}.size();
+			}
+			return total;
+		});
+	}
+}
\ No newline at end of file
@@ -9,6 +9,10 @@ function SAMPLE(name)
 end
 
 SAMPLE("log")
+SAMPLE("format")
+SAMPLE("unicode")
+SAMPLE("string")
+SAMPLE("hash")
 SAMPLE("crash")
 SAMPLE("process")
 
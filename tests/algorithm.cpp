@@ -2,6 +2,8 @@
 
 #include <hana/unicode/iterator.hpp>
 
+#include <string>
+
 TEST_CASE("Test Unicode") {
 	using namespace hana::unicode;
 
@@ -125,6 +127,47 @@ TEST_CASE("Test Unicode") {
 		CHECK_EQ(utf8_code_unit_index(test_str, 6, 2), 5);
 	}
 
+	SUBCASE("UTF-8 validate") {
+		static_assert(utf8_validate(u8"Gĝ鸡🐓", 10));
+		static_assert(!utf8_validate(u8"\xC0\x80", 2));
+		static_assert(utf8_code_point_count(u8"Gĝ鸡🐓", 10) == 4);
+
+		// long enough to go through the vector kernels, with the odd code point across a block border
+		std::u8string text;
+		for (int i = 0; i < 40; ++i) {
+			text += u8"ascii text Gĝ鸡🐓";
+		}
+		const auto* data = text.data();
+		CHECK(utf8_validate(data, text.size()));
+		CHECK_EQ(utf8_code_point_count(data, text.size()), 40 * 15);
+		CHECK_EQ(utf8_code_point_count(data, text.size()), internal::utf8_code_point_index_scalar(data, text.size(), text.size() - 1) + 1);
+		for (uint64_t i = 0; i < text.size(); i += 7) {
+			CHECK_EQ(utf8_code_point_index(data, static_cast<uint32_t>(text.size()), i), internal::utf8_code_point_index_scalar(data, text.size(), i));
+		}
+		for (uint64_t i = 0; i < 40 * 15; i += 11) {
+			CHECK_EQ(utf8_code_unit_index(data, static_cast<uint32_t>(text.size()), i), internal::utf8_code_unit_index_scalar(data, text.size(), i));
+		}
+
+		// every kind of ill-formed input, placed at each offset of a block
+		const std::u8string bad_seqs[] = {
+			u8"\x80", u8"\xC0\x80", u8"\xC1\xBF", u8"\xE0\x9F\xBF", u8"\xED\xA0\x80", u8"\xF0\x8F\xBF\xBF",
+			u8"\xF4\x90\x80\x80", u8"\xF5\x80\x80\x80", u8"\xFF", u8"\xE4\xB8", u8"\xC3", u8"\xF0\x9F\x90",
+		};
+		for (const auto& bad: bad_seqs) {
+			for (size_t offset = 0; offset < 70; offset += 3) {
+				std::u8string broken = text.substr(0, 100);
+				broken.insert(offset, bad);
+				const auto* broken_data = broken.data();
+				CHECK_FALSE(utf8_validate(broken_data, broken.size()));
+				CHECK_EQ(utf8_code_point_count(broken_data, broken.size()), internal::utf8_code_point_index_scalar(broken_data, broken.size(), broken.size() - 1) + 1);
+
+				// truncated at the very end
+				const std::u8string cut = text.substr(0, offset + 16) + bad;
+				CHECK_EQ(utf8_validate(cut.data(), cut.size()), internal::utf8_validate_scalar(cut.data(), cut.size()));
+			}
+		}
+	}
+
 	SUBCASE("UTF-16 index convert") {
 		const auto test_str = u"🐓鸡ĜG";
 		const auto test_str_b = u"🐓🐓🐓";
@@ -310,6 +353,80 @@ TEST_CASE("Test Unicode") {
 		CHECK_EQ(UTF16Seq(u32_1), u16_1_seq);
 	}
 
+	SUBCASE("Transcode") {
+		// the cursor walk the vector kernels have to agree with, lone surrogates keep their first byte
+		const auto reference_utf16 = [](const std::u16string& text) {
+			std::u8string result;
+			for (UTF16Seq seq: UTF16Cursor<true>{text.data(), text.size(), 0}.as_range()) {
+				if (seq.is_valid()) {
+					const UTF8Seq utf8_seq = seq;
+					result.append(utf8_seq.data, utf8_seq.len);
+				} else {
+					result.push_back(*reinterpret_cast<const char8_t*>(&seq.bad_data));
+				}
+			}
+			return result;
+		};
+		const auto transcode_utf16 = [](const std::u16string& text) {
+			std::u8string result(text_size_bound<char16_t>(text.size()), u8'\0');
+			result.resize(transcode_to_utf8(text.data(), text.size(), result.data()));
+			CHECK_EQ(result.size(), text_size(text.data(), text.size()));
+			return result;
+		};
+
+		std::u16string text16;
+		for (int i = 0; i < 20; ++i) {
+			text16 += u"ascii text, more ascii Gĝ鸡🐓";
+		}
+		CHECK_EQ(transcode_utf16(text16), reference_utf16(text16));
+
+		const std::u16string bad16[] = {u"\xD83D", u"\xDC13", u"\xDC13\xD83D", u"\xD83DG"};
+		for (const auto& bad: bad16) {
+			for (size_t offset = 0; offset < 40; offset += 3) {
+				std::u16string broken = text16.substr(0, 60);
+				broken.insert(offset, bad);
+				CHECK_EQ(transcode_utf16(broken), reference_utf16(broken));
+				// cut at the very end
+				const std::u16string cut = text16.substr(0, offset + 16) + bad;
+				CHECK_EQ(transcode_utf16(cut), reference_utf16(cut));
+			}
+		}
+
+		std::u32string text32;
+		for (int i = 0; i < 20; ++i) {
+			text32 += U"ascii text, more ascii Gĝ鸡🐓";
+		}
+		text32 += U'\xD800';
+		text32 += U'\x10FFFF';
+		std::u8string reference32;
+		for (char32_t ch: text32) {
+			const UTF8Seq utf8_seq = ch;
+			reference32.append(utf8_seq.data, utf8_seq.len);
+		}
+		std::u8string result32(text_size_bound<char32_t>(text32.size()), u8'\0');
+		result32.resize(transcode_to_utf8(text32.data(), text32.size(), result32.data()));
+		CHECK_EQ(result32, reference32);
+		CHECK_EQ(text_size(text32.data(), text32.size()), reference32.size());
+
+		// and back, ill-formed utf-8 becomes U+FFFD
+		std::u8string text8 = reference_utf16(text16);
+		std::u16string back16(text8.size(), u'\0');
+		back16.resize(transcode_from_utf8(text8.data(), text8.size(), back16.data()));
+		CHECK_EQ(back16, text16);
+		std::u32string back32(text8.size(), U'\0');
+		back32.resize(transcode_from_utf8(text8.data(), text8.size(), back32.data()));
+		CHECK_EQ(back32, text32.substr(0, text32.size() - 2));
+
+		text8.insert(10, u8"\xE4\xB8");
+		text8.push_back(u8'\xFF');
+		std::u16string broken16(text8.size(), u'\0');
+		broken16.resize(transcode_from_utf8(text8.data(), text8.size(), broken16.data()));
+		std::u16string expected16 = text16;
+		expected16.insert(10, u"\xFFFD");
+		expected16.push_back(u'\xFFFD');
+		CHECK_EQ(broken16, expected16);
+	}
+
 	SUBCASE("UTF-8 iterator") {
 		using Cursor = UTF8Cursor<false>;
 		using CCursor = UTF8Cursor<true>;
@@ -575,4 +692,52 @@ TEST_CASE("Test Unicode") {
 			}
 		}
 	}
+
+	SUBCASE("case mapping") {
+		// ascii
+		CHECK_EQ(to_lower(U'A'), U'a');
+		CHECK_EQ(to_lower(U'z'), U'z');
+		CHECK_EQ(to_lower(U'@'), U'@');
+		CHECK_EQ(to_upper(U'a'), U'A');
+		CHECK_EQ(to_upper(U'['), U'[');
+		CHECK_EQ(casefold(U'Z'), U'z');
+
+		// runs and alternating pairs
+		CHECK_EQ(to_lower(U'Ä'), U'ä');
+		CHECK_EQ(to_upper(U'ä'), U'Ä');
+		CHECK_EQ(to_lower(U'Ĝ'), U'ĝ');
+		CHECK_EQ(to_upper(U'ĝ'), U'Ĝ');
+		CHECK_EQ(to_lower(U'ĝ'), U'ĝ');
+		CHECK_EQ(to_lower(U'Ж'), U'ж');
+		CHECK_EQ(to_upper(U'ω'), U'Ω');
+		CHECK_EQ(to_lower(U'𐐀'), U'𐐨');
+		CHECK_EQ(to_upper(U'𐐨'), U'𐐀');
+
+		// mappings crossing the ascii boundary or changing the utf-8 length
+		CHECK_EQ(to_lower(U'\u212A'), U'k');
+		CHECK_EQ(to_upper(U'ſ'), U'S');
+		CHECK_EQ(to_upper(U'ı'), U'I');
+		CHECK_EQ(to_lower(U'İ'), U'i');
+		CHECK_EQ(to_upper(U'ɐ'), U'Ɐ');
+		CHECK_EQ(to_lower(U'Ⱥ'), U'ⱥ');
+
+		// simple mappings only, no 1:n expansion
+		CHECK_EQ(to_upper(U'ß'), U'ß');
+		CHECK_EQ(to_lower(U'ẞ'), U'ß');
+		CHECK_EQ(casefold(U'ß'), U'ß');
+		CHECK_EQ(casefold(U'ẞ'), U'ß');
+		CHECK_EQ(casefold(U'İ'), U'İ');
+
+		// folding differs from lowercase
+		CHECK_EQ(casefold(U'µ'), U'μ');
+		CHECK_EQ(casefold(U'ς'), U'σ');
+		CHECK_EQ(to_lower(U'ς'), U'ς');
+		CHECK_EQ(casefold(U'ꭰ'), U'Ꭰ');
+		CHECK_EQ(to_upper(U'ꭰ'), U'Ꭰ');
+
+		// no mapping
+		CHECK_EQ(to_lower(U'鸡'), U'鸡');
+		CHECK_EQ(to_upper(U'🐓'), U'🐓');
+		CHECK_EQ(casefold(U'\uFFFD'), U'\uFFFD');
+	}
 }
@@ -2,8 +2,18 @@
 
 #include <hana/archive/format.hpp>
 
+#include <map>
+#include <deque>
+#include <set>
+#include <tuple>
+#include <chrono>
 #include <string>
+#include <vector>
+#include <variant>
 #include <iterator>
+#include <type_traits>
+#include <optional>
+#include <memory_resource>
 
 struct Person {
 	std::string name{"hhh"};
@@ -26,6 +36,17 @@ struct hana::formatter<Person> : hana::formatter<hana::HString> {
 	}
 };
 
+struct ScratchUser {};
+
+template<>
+struct hana::formatter<ScratchUser> : hana::formatter<hana::HStringView> {
+	using base = hana::formatter<hana::HStringView>;
+
+	hana::fmt::context::iterator format(const ScratchUser&, hana::fmt::context& ctx) const {
+		return base::format(hana::format_scratch(u8"{}", 1), ctx);
+	}
+};
+
 TEST_CASE("sakura") {
 	using namespace hana;
 	// escaped braces
@@ -61,6 +82,12 @@ TEST_CASE("sakura") {
 
 	CHECK_EQ(HStringView{ u8"Female hhh's age is 18" }, format(u8"{}", Person{}));
 
+	// shared strings format as text, not as a range of code units
+	const HSharedString shared{u8"abc"};
+	CHECK_EQ(format(u8"{}", shared), u8"abc");
+	CHECK_EQ(format(u8"{:*>6.2}", shared), u8"****ab");
+	CHECK_EQ(format(u8"{}", std::vector{shared, HSharedString{u8"de"}}), u8"[\"abc\", \"de\"]");
+
 	char c = 120;
 	CHECK_EQ(format(u8"{:6}", 42), u8"    42");
 	CHECK_EQ(format(u8"{:6}", 'x'), u8"x     ");
@@ -69,4 +96,245 @@ TEST_CASE("sakura") {
 	CHECK_EQ(format(u8"{:*^6}", 'x'), u8"**x***");
 	CHECK_EQ(format(u8"{:6d}", c), u8"   120");
 	CHECK_EQ(format(u8"{:6}", true), u8"true  ");
+
+#ifndef HANA_FMT_NO_LOCALE
+	CHECK_EQ(format(std::locale::classic(), u8"{:L}", 1234567), u8"1234567");
+	CHECK_EQ(format(std::locale::classic(), u8"{:L}", true), u8"true");
+#endif
+}
+
+TEST_CASE("ranges") {
+	using namespace hana;
+	std::vector<int> v{1, 2, 3};
+	CHECK_EQ(format(u8"{}", v), u8"[1, 2, 3]");
+	CHECK_EQ(format(u8"{:n}", v), u8"1, 2, 3");
+	CHECK_EQ(format(u8"{::02x}", v), u8"[01, 02, 03]");
+	CHECK_EQ(format(u8"{}", std::vector<int>{}), u8"[]");
+	CHECK_EQ(format(u8"{}", std::vector<std::vector<int>>{{1}, {2, 3}}), u8"[[1], [2, 3]]");
+	CHECK_EQ(format(u8"{}", std::vector<std::string>{"a", "b"}), u8"[\"a\", \"b\"]");
+	CHECK_EQ(format(u8"{::}", std::vector<std::string>{"a", "b"}), u8"[a, b]");
+	CHECK_EQ(format(u8"{}", std::vector<char>{'a', 'b'}), u8"['a', 'b']");
+
+	int arr[] = {4, 5};
+	CHECK_EQ(format(u8"{}", arr), u8"[4, 5]");
+
+	CHECK_EQ(format(u8"{}", std::set<int>{3, 1}), u8"{1, 3}");
+	CHECK_EQ(format(u8"{}", std::map<int, HString>{{1, u8"one"}, {2, u8"two"}}), u8"{1: \"one\", 2: \"two\"}");
+	CHECK_EQ(format(u8"{:m}", std::vector<std::pair<int, int>>{{1, 2}}), u8"{1: 2}");
+
+	// tuple & pair
+	CHECK_EQ(format(u8"{}", std::pair{1, 2.5}), u8"(1, 2.5)");
+	CHECK_EQ(format(u8"{:n}", std::pair{1, 2.5}), u8"1, 2.5");
+	CHECK_EQ(format(u8"{:m}", std::pair{1, 2.5}), u8"1: 2.5");
+	CHECK_EQ(format(u8"{}", std::tuple{1, "x", 'c'}), u8"(1, \"x\", 'c')");
+	CHECK_EQ(format(u8"{}", std::tuple<>{}), u8"()");
+
+	// optional & variant
+	CHECK_EQ(format(u8"{}", std::optional<int>{42}), u8"optional(42)");
+	CHECK_EQ(format(u8"{}", std::optional<int>{}), u8"none");
+	CHECK_EQ(format(u8"{:n:x}", std::optional<int>{255}), u8"ff");
+	CHECK_EQ(format(u8"{}", std::variant<int, std::string>{"s"}), u8"variant(\"s\")");
+	CHECK_EQ(format(u8"{:n}", std::variant<int, std::string>{7}), u8"7");
+	CHECK_EQ(format(u8"{}", std::variant<std::monostate, int>{}), u8"variant(monostate)");
+}
+
+TEST_CASE("chrono") {
+	using namespace hana;
+	using namespace std::chrono;
+
+	// duration
+	CHECK_EQ(format(u8"{}", 42ms), u8"42ms");
+	CHECK_EQ(format(u8"{}", 3s), u8"3s");
+	CHECK_EQ(format(u8"{}", 5min), u8"5min");
+	CHECK_EQ(format(u8"{}", duration<double>{1.5}), u8"1.5s");
+	CHECK_EQ(format(u8"{}", duration<int, std::ratio<3, 7>>{2}), u8"2[3/7]s");
+	CHECK_EQ(format(u8"{:%H:%M:%S}", 3723500ms), u8"01:02:03.500");
+	CHECK_EQ(format(u8"{:%T}", -90s), u8"-00:01:30");
+	CHECK_EQ(format(u8"{:%Q %q}", 7us), u8"7 µs");
+	CHECK_EQ(format(u8"{:*>8%R}", 61min), u8"***01:01");
+
+	// padding uses the estimated display width, also across the measuring chunks
+	CHECK_EQ(format(u8"{:*>10%H時%M分}", 61min), u8"**01時01分");
+	HString wide;
+	for (int i = 0; i < 15; ++i) wide.append(u8"01中");
+	CHECK_EQ(format(u8"{:*<64%H中%H中%H中%H中%H中%H中%H中%H中%H中%H中%H中%H中%H中%H中%H中}", 1h), wide + u8"****");
+	const HString accented = HString(62, u8'a') + u8"e\u0301";
+	const HString pattern = u8"{:*>65" + accented + u8"}";
+	const auto hour = 1h;
+	CHECK_EQ(
+		hana::vformat(pattern, fmt::format_args(fmt::make_format_store(hour), fmt::make_descriptor<const hours&>())),
+		u8"**" + accented
+	);
+
+	// time point
+	const sys_days day = 2024y / February / 29;
+	CHECK_EQ(format(u8"{}", sys_seconds{day + 13h + 5min + 9s}), u8"2024-02-29 13:05:09");
+	CHECK_EQ(format(u8"{}", day + 13h + 5min + 9s + 7ms), u8"2024-02-29 13:05:09.007");
+	CHECK_EQ(format(u8"{}", day + 13h + 5min + 9s + 8ms), u8"2024-02-29 13:05:09.008");
+	CHECK_EQ(format(u8"{:%F}", day), u8"2024-02-29");
+	CHECK_EQ(format(u8"{:%a %b %e %j %I%p %Z}", sys_seconds{day + 13h}), u8"Thu Feb 29 060 01PM UTC");
+	CHECK_EQ(format(u8"{:%D %u %w}", day), u8"02/29/24 4 4");
+	CHECK_EQ(format(u8"{:[%Y]}", sys_days{1969y / December / 31}), u8"[1969]");
+	CHECK_EQ(format(u8"{}", sys_seconds{-1s}), u8"1969-12-31 23:59:59");
+
+	// hh_mm_ss
+	CHECK_EQ(format(u8"{}", hh_mm_ss{4h + 3min + 2s}), u8"04:03:02");
+	CHECK_EQ(format(u8"{:%H.%M}", hh_mm_ss{26h + 3min}), u8"26.03");
+
+	// nested in ranges
+	CHECK_EQ(format(u8"{}", std::vector{1s, 2s}), u8"[1s, 2s]");
+}
+
+TEST_CASE("back_inserter") {
+	using namespace hana;
+
+	HString str{u8"id="};
+	format_to(std::back_inserter(str), u8"{}-{}", 42, u8"abc");
+	CHECK_EQ(str, u8"id=42-abc");
+	// grows through resize_and_overwrite several times, the text written so far survives
+	format_to(std::back_inserter(str), u8";{}", std::vector<int>(200, 3));
+	CHECK_EQ(str.size(), 9 + 1 + 200 * 3);
+	CHECK(HStringView{str}.starts_with(HStringView{u8"id=42-abc;[3, 3"}));
+	CHECK(HStringView{str}.ends_with(HStringView{u8"3, 3]"}));
+
+	std::u8string u8str;
+	format_to(std::back_inserter(u8str), u8"{:>100}", 1);
+	CHECK_EQ(u8str.size(), 100);
+	CHECK_EQ(u8str.back(), u8'1');
+
+	std::vector<char8_t> vec{u8'['};
+	format_to(std::back_inserter(vec), u8"{}]", std::vector<int>(300, 7));
+	CHECK_EQ(vec.size(), 1 + 2 + 300 * 3 - 2 + 1);
+	CHECK_EQ(vec.front(), u8'[');
+	CHECK_EQ(vec.back(), u8']');
+
+	// the generic iterator path is still used for other containers
+	std::deque<char8_t> deq;
+	format_to(std::back_inserter(deq), u8"{}", 12345);
+	CHECK_EQ(deq.size(), 5);
+}
+
+// evaluates the compile-time format checker; a rejected string is a substitution failure
+template<typename... Args>
+consteval bool parses(hana::HStringView fmt) {
+	hana::fmt::parse_format_string(fmt, hana::fmt::format_checker<Args...>{fmt});
+	return true;
+}
+
+template<typename... Args>
+concept dynamic_width_compiles = requires { typename std::bool_constant<parses<Args...>(u8"{:{}}")>; };
+
+template<typename... Args>
+concept dynamic_precision_compiles = requires { typename std::bool_constant<parses<Args...>(u8"{:.{}}")>; };
+
+TEST_CASE("parse cache") {
+	using namespace hana;
+
+	const HString name{u8"abc"};
+	for (int i = 0; i < 3; ++i) {
+		CHECK_EQ(format(u8"[{:>5}]", name), u8"[  abc]");
+		CHECK_EQ(format(u8"[{:<{}}]", name, 4 + i), format(u8"[{:<{}}]", HStringView{name}, 4 + i));
+	}
+
+	// a runtime format string rewritten in place must not reuse the stale spec
+	char8_t text[] = u8"{:>5}";
+	const auto format_name = [&] {
+		return hana::vformat(HStringView{text}, fmt::format_args(fmt::make_format_store(name), fmt::make_descriptor<const HString&>()));
+	};
+	CHECK_EQ(format_name(), u8"  abc");
+	text[2] = u8'<';
+	CHECK_EQ(format_name(), u8"abc  ");
+
+	// the cached specs still check dynamic width and precision arguments at compile time
+	static_assert(dynamic_width_compiles<HString, int>);
+	static_assert(dynamic_width_compiles<HString, unsigned long long>);
+	static_assert(!dynamic_width_compiles<HString, double>);
+	static_assert(!dynamic_width_compiles<HString, const char8_t*>);
+	static_assert(dynamic_precision_compiles<double, int>);
+	static_assert(!dynamic_precision_compiles<double, double>);
+	static_assert(!dynamic_precision_compiles<double, bool>);
+}
+
+TEST_CASE("memory_buffer") {
+	using namespace hana;
+
+	fmt::memory_buffer<16> small;
+	format_to(std::back_inserter(small), u8"{}-{}", 42, u8"abc");
+	CHECK_EQ(HStringView(small.data(), small.size()), u8"42-abc");
+	CHECK_EQ(small.to_string(), u8"42-abc");
+	CHECK_EQ(std::move(small).to_string(), u8"42-abc");
+	CHECK_EQ(small.size(), 0);
+
+	// a spilled buffer is adopted by HString without copying
+	fmt::memory_buffer<16> large;
+	format_to(std::back_inserter(large), u8"{:>100}", 1);
+	const char8_t* heap = large.data();
+	HString adopted = std::move(large).to_string();
+	CHECK_EQ(adopted.size(), 100);
+	CHECK_EQ(adopted.data(), heap);
+	CHECK_EQ(adopted.back(), u8'1');
+	adopted.append(u8"!");
+	CHECK_EQ(adopted.size(), 101);
+
+	// arena allocators can back the spill storage
+	std::byte arena[1024];
+	std::pmr::monotonic_buffer_resource resource{arena, sizeof(arena)};
+	fmt::memory_buffer<8, std::pmr::polymorphic_allocator<char8_t>> pmr_buf{&resource};
+	format_to(std::back_inserter(pmr_buf), u8"{}", std::vector<int>(10, 5));
+	CHECK_EQ(std::move(pmr_buf).to_string(), u8"[5, 5, 5, 5, 5, 5, 5, 5, 5, 5]");
+
+	// pmr allocators never propagate, move assignment only steals the block when both share a resource
+	using pmr_buffer = fmt::memory_buffer<8, std::pmr::polymorphic_allocator<char8_t>>;
+	std::pmr::monotonic_buffer_resource other_resource;
+	pmr_buffer source{&resource};
+	format_to(std::back_inserter(source), u8"{:>40}", 7);
+	const char8_t* spilled = source.data();
+
+	pmr_buffer same{&resource};
+	same = std::move(source);
+	CHECK_EQ(same.data(), spilled);
+	CHECK_EQ(same.size(), 40);
+
+	pmr_buffer foreign{&other_resource};
+	format_to(std::back_inserter(foreign), u8"x");
+	foreign = std::move(same);
+	CHECK_NE(foreign.data(), spilled);
+	CHECK_EQ(foreign.get_allocator().resource(), &other_resource);
+	CHECK_EQ(same.size(), 0);
+	CHECK_EQ(std::move(foreign).to_string(), HString{u8"                                       7"});
+}
+
+TEST_CASE("format_scratch") {
+	using namespace hana;
+
+	const HStringView first = format_scratch(u8"{}-{}", 42, u8"abc");
+	CHECK_EQ(first, u8"42-abc");
+	const char8_t* storage = first.data();
+
+	// the same storage is reused by the next call on this thread
+	const HStringView second = format_scratch(u8"{:>8}", 7);
+	CHECK_EQ(second, u8"       7");
+	CHECK_EQ(second.data(), storage);
+
+	// a formatter must not format into the scratch buffer it is being written to
+	CHECK_THROWS((void)format_scratch(u8"{}", ScratchUser{}));
+	CHECK_EQ(format_scratch(u8"{}", 1), u8"1");
+
+	// a previous view as argument or format string is formatted into the second buffer
+	const HStringView inner = format_scratch(u8"{}", u8"abcdef");
+	const HStringView outer = format_scratch(u8"<{}>", inner);
+	CHECK_EQ(outer, u8"<abcdef>");
+	CHECK_NE(outer.data(), inner.data());
+	CHECK_EQ(inner, u8"abcdef");
+	const HStringView again = format_scratch(u8"{}", outer);
+	CHECK_EQ(again, u8"<abcdef>");
+	CHECK_EQ(again.data(), storage);
+	const HStringView pattern = format_scratch(u8"[{}]{}", u8"{}", u8"{:>3}");
+	const int five = 5;
+	CHECK_EQ(hana::vformat_scratch(pattern.subview(4), fmt::format_args(fmt::make_format_store(five), fmt::make_descriptor<const int&>())), u8"  5");
+
+	// views into both buffers at once cannot be honoured
+	const HStringView left = format_scratch(u8"{}", u8"left");
+	const HStringView right = format_scratch(u8"{}", left);
+	CHECK_THROWS((void)format_scratch(u8"{}{}", left, right));
 }
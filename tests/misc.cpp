@@ -6,6 +6,9 @@
 #include <hana/utility/guid.hpp>
 #include <hana/utility/callstack.hpp>
 
+#include <cstring>
+#include <unordered_map>
+
 TEST_CASE("xxhash") {
 	using namespace hana;
 
@@ -15,6 +18,196 @@ TEST_CASE("xxhash") {
 	CHECK_EQ(Hash<HStringView>()(sv), val);
 }
 
+template<typename State, typename T>
+concept hashes_value = requires(State state, T value) { state.update(value); };
+
+TEST_CASE("xxhash streaming") {
+	using namespace hana;
+
+	// crosses the short, mid-size, internal buffer and block boundaries of XXH3
+	std::vector<uint8_t> data(4000);
+	for (size_t i = 0; i < data.size(); ++i) {
+		data[i] = static_cast<uint8_t>(i * 31 + (i >> 7));
+	}
+
+	for (const size_t length: {0, 3, 16, 100, 240, 241, 256, 257, 1024, 1100, 4000}) {
+		for (const size_t piece: {1, 7, 64, 300}) {
+			XXHashState state;
+			ConstexprXXHashState const_state;
+			XXHashState seeded{42};
+			for (size_t i = 0; i < length; i += piece) {
+				const size_t count = std::min(piece, length - i);
+				state.update(data.data() + i, count);
+				const_state.update(data.data() + i, count);
+				seeded.update(data.data() + i, count);
+			}
+			CHECK_EQ(state.digest(), XXHash::xxhash64(data.data(), length));
+			CHECK_EQ(const_state.digest(), XXHash::xxhash64(data.data(), length));
+			CHECK_EQ(seeded.digest(), XXHash::xxhash64(data.data(), length, 42));
+		}
+	}
+
+	// digest leaves the state usable, reset starts over
+	XXHashState state;
+	state.update(HStringView{u8"Hana"});
+	CHECK_EQ(state.digest(), XXHash::xxhash64(u8"Hana"));
+	state.update(HStringView{u8"Base"});
+	CHECK_EQ(state.digest(), XXHash::xxhash64(u8"HanaBase"));
+	state.reset();
+	CHECK_EQ(state.digest(), XXHash::xxhash64(u8""));
+
+	// multi-part keys and trivially copyable values
+	struct Key {
+		uint32_t id;
+		uint32_t version;
+	};
+	const Key key{7, 3};
+	XXHashState parts;
+	parts.update(key).update(uint64_t{99}).update(u8"name");
+	ConstexprXXHashState const_parts;
+	const_parts.update(key).update(uint64_t{99}).update(u8"name");
+	CHECK_EQ(parts.digest(), const_parts.digest());
+
+	// floats hash by value, long double with its padding bytes is not accepted
+	CHECK_EQ(XXHashState{}.update(0.0).digest(), XXHashState{}.update(-0.0).digest());
+	CHECK_EQ(ConstexprXXHashState{}.update(-0.0f).digest(), XXHashState{}.update(0.0f).digest());
+	CHECK_EQ(XXHashState{}.update(1.5).digest(), ConstexprXXHashState{}.update(1.5).digest());
+	static_assert(!hashes_value<XXHashState, long double>);
+	static_assert(hashes_value<XXHashState, double>);
+
+	constexpr uint64_t folded = ConstexprXXHashState{}.update(u8"Hana").update(u8"Base").digest();
+	static_assert(folded == XXHash::xxhash64(u8"HanaBase"));
+	CHECK_EQ(folded, XXHashState{}.update(u8"HanaBase").digest());
+}
+
+TEST_CASE("xxhash128") {
+	using namespace hana;
+
+	static constexpr size_t lengths[] = {0, 3, 8, 16, 17, 100, 128, 129, 240, 241, 1024, 4000};
+	static constexpr auto data = [] {
+		std::array<uint8_t, 4000> bytes{};
+		for (size_t i = 0; i < bytes.size(); ++i) {
+			bytes[i] = static_cast<uint8_t>(i * 31 + (i >> 7));
+		}
+		return bytes;
+	}();
+
+	// the constexpr port must agree with the runtime xxhash on every path of XXH3
+	constexpr auto const_hashes = [] {
+		std::array<std::pair<Fingerprint128, Fingerprint128>, std::size(lengths)> hashes{};
+		for (size_t i = 0; i < std::size(lengths); ++i) {
+			hashes[i] = {XXHash::xxhash128(data.data(), lengths[i]), XXHash::xxhash128(data.data(), lengths[i], 42)};
+		}
+		return hashes;
+	}();
+	for (size_t i = 0; i < std::size(lengths); ++i) {
+		CHECK_EQ(const_hashes[i].first, XXHash::xxhash128(data.data(), lengths[i]));
+		CHECK_EQ(const_hashes[i].second, XXHash::xxhash128(data.data(), lengths[i], 42));
+		CHECK_NE(const_hashes[i].first, const_hashes[i].second);
+	}
+
+	constexpr Fingerprint128 empty = XXHash::xxhash128(u8"");
+	CHECK_EQ(empty.to_string(), u8"99aa06d3014798d86001c324468d497f");
+	CHECK_EQ(hana::format(u8"{}", empty), u8"99aa06d3014798d86001c324468d497f");
+	CHECK_EQ(Hash<Fingerprint128>()(empty), static_cast<size_t>(empty.low));
+	CHECK((Fingerprint128{5, 1} < Fingerprint128{0, 2}));
+}
+
+namespace hash_value_test
+{
+	enum class Kind : uint8_t { vertex, pixel };
+
+	struct Key {
+		bool operator==(const Key&) const = default;
+		uint32_t id;
+		uint32_t version;
+	};
+
+	struct Padded {
+		uint8_t tag;
+		uint32_t id;
+	};
+
+	struct Nested {
+		Key key;
+		Kind kind;
+		hana::HString name;
+		double weight;
+	};
+
+	struct Empty {};
+}
+
+TEST_CASE("hash_value") {
+	using namespace hana;
+	using namespace hash_value_test;
+
+	static_assert(internal::field_count<Key>() == 2);
+	static_assert(internal::field_count<Nested>() == 4);
+	static_assert(internal::field_count<Empty>() == 0);
+	static_assert(internal::is_bytewise_hashable<Key>());
+	static_assert(!internal::is_bytewise_hashable<Padded>());
+	static_assert(!internal::is_bytewise_hashable<Nested>());
+
+	// one xxhash over the bytes of a padding free key
+	const Key key{7, 3};
+	CHECK_EQ(hash_value(key), XXHash::xxhash(&key, 1));
+	CHECK_EQ(Hash<Key>{}(key), hash_value(key));
+	CHECK_NE(hash_value(key), hash_value(Key{3, 7}));
+
+	// padding bytes never reach the hash
+	Padded a, b;
+	std::memset(&a, 0x00, sizeof(a));
+	std::memset(&b, 0xFF, sizeof(b));
+	a.tag = b.tag = 1;
+	a.id = b.id = 42;
+	CHECK_EQ(hash_value(a), hash_value(b));
+
+	// fields hash by value, strings by their text
+	const Nested n1{key, Kind::pixel, HString{u8"a name long enough to live on the heap"}, 0.0};
+	const Nested n2{key, Kind::pixel, HString{HStringView{u8"a name long enough to live on the heap"}}, -0.0};
+	CHECK_EQ(hash_value(n1), hash_value(n2));
+	CHECK_NE(hash_value(n1), hash_value(Nested{key, Kind::vertex, n1.name, 0.0}));
+	CHECK_EQ(hash_value(Empty{}), hash_value(Empty{}));
+	CHECK_EQ(hash_value(42), Hash<int>{}(42));
+
+	std::unordered_map<Key, int, Hash<Key>> map;
+	map[key] = 1;
+	CHECK_EQ(map.count(Key{7, 3}), 1);
+}
+
+TEST_CASE("xxhash hash_many") {
+	using namespace hana;
+
+	std::vector<uint8_t> data(64 * 100);
+	for (size_t i = 0; i < data.size(); ++i) {
+		data[i] = static_cast<uint8_t>(i * 31 + (i >> 7));
+	}
+
+	std::vector<HStringView> keys;
+	for (size_t i = 0; i + 40 <= data.size(); i += 40) {
+		keys.emplace_back(reinterpret_cast<const char8_t*>(data.data() + i), i % 41);
+	}
+	std::vector<uint64_t> hashes(keys.size());
+	XXHash::hash_many(keys, hashes);
+	for (size_t i = 0; i < keys.size(); ++i) {
+		CHECK_EQ(hashes[i], XXHash::xxhash64(keys[i]));
+	}
+	XXHash::hash_many(keys, hashes, 42);
+	for (size_t i = 0; i < keys.size(); ++i) {
+		CHECK_EQ(hashes[i], XXHash::xxhash64(keys[i], 42));
+	}
+
+	// specialized widths and the generic loop
+	for (const size_t width: {4, 8, 12, 16, 24, 32, 64}) {
+		std::vector<uint64_t> fixed(data.size() / width);
+		XXHash::hash_many(data.data(), width, fixed, 7);
+		for (size_t i = 0; i < fixed.size(); ++i) {
+			CHECK_EQ(fixed[i], XXHash::xxhash64(data.data() + i * width, width, 7));
+		}
+	}
+}
+
 TEST_CASE("type traits") {
 	using namespace hana;
 
@@ -1,6 +1,40 @@
 #include <doctest/doctest.h>
 
 #include <hana/container/string.hpp>
+#include <hana/container/text_index.hpp>
+#include <hana/container/shared_string.hpp>
+#include <hana/container/fixed_string.hpp>
+#include <hana/container/name.hpp>
+#include <hana/container/rope.hpp>
+#include <hana/container/string_map.hpp>
+
+#include <new>
+#include <algorithm>
+#include <thread>
+#include <cstring>
+#include <random>
+#include <atomic>
+#include <cstdlib>
+
+// counts every global allocation, so tests can assert that a code path never allocates
+static std::atomic<size_t> allocation_count{0};
+
+void* operator new(size_t size) {
+	allocation_count.fetch_add(1, std::memory_order_relaxed);
+	if (void* memory = std::malloc(size ? size : 1)) {
+		return memory;
+	}
+	throw std::bad_alloc{};
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+
+template<typename Concat>
+concept concat_can_str = requires(Concat concat) { std::forward<Concat>(concat).str(); };
+
+template<typename Concat>
+concept concat_can_chain = requires(Concat concat) { std::forward<Concat>(concat) + u8"tail"; };
 
 TEST_CASE("Test HString") {
 	using namespace hana;
@@ -38,6 +72,21 @@ TEST_CASE("Test HString") {
 		test_ctors_of_view(short_buffer);
 		test_ctors_of_view(long_literal);
 		test_ctors_of_view(long_buffer);
+
+		// fill ctor starts from a clean SSO state, whatever the storage held before;
+		// 0xFE clears the SSO flag, so stale bytes would read as a heap string
+		for (const size_t count: {size_t{0}, size_t{5}, HString::SSOCapacity, HString::SSOCapacity + 1, size_t{200}}) {
+			alignas(HString) unsigned char storage[sizeof(HString)];
+			// through a volatile pointer, so the fill isn't dropped as a dead store before the ctor
+			void* (*volatile fill)(void*, int, size_t) = std::memset;
+			fill(storage, 0xFE, sizeof(storage));
+			auto* filled = new (storage) HString(count, u8'x');
+			CHECK_EQ(filled->size(), count);
+			CHECK_GE(filled->capacity(), count);
+			CHECK_EQ(filled->c_str()[count], 0);
+			CHECK_EQ(static_cast<size_t>(std::count(filled->data(), filled->data() + count, u8'x')), count);
+			filled->~HString();
+		}
 	}
 
 	SUBCASE("copy & move") {
@@ -1421,6 +1470,78 @@ TEST_CASE("Test HString") {
 		}
 	}
 
+	SUBCASE("case") {
+		HString str = u8"Hello, World! Straße ΣΟΦΊΑ 鸡🐓";
+
+		CHECK_EQ(str.ToLower(), u8"hello, world! straße σοφία 鸡🐓");
+		CHECK_EQ(str.ToUpper(), u8"HELLO, WORLD! STRAßE ΣΟΦΊΑ 鸡🐓");
+		CHECK_EQ(str.Casefold(), u8"hello, world! straße σοφία 鸡🐓");
+		CHECK_EQ(HString{u8"ΣΟΦΊΑ ς µ"}.Casefold(), u8"σοφία σ μ");
+		CHECK_EQ(HString{u8"ΣΟΦΊΑ ς µ"}.ToLower(), u8"σοφία ς µ");
+
+		// mapped text may change size, the result is allocated once
+		HString grow = u8"ɐɐɐɐɐɐɐɐɐɐɐɐɐɐɐɐɐɐɐɐɐɐɐɐɐɐɐɐɐɐ";
+		HString upper = grow.ToUpper();
+		CHECK_EQ(upper.size(), grow.size() / 2 * 3);
+		CHECK_EQ(upper.capacity(), upper.size());
+		CHECK_EQ(upper.ToLower(), grow);
+		CHECK_EQ(HString{u8"\u212A"}.ToLower(), u8"k");
+
+		// in place
+		str.to_lower();
+		CHECK_EQ(str, u8"hello, world! straße σοφία 鸡🐓");
+		str.to_upper();
+		CHECK_EQ(str, u8"HELLO, WORLD! STRAßE ΣΟΦΊΑ 鸡🐓");
+		str.casefold();
+		CHECK_EQ(str, u8"hello, world! straße σοφία 鸡🐓");
+
+		HString empty;
+		CHECK_EQ(empty.to_upper(), u8"");
+		CHECK(empty.is_sso());
+
+		// the buffer is reused while code points keep their utf-8 length
+		HString heap = u8"Heap Text Long Enough To Leave The SSO Buffer ΣΟΦΊΑ";
+		const auto* heap_data = heap.data();
+		heap.to_lower();
+		CHECK_EQ(heap, u8"heap text long enough to leave the sso buffer σοφία");
+		CHECK_EQ(heap.data(), heap_data);
+		heap.to_upper().casefold();
+		CHECK_EQ(heap.data(), heap_data);
+
+		// a growing code point before a shrinking one keeps the size but can't map in place
+		HString mixed = u8"aȿıb";
+		CHECK_EQ(mixed.ToUpper(), u8"AⱾIB");
+		CHECK_EQ(mixed.to_upper(), u8"AⱾIB");
+		CHECK_EQ(grow.to_upper(), upper);
+		CHECK_EQ(grow.to_lower().size(), upper.size() / 3 * 2);
+
+		// long ascii goes through the vector blocks, other code units take the table
+		HString long_str;
+		for (int i = 0; i < 20; ++i) {
+			long_str.append(u8"Mixed Case ASCII text with [brackets] @ and `ticks` ~ ");
+			long_str.append(u8"Ä");
+		}
+		HString long_lower = long_str.ToLower();
+		HString long_upper = long_str.ToUpper();
+		CHECK_EQ(long_lower.size(), long_str.size());
+		CHECK(long_lower.starts_with(u8"mixed case ascii text with [brackets] @ and `ticks` ~ ä"));
+		CHECK(long_upper.starts_with(u8"MIXED CASE ASCII TEXT WITH [BRACKETS] @ AND `TICKS` ~ Ä"));
+		CHECK(long_lower.iequals(long_upper));
+		CHECK(long_str.iequals(long_lower));
+		CHECK_EQ(long_upper.ToLower(), long_lower);
+
+		// ill-formed code units are kept
+		const char8_t bad[] = {u8'A', 0xFF, u8'b', 0xC3, 0};
+		const char8_t bad_lower[] = {u8'a', 0xFF, u8'b', 0xC3, 0};
+		CHECK_EQ(HString{bad}.ToLower(), HStringView{bad_lower});
+
+		// compare & find
+		CHECK(str.iequals(u8"HELLO, WORLD! STRAßE ΣΟΦΊΑ 鸡🐓"));
+		CHECK_GT(str.icompare(u8"HELLO"), 0);
+		CHECK_EQ(str.ifind(u8"WORLD").index(), 7);
+		CHECK_EQ(std::as_const(str).ifind(u8"σοφία").index(), 22);
+	}
+
 	SUBCASE("partition") {
 		// test split by view
 		{
@@ -1642,6 +1763,21 @@ TEST_CASE("Test HString") {
 				3);
 			CHECK_EQ(count, 3);
 		}
+
+		SUBCASE("lazy split") {
+			const HString str{view};
+			CHECK(std::ranges::equal(str.split_view(split_view), split_result));
+			CHECK(std::ranges::equal(str.split_view(split_view, true), split_result_cull_empty));
+
+			const HString text{u8"name = value\r\n# comment\nother=1\n"};
+			std::vector<HStringView> keys;
+			for (const HStringView line: text.lines()) {
+				if (!line.starts_with(u8'#')) {
+					keys.push_back(*line.tokens(u8" =").begin());
+				}
+			}
+			CHECK(std::ranges::equal(keys, std::array<HStringView, 2>{u8"name", u8"other"}));
+		}
 	}
 
 	SUBCASE("factory") {
@@ -1674,6 +1810,96 @@ TEST_CASE("Test HString") {
 
 		HString result = HString::concat(build_a, build_b, build_c);
 		CHECK_EQ(result, result_view);
+		CHECK_EQ(result.capacity(), result.size());
+
+		// lazy operator+ sizes once
+		HString chained = build_a + build_b + build_c;
+		CHECK_EQ(chained, result_view);
+		CHECK_EQ(chained.capacity(), chained.size());
+		CHECK_EQ((u8"<" + build_b + u8">").size(), build_b.size() + 2);
+		HString mixed = HStringView{u8"["} + build_b;
+		mixed = mixed + u8"]";
+		CHECK_EQ(mixed, HStringView{u8"[🐓🏀]"});
+		HString short_chain = HString{u8"a"} + u8"b" + u8"c";
+		CHECK(short_chain.is_sso());
+		CHECK_EQ(short_chain, HStringView{u8"abc"});
+
+		// a named concat would outlive its temporary operands, it can neither be converted nor chained
+		using Concat = decltype(build_a + build_b);
+		static_assert(std::is_convertible_v<Concat&&, HString>);
+		static_assert(!std::is_convertible_v<Concat&, HString>);
+		static_assert(!std::is_convertible_v<const Concat&, HString>);
+		static_assert(!concat_can_str<Concat&>);
+		static_assert(concat_can_str<Concat&&>);
+		static_assert(!concat_can_chain<Concat&>);
+		static_assert(concat_can_chain<Concat&&>);
+	}
+
+	SUBCASE("builder") {
+		HStringBuilder builder;
+		CHECK(builder.empty());
+		CHECK_EQ(builder.str(), HString{});
+
+		HString piece{long_literal};
+		for (int i = 0; i < 10; ++i) {
+			builder.append(piece);
+			builder += u8", ";
+		}
+		builder.append(HStringView{});
+		CHECK_EQ(builder.size(), (piece.size() + 2) * 10);
+		HString built = builder.str();
+		CHECK_EQ(built.size(), builder.size());
+		CHECK_EQ(built.capacity(), built.size());
+		CHECK(HStringView{built}.starts_with(long_literal));
+		CHECK(HStringView{built}.ends_with(HStringView{u8", "}));
+
+		HString out{u8"head: "};
+		builder.append_to(out);
+		CHECK_EQ(out.size(), 6 + built.size());
+		CHECK(HStringView{out}.ends_with(HStringView{built}));
+
+		// pieces viewing the target itself survive the regrow
+		HString self{long_literal};
+		HStringBuilder self_builder;
+		self_builder.append(self).append(u8"|").append(self);
+		self_builder.append_to(self);
+		CHECK_EQ(self, HString::concat(long_literal, long_literal, u8"|", long_literal));
+
+		builder.clear();
+		CHECK(builder.empty());
+	}
+
+	SUBCASE("reserve_exact & resize_and_overwrite") {
+		HString str{short_literal};
+		str.reserve_exact(100);
+		CHECK_EQ(str.capacity(), 100);
+		CHECK_EQ(str, short_literal);
+		str.reserve_exact(50);
+		CHECK_EQ(str.capacity(), 100);
+		HString reserved{short_literal};
+		reserved.reserve(100);
+		CHECK_EQ(reserved, short_literal);
+
+		HString written{u8"keep "};
+		written.resize_and_overwrite(64, [](char8_t* data, size_t) {
+			CHECK_EQ(HStringView(data, 5), HStringView{u8"keep "});
+			for (size_t i = 5; i < 40; ++i) {
+				data[i] = u8'x';
+			}
+			return size_t{40};
+		});
+		CHECK_EQ(written.size(), 40);
+		CHECK_EQ(written.c_str()[40], 0);
+		CHECK_EQ(written.count(u8'x'), 35);
+
+		HString inline_text;
+		inline_text.resize_and_overwrite(8, [](char8_t* data, size_t) {
+			data[0] = u8'o';
+			data[1] = u8'k';
+			return size_t{2};
+		});
+		CHECK(inline_text.is_sso());
+		CHECK_EQ(inline_text, HStringView{u8"ok"});
 	}
 
 	SUBCASE("join") {
@@ -1778,4 +2004,722 @@ TEST_CASE("Test HString") {
 			}
 		}
 	}
+
+	SUBCASE("text index") {
+		HString text;
+		for (int i = 0; i < 50; ++i) {
+			text.append(u8"ascii 🐓鸡ĜG ");
+		}
+		// an ill-formed unit and a cut sequence are stepped over like the plain functions do
+		text.append(u8"\xFF tail \xE4\xB8");
+
+		HStringTextIndex index{text};
+		CHECK_EQ(index.text_length(), text.text_length());
+		for (size_t i = 0; i < text.text_length(); i += 3) {
+			CHECK_EQ(index.text_index_to_buffer(i), text.text_index_to_buffer(i));
+			CHECK_EQ(index.at_text(i), text.at_text(text.text_index_to_buffer(i)));
+		}
+		CHECK_EQ(index.text_index_to_buffer(text.text_length()), text.size());
+		for (size_t i = 0; i < text.size(); i += 5) {
+			CHECK_EQ(index.buffer_index_to_text(i), text.buffer_index_to_text(i));
+		}
+
+		// every mutation is followed by reset()
+		text.append(u8"🐓");
+		index.reset();
+		CHECK_EQ(index.text_length(), text.text_length());
+		CHECK_EQ(index.text_index_to_buffer(text.text_length() - 1), text.size() - 4);
+
+		// same data pointer and size, only reset() can tell the text changed
+		HString small{u8"ab"};
+		HStringTextIndex small_index{small};
+		CHECK_EQ(small_index.text_length(), 2);
+		const char8_t* small_data = small.data();
+		small.assign(u8"é");
+		CHECK_EQ(small.data(), small_data);
+		CHECK_EQ(small.size(), 2);
+		small_index.reset();
+		CHECK_EQ(small_index.text_length(), 1);
+		CHECK_EQ(small_index.text_index_to_buffer(1), 2);
+		CHECK_EQ(small_index.buffer_index_to_text(1), 0);
+
+		HString ascii{u8"plain ascii text, long enough to leave the sso buffer"};
+		HStringTextIndex ascii_index{ascii};
+		CHECK_EQ(ascii_index.text_length(), ascii.size());
+		CHECK_EQ(ascii_index.text_index_to_buffer(10), 10);
+		CHECK_EQ(ascii_index.buffer_index_to_text(10), 10);
+		ascii[10] = u8'\xC3';
+		ascii_index.reset();
+		CHECK_EQ(ascii_index.buffer_index_to_text(20), ascii.buffer_index_to_text(20));
+	}
+
+	SUBCASE("memory resource") {
+		struct CountingResource : std::pmr::memory_resource {
+			std::pmr::monotonic_buffer_resource arena;
+			size_t allocated = 0;
+			size_t deallocated = 0;
+
+			void* do_allocate(size_t bytes, size_t alignment) override {
+				allocated += bytes;
+				return arena.allocate(bytes, alignment);
+			}
+
+			void do_deallocate(void*, size_t bytes, size_t) override {
+				deallocated += bytes;
+			}
+
+			bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+				return this == &other;
+			}
+		};
+
+		CountingResource resource;
+		CHECK_EQ(HStringResourceScope::current(), nullptr);
+
+		HString outside{long_literal};
+		CHECK_EQ(outside.memory_resource(), nullptr);
+		{
+			HStringResourceScope scope{&resource};
+			CHECK_EQ(HStringResourceScope::current(), &resource);
+
+			// inline text never allocates
+			HString small{short_literal};
+			CHECK_EQ(small.memory_resource(), nullptr);
+			CHECK_EQ(resource.allocated, 0);
+
+			HString a{long_literal};
+			CHECK_EQ(a.memory_resource(), &resource);
+			CHECK_EQ(a, long_literal);
+			CHECK_GT(resource.allocated, 0);
+
+			// spilling out of sso and copies use the scope
+			small.append(long_literal);
+			CHECK_EQ(small.memory_resource(), &resource);
+			HString copy{outside};
+			CHECK_EQ(copy.memory_resource(), &resource);
+
+			// a heap buffer keeps its allocator when it grows
+			outside.append(long_literal);
+			CHECK_EQ(outside.memory_resource(), nullptr);
+			a.append(long_literal);
+			a.insert(0, long_literal);
+			a.replace(0, 4, long_literal);
+			CHECK_EQ(a.memory_resource(), &resource);
+			CHECK(a.ends_with(long_literal));
+
+			{
+				HStringResourceScope inner{nullptr};
+				HString b{long_literal};
+				CHECK_EQ(b.memory_resource(), nullptr);
+			}
+			CHECK_EQ(HStringResourceScope::current(), &resource);
+
+			HString moved = std::move(a);
+			CHECK_EQ(moved.memory_resource(), &resource);
+			outside = std::move(copy);
+			CHECK_EQ(outside.memory_resource(), &resource);
+		}
+		CHECK_EQ(HStringResourceScope::current(), nullptr);
+		outside = HString{long_literal};
+		CHECK_EQ(outside.memory_resource(), nullptr);
+		// every buffer taken from the resource went back to it
+		CHECK_EQ(resource.deallocated, resource.allocated);
+
+		HString after{long_literal};
+		CHECK_EQ(after.memory_resource(), nullptr);
+	}
+
+	SUBCASE("sso size") {
+		using SmallString = BasicHString<15>;
+		using LargeString = BasicHString<63>;
+
+		CHECK_EQ(sizeof(SmallString), 16);
+		CHECK_EQ(sizeof(HString), 32);
+		CHECK_EQ(sizeof(LargeString), 64);
+
+		SmallString empty;
+		CHECK(empty.is_sso());
+		CHECK_EQ(empty.capacity(), SmallString::SSOCapacity);
+
+		SmallString small_key{u8"key_0123456789"};
+		CHECK(small_key.is_sso());
+		CHECK_EQ(small_key, u8"key_0123456789");
+
+		CHECK(SmallString{short_literal}.is_sso());
+
+		SmallString small{long_literal};
+		CHECK(small.is_heap());
+		CHECK_EQ(small, long_literal);
+		small.append(short_literal);
+		small.insert(0, long_literal);
+		small.erase(0, long_literal.size());
+		CHECK_EQ(small.size(), long_literal.size() + short_literal.size());
+		CHECK(small.starts_with(long_literal));
+		CHECK(small.ends_with(short_literal));
+		CHECK_EQ(small.ToUpper(), HString{small}.ToUpper());
+
+		LargeString large{long_literal};
+		CHECK(large.is_sso());
+		CHECK_EQ(large.capacity(), LargeString::SSOCapacity);
+		large.append(long_literal);
+		CHECK(large.is_heap());
+		CHECK_EQ(large, HString::concat(long_literal, long_literal));
+
+		// the compact heap part splits the capacity around the byte of the sso flag
+		SmallString huge;
+		huge.reserve_exact(20'000'000);
+		CHECK(huge.is_heap());
+		CHECK_EQ(huge.capacity(), 20'000'000);
+		huge.resize(20'000'000, u8'x');
+		CHECK_EQ(huge.size(), 20'000'000);
+		CHECK_EQ(huge.back(), u8'x');
+		CHECK_EQ(huge.max_size(), (size_t{1} << 30) - 1);
+
+		// conversion copies inline text and hands heap buffers over
+		HString from_small{small};
+		CHECK_EQ(from_small, small);
+		CHECK(small == from_small);
+		CHECK(from_small == small);
+
+		const auto* buffer = small.data();
+		HString moved{std::move(small)};
+		CHECK_EQ(moved.data(), buffer);
+		CHECK(small.empty());
+		CHECK(small.is_sso());
+
+		small = std::move(moved);
+		CHECK_EQ(small.data(), buffer);
+		CHECK(moved.empty());
+
+		LargeString from_heap{std::move(small)};
+		CHECK(from_heap.is_heap());
+		CHECK_EQ(from_heap.data(), buffer);
+
+		SmallString from_inline{LargeString{long_literal}};
+		CHECK(from_inline.is_heap());
+		CHECK_EQ(from_inline, long_literal);
+
+		small = from_heap;
+		CHECK_NE(small.data(), from_heap.data());
+		CHECK_EQ(small, from_heap);
+
+		SmallString joined = small_key + HStringView{u8"_suffix"};
+		CHECK_EQ(joined, u8"key_0123456789_suffix");
+		CHECK_EQ(SmallString::join(std::vector<HStringView>{u8"a", u8"b"}, u8","), u8"a,b");
+		CHECK_EQ(Hash<SmallString>{}(small_key), Hash<HString>{}(HString{small_key}));
+
+		{
+			std::pmr::monotonic_buffer_resource arena;
+			HStringResourceScope scope{&arena};
+			SmallString in_arena{long_literal};
+			CHECK_EQ(in_arena.memory_resource(), &arena);
+			CHECK_GE(in_arena.capacity(), long_literal.size());
+
+			HString arena_moved{std::move(in_arena)};
+			CHECK_EQ(arena_moved.memory_resource(), &arena);
+		}
+	}
+}
+
+TEST_CASE("Test HSharedString") {
+	using namespace hana;
+
+	HStringView text{u8"shared text that is long enough to be worth sharing 🐓"};
+
+	SUBCASE("ctor & dtor") {
+		HSharedString empty;
+		CHECK(empty.empty());
+		CHECK_EQ(empty.use_count(), 0);
+		CHECK_EQ(*empty.c_str(), 0);
+
+		HSharedString a{text};
+		CHECK_EQ(a, text);
+		CHECK_EQ(a.use_count(), 1);
+		CHECK_EQ(a.c_str()[a.size()], 0);
+
+		HSharedString b{a};
+		CHECK_EQ(b.data(), a.data());
+		CHECK_EQ(a.use_count(), 2);
+		{
+			HSharedString c = b;
+			CHECK_EQ(a.use_count(), 3);
+		}
+		CHECK_EQ(a.use_count(), 2);
+
+		HSharedString moved{std::move(b)};
+		CHECK(b.empty());
+		CHECK_EQ(moved.data(), a.data());
+		CHECK_EQ(a.use_count(), 2);
+
+		HSharedString from_string{HString{text}};
+		CHECK_EQ(from_string, a);
+		CHECK_NE(from_string.data(), a.data());
+		CHECK_EQ(from_string.str(), HString{text});
+	}
+
+	SUBCASE("assign") {
+		HSharedString a{text};
+		HSharedString b{u8"other"};
+		b = a;
+		CHECK_EQ(b.data(), a.data());
+		CHECK_EQ(a.use_count(), 2);
+		b = b;
+		CHECK_EQ(a.use_count(), 2);
+
+		// assigning text to a shared copy detaches it
+		b = HStringView{u8"detached"};
+		CHECK_EQ(b, HStringView{u8"detached"});
+		CHECK_EQ(a, text);
+		CHECK(a.is_unique());
+
+		// unique buffer with room is reused in place, even for a view into itself
+		const auto* buffer = a.data();
+		a.assign(a.view().subview(7, 4));
+		CHECK_EQ(a, HStringView{u8"text"});
+		CHECK_EQ(a.data(), buffer);
+	}
+
+	SUBCASE("copy on write") {
+		HSharedString a{text};
+		HSharedString b{a};
+
+		b.mutable_data()[0] = u8'S';
+		CHECK_NE(b.data(), a.data());
+		CHECK_EQ(a, text);
+		CHECK_EQ(b.view().subview(1), text.subview(1));
+		CHECK(a.is_unique());
+		CHECK(b.is_unique());
+
+		HSharedString c{a};
+		c.append(u8" and more");
+		CHECK_EQ(a, text);
+		CHECK(c.view().starts_with(text));
+		CHECK(c.view().ends_with(HStringView{u8" and more"}));
+
+		// append of its own text while shared and while unique
+		HSharedString d{a};
+		d.append(d.view());
+		CHECK_EQ(d.size(), text.size() * 2);
+		CHECK_EQ(d.view().subview(text.size()), text);
+		d.append(d.view().subview(0, 6));
+		CHECK(d.view().ends_with(HStringView{u8"shared"}));
+
+		HSharedString e{a};
+		e.clear();
+		CHECK(e.empty());
+		CHECK_EQ(a, text);
+		CHECK(a.is_unique());
+
+		HSharedString empty;
+		empty.append(u8"grown");
+		CHECK_EQ(empty, HStringView{u8"grown"});
+	}
+
+	SUBCASE("overwrite") {
+		// mutable_data is only exclusive until the next copy
+		HSharedString a{text};
+		char8_t* stale = a.mutable_data();
+		HSharedString b{a};
+		stale[0] = u8'S';
+		CHECK_EQ(b.data(), stale);
+		CHECK_EQ(b[0], u8'S');
+
+		// resize_and_overwrite unshares, keeps the prefix and never hands out the shared buffer
+		HSharedString c{text};
+		HSharedString d{c};
+		d.resize_and_overwrite(text.size() + 4, [&](char8_t* out, size_t count) {
+			CHECK_NE(out, c.data());
+			CHECK(HStringView(out, 6) == HStringView{u8"shared"});
+			std::char_traits<char8_t>::copy(out + text.size(), u8" end", 4);
+			return count;
+		});
+		CHECK_EQ(c, text);
+		CHECK(c.is_unique());
+		CHECK(d.view().starts_with(text));
+		CHECK(d.view().ends_with(HStringView{u8" end"}));
+		CHECK_EQ(d.c_str()[d.size()], 0);
+
+		// shrinking in place on a unique buffer
+		const auto* buffer = d.data();
+		d.resize_and_overwrite(6, [](char8_t*, size_t count) { return count; });
+		CHECK_EQ(d, HStringView{u8"shared"});
+		CHECK_EQ(d.data(), buffer);
+
+		HSharedString empty;
+		empty.resize_and_overwrite(3, [](char8_t* out, size_t) {
+			out[0] = u8'a';
+			out[1] = u8'b';
+			return size_t{2};
+		});
+		CHECK_EQ(empty, HStringView{u8"ab"});
+	}
+
+	SUBCASE("compare & hash") {
+		HSharedString a{text};
+		HSharedString b{HString{text}};
+		CHECK_EQ(a, b);
+		CHECK_EQ(Hash<HSharedString>{}(a), Hash<HStringView>{}(text));
+		CHECK_LT(HSharedString{u8"abc"}, HSharedString{u8"abd"});
+		CHECK_GT(HSharedString{u8"b"}, HStringView{u8"abc"});
+	}
+}
+
+TEST_CASE("Test HFixedString") {
+	using namespace hana;
+
+	static_assert(std::is_trivially_copyable_v<HFixedString<31>>);
+	static_assert(sizeof(HFixedString<31>) == 33);
+
+	SUBCASE("ctor & assign") {
+		HFixedString<31> empty;
+		CHECK(empty.empty());
+		CHECK_EQ(*empty.c_str(), 0);
+
+		HFixedString<31> a{u8"thread 🐓"};
+		CHECK_EQ(a, HStringView{u8"thread 🐓"});
+		CHECK_EQ(a.text_length(), 8);
+		CHECK_EQ(a.c_str()[a.size()], 0);
+
+		a = HStringView{u8"worker"};
+		CHECK_EQ(a, HStringView{u8"worker"});
+		CHECK_EQ(a.slack(), 31 - 6);
+
+		// to and from HString
+		HString string{u8"a name that needs the heap of HString"};
+		HFixedString<63> from_string{string};
+		CHECK_EQ(from_string, string);
+		CHECK_EQ(from_string.str(), string);
+		HString back{from_string};
+		CHECK_EQ(back, string);
+	}
+
+	SUBCASE("truncate") {
+		HFixedString<8> cut{u8"abcdefghijk"};
+		CHECK_EQ(cut, HStringView{u8"abcdefgh"});
+
+		// never splits a sequence, 🐓 is 4 code units
+		HFixedString<8> text{u8"abcde🐓"};
+		CHECK_EQ(text, HStringView{u8"abcde"});
+		text.append(u8"fg");
+		CHECK_EQ(text, HStringView{u8"abcdefg"});
+		text.append(u8"hi");
+		CHECK_EQ(text, HStringView{u8"abcdefgh"});
+		text.push_back(u8'x');
+		CHECK_EQ(text.size(), 8);
+		CHECK_EQ(text.c_str()[8], 0);
+	}
+
+	SUBCASE("integer") {
+		HFixedString<31> text;
+		text.append_integer(0).push_back(u8' ');
+		text.append_integer(-42).push_back(u8' ');
+		text.append_integer(std::numeric_limits<int64_t>::min());
+		CHECK_EQ(text, HStringView{u8"0 -42 -9223372036854775808"});
+
+		HFixedString<16> time;
+		time.append_integer(7u, 2).push_back(u8':');
+		time.append_integer(5u, 2).push_back(u8'.');
+		time.append_integer(1234u, 3);
+		CHECK_EQ(time, HStringView{u8"07:05.234"});
+
+		// does not fit, nothing is appended
+		HFixedString<4> small{u8"ab"};
+		small.append_integer(12345u);
+		CHECK_EQ(small, HStringView{u8"ab"});
+		small.append_integer(UINT64_MAX, 2);
+		CHECK_EQ(small, HStringView{u8"ab15"});
+	}
+
+	SUBCASE("search & trim") {
+		HFixedString<31> text{u8"  key = value\t"};
+		CHECK(text.contains(u8"key"));
+		CHECK_EQ(text.find(u8'=').index(), 6);
+		CHECK_EQ(text.rfind(u8"e").index(), 12);
+		CHECK_EQ(text.count(u8"e"), 2);
+
+		CHECK_EQ(text.Trim(), HStringView{u8"key = value"});
+		CHECK_EQ(text.TrimEnd(), HStringView{u8"  key = value"});
+		text.trim();
+		CHECK_EQ(text, HStringView{u8"key = value"});
+		CHECK(text.starts_with(u8"key"));
+		CHECK(text.ends_with(u8'e'));
+
+		const auto [key, sep, value] = text.partition(u8" = ");
+		CHECK_EQ(key, HStringView{u8"key"});
+		CHECK_EQ(value, HStringView{u8"value"});
+
+		text.resize(3);
+		CHECK_EQ(text, HStringView{u8"key"});
+		text.resize(5, u8'!');
+		CHECK_EQ(text, HStringView{u8"key!!"});
+	}
+
+	SUBCASE("constexpr & hash") {
+		constexpr HFixedString<16> name = [] {
+			HFixedString<16> result{u8"  fixed"};
+			result.trim_start();
+			result.append_integer(16);
+			return result;
+		}();
+		static_assert(name == HStringView{u8"fixed16"});
+		static_assert(name.size() == 7);
+
+		CHECK_EQ(Hash<HFixedString<16>>{}(name), Hash<HStringView>{}(HStringView{u8"fixed16"}));
+		CHECK_LT(HFixedString<4>{u8"abc"}, HFixedString<4>{u8"abd"});
+		CHECK_EQ(HFixedString<4>{u8"abc"}, HFixedString<4>{u8"abc"});
+	}
+}
+
+TEST_CASE("Test HName") {
+	using namespace hana;
+
+	SUBCASE("intern") {
+		HName none;
+		CHECK(none.empty());
+		CHECK_EQ(none.size(), 0);
+		CHECK_EQ(*none.c_str(), 0);
+		CHECK_EQ(HName{u8""}, none);
+
+		HName a{u8"HanaBase"};
+		HName b{HStringView{HString{u8"HanaBase"}}};
+		HName c{u8"HanaGraph"};
+		CHECK_FALSE(a.empty());
+		CHECK_EQ(a, b);
+		CHECK_EQ(a.id(), b.id());
+		CHECK_NE(a, c);
+		CHECK_EQ(a.view(), HStringView{u8"HanaBase"});
+		CHECK_EQ(a, HStringView{u8"HanaBase"});
+		CHECK_EQ(c.c_str()[c.size()], 0);
+
+		CHECK_EQ(a.hash(), XXHash::xxhash64(u8"HanaBase", 8));
+		CHECK_EQ(std::hash<HName>{}(a), std::hash<HName>{}(b));
+		CHECK_EQ(Hash<HName>{}(a), static_cast<size_t>(a.hash()));
+
+		CHECK_EQ(HName::find(u8"HanaBase"), a);
+		CHECK(HName::find(u8"never interned name").empty());
+		CHECK(HName::find(u8"").empty());
+	}
+
+	SUBCASE("many") {
+		std::vector<HName> names;
+		for (int i = 0; i < 10000; ++i) {
+			names.emplace_back(HStringView{HString::concat(u8"name_", HString{std::to_string(i).c_str()})});
+		}
+		for (int i = 0; i < 10000; i += 97) {
+			const HString text = HString::concat(u8"name_", HString{std::to_string(i).c_str()});
+			CHECK_EQ(names[i].view(), HStringView{text});
+			CHECK_EQ(HName::find(text), names[i]);
+		}
+		HString long_text;
+		for (int i = 0; i < 2000; ++i) {
+			long_text.append(u8"long ");
+		}
+		CHECK_EQ(HName{long_text}.view(), HStringView{long_text});
+	}
+
+	SUBCASE("concurrent") {
+		constexpr int thread_count = 8;
+		constexpr int name_count = 2000;
+		std::vector<std::vector<HName>> results(thread_count);
+		std::vector<std::thread> threads;
+		for (int t = 0; t < thread_count; ++t) {
+			threads.emplace_back([&, t] {
+				for (int i = 0; i < name_count; ++i) {
+					results[t].emplace_back(HStringView{HString::concat(u8"concurrent_", HString{std::to_string(i).c_str()})});
+				}
+			});
+		}
+		for (auto& thread: threads) {
+			thread.join();
+		}
+		for (int t = 1; t < thread_count; ++t) {
+			CHECK(results[t] == results[0]);
+		}
+		CHECK_EQ(results[0][42].view(), HStringView{u8"concurrent_42"});
+	}
+}
+
+TEST_CASE("Test HRope") {
+	using namespace hana;
+
+	HStringView mixed{u8"🐓鸡ĜG ascii "};
+
+	SUBCASE("ctor & flatten") {
+		HRope empty;
+		CHECK(empty.empty());
+		CHECK_EQ(empty.size(), 0);
+		CHECK_EQ(empty.str(), HString{});
+		CHECK(empty.flatten().empty());
+
+		HString big;
+		while (big.size() < HRope::LeafSize * 5) {
+			big.append(mixed);
+		}
+		HRope rope{big};
+		CHECK_EQ(rope.size(), big.size());
+		CHECK_EQ(rope.text_length(), big.text_length());
+		CHECK_EQ(rope, HStringView{big});
+		CHECK_EQ(rope.str(), big);
+
+		// leaves are cut on code point boundaries
+		size_t chunks = 0;
+		rope.for_each_chunk([&](HStringView chunk) {
+			CHECK_LE(chunk.size(), HRope::LeafSize);
+			CHECK_EQ(chunk.text_length(), unicode::utf8_code_point_count(chunk.data(), chunk.size()));
+			CHECK_NE(chunk[0] & 0xC0, 0x80);
+			++chunks;
+		});
+		CHECK_GT(chunks, 4);
+
+		HRope copy{rope};
+		CHECK_EQ(copy, rope);
+		const HStringView flat = copy.flatten();
+		CHECK_EQ(flat, HStringView{big});
+		CHECK_EQ(copy.flatten().data(), flat.data());
+		CHECK_EQ(rope.size(), big.size());
+
+		// the tree keeps its leaves, only a copy is cached until the next edit
+		size_t flat_chunks = 0;
+		copy.for_each_chunk([&](HStringView chunk) {
+			CHECK_LE(chunk.size(), HRope::LeafSize);
+			++flat_chunks;
+		});
+		CHECK_EQ(flat_chunks, chunks);
+		copy.insert(copy.text_index_to_buffer(copy.text_length() / 2), u8"[mid]");
+		CHECK_EQ(copy.size(), big.size() + 5);
+		CHECK_EQ(copy.flatten(), HStringView{copy.str()});
+		CHECK_NE(copy.flatten(), HStringView{big});
+	}
+
+	SUBCASE("edit") {
+		HRope rope{u8"hello world"};
+		rope.insert(5, u8",");
+		rope.append(u8"!");
+		rope.insert(0, u8">> ");
+		CHECK_EQ(rope, HStringView{u8">> hello, world!"});
+		rope.erase(0, 3);
+		rope.replace(7, 5, u8"rope");
+		CHECK_EQ(rope, HStringView{u8"hello, rope!"});
+		CHECK_EQ(rope.at(4), u8'o');
+		CHECK_EQ(rope[11], u8'!');
+
+		HRope tail = rope.split(5);
+		CHECK_EQ(rope, HStringView{u8"hello"});
+		CHECK_EQ(tail, HStringView{u8", rope!"});
+		rope.append(std::move(tail));
+		CHECK_EQ(rope, HStringView{u8"hello, rope!"});
+		rope.insert(5, HRope{u8" there"});
+		CHECK_EQ(rope, HStringView{u8"hello there, rope!"});
+		rope.erase(5);
+		CHECK_EQ(rope, HStringView{u8"hello"});
+		rope.clear();
+		CHECK(rope.empty());
+	}
+
+	SUBCASE("matches HString") {
+		std::mt19937 rng{42};
+		HString model;
+		HRope rope;
+		const HStringView pieces[] = {u8"a", u8"🐓", u8"鸡ĜG", u8"long piece of ascii text ", u8"\n"};
+		const auto to_buffer = [&](size_t text_index) {
+			return text_index < model.text_length() ? model.text_index_to_buffer(text_index) : model.size();
+		};
+		for (int i = 0; i < 3000; ++i) {
+			const HStringView piece = pieces[rng() % std::size(pieces)];
+			const size_t op = rng() % 4;
+			// edit on code point boundaries
+			const size_t at = to_buffer(rng() % (model.text_length() + 1));
+			if (op < 3 || at == model.size()) {
+				model.insert(at, piece);
+				rope.insert(at, piece);
+			} else {
+				const size_t end = to_buffer(model.buffer_index_to_text(at) + rng() % 8);
+				model.erase(at, end - at);
+				rope.erase(at, end - at);
+			}
+		}
+		CHECK_EQ(rope.size(), model.size());
+		CHECK_EQ(rope.text_length(), model.text_length());
+		CHECK_EQ(rope, HStringView{model});
+
+		for (size_t i = 0; i < model.text_length(); i += 7) {
+			const size_t buffer_index = model.text_index_to_buffer(i);
+			CHECK_EQ(rope.text_index_to_buffer(i), buffer_index);
+			CHECK_EQ(rope.buffer_index_to_text(buffer_index), i);
+			CHECK_EQ(rope.at_text(buffer_index), model.at_text(buffer_index));
+		}
+		CHECK_EQ(rope.text_index_to_buffer(model.text_length()), model.size());
+		CHECK_EQ(rope.buffer_index_to_text(model.size()), model.text_length());
+
+		HRope right = rope.split(rope.size() / 2);
+		CHECK_EQ(rope.size() + right.size(), model.size());
+		rope.append(std::move(right));
+		CHECK_EQ(rope.str(), model);
+	}
+}
+
+TEST_CASE("Test HStringMap") {
+	using namespace hana;
+
+	// equal bytes hash the same in every string type
+	const HString key{u8"a key long enough to live on the heap"};
+	const size_t hash = StringHash{}(key);
+	CHECK_EQ(Hash<HString>{}(key), hash);
+	CHECK_EQ(Hash<HStringView>{}(key), hash);
+	CHECK_EQ(Hash<HSharedString>{}(HSharedString{key}), hash);
+	CHECK_EQ(Hash<HFixedString<64>>{}(HFixedString<64>{key}), hash);
+	CHECK_EQ(Hash<std::u8string_view>{}(HStringView{key}.view()), hash);
+	CHECK_EQ(Hash<std::string>{}(std::string{"a key long enough to live on the heap"}), hash);
+	CHECK_EQ(StringHash{}("a key long enough to live on the heap"), hash);
+	CHECK_EQ(StringHash{}(std::string_view{"a key long enough to live on the heap"}), hash);
+	CHECK_EQ(StringHash{}(std::u8string{u8"a key long enough to live on the heap"}), hash);
+
+	CHECK(StringEqualTo{}(key, "a key long enough to live on the heap"));
+	CHECK(StringEqualTo{}(std::string{"abc"}, u8"abc"));
+	CHECK_FALSE(StringEqualTo{}(HStringView{u8"abc"}, std::u8string_view{u8"abd"}));
+
+	HStringMap<int> map;
+	map.emplace(key, 1);
+	map[HString{u8"short"}] = 2;
+
+	CHECK(map.contains(HStringView{key}));
+	CHECK(map.contains("a key long enough to live on the heap"));
+	CHECK(map.contains(u8"short"));
+	CHECK(map.contains(std::string{"short"}));
+	CHECK_FALSE(map.contains(u8"shorter"));
+
+	auto found = map.find(std::u8string_view{u8"short"});
+	REQUIRE(found != map.end());
+	CHECK_EQ(found->second, 2);
+	CHECK_EQ(map.count(HFixedString<8>{u8"short"}), 1);
+
+	CHECK_EQ(map.erase(HStringView{u8"short"}), 1);
+	CHECK_EQ(map.size(), 1);
+
+	// lookups hash and compare the given key in place; keys are past the SSO size, so a temporary HString would allocate
+	const std::string std_key{"a key long enough to live on the heap"};
+	const HFixedString<64> fixed_key{key};
+	const size_t allocations_before = allocation_count.load();
+	const bool has_literal = map.contains("a key long enough to live on the heap");
+	const bool has_u8_literal = map.contains(u8"a key long enough to live on the heap");
+	const bool has_std = map.contains(std_key);
+	const bool has_missing = map.contains(u8"a key long enough to live on the heap, but missing");
+	const bool found_view = map.find(std::u8string_view{u8"a key long enough to live on the heap"}) != map.end();
+	const size_t fixed_count = map.count(fixed_key);
+	const size_t erased = map.erase(HStringView{u8"a key long enough to live on the heap"});
+	const size_t lookup_allocations = allocation_count.load() - allocations_before;
+	CHECK_EQ(lookup_allocations, 0);
+	CHECK(has_literal);
+	CHECK(has_u8_literal);
+	CHECK(has_std);
+	CHECK_FALSE(has_missing);
+	CHECK(found_view);
+	CHECK_EQ(fixed_count, 1);
+	CHECK_EQ(erased, 1);
+	CHECK(map.empty());
+
+	HStringSet set{HString{u8"alpha"}, HString{u8"beta"}};
+	CHECK(set.contains(u8"alpha"));
+	CHECK(set.contains(std::string_view{"beta"}));
+	CHECK_FALSE(set.contains("gamma"));
 }
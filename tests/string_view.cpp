@@ -1,6 +1,13 @@
 #include <doctest/doctest.h>
 #include <hana/container/string_view.hpp>
 
+#include <span>
+#include <array>
+#include <string>
+#include <vector>
+#include <ranges>
+#include <algorithm>
+
 TEST_CASE("Test HStringView") {
 	using namespace hana;
 	using namespace hana::unicode;
@@ -157,6 +164,34 @@ TEST_CASE("Test HStringView") {
 		CHECK_EQ(found_seq, 5);
 		CHECK_EQ(found_last_view, 35);
 		CHECK_EQ(found_last_seq, 35);
+
+		// the vector kernels against std::u8string_view, with matches and near misses across block borders
+		std::u8string text;
+		for (int i = 0; i < 20; ++i) {
+			text += u8"GET /index.html 200 🐓\tkey=value; ";
+		}
+		text += u8"needle#";
+		const HStringView long_view{text.data(), text.size()};
+		const std::u8string_view std_view{text};
+		const auto index = [](auto found) { return found ? found.index() : HStringView::npos; };
+
+		const std::u8string_view patterns[] = {u8"needle", u8"key=value", u8"🐓", u8"200 🐓\t", u8"; GET", u8"nope", u8"e", u8"", u8"html 404"};
+		for (const auto pattern: patterns) {
+			for (size_t pos = 0; pos <= text.size() + 1; pos += 13) {
+				CHECK_EQ(index(long_view.find(HStringView{pattern.data(), pattern.size()}, pos)), std_view.find(pattern, pos));
+			}
+		}
+
+		const std::u8string_view sets[] = {u8" \t", u8";=", u8"\xF0", u8"/.=;\t \xF0", u8"abcdefghijklmnopqrstuvwxyz", u8"", u8"!"};
+		for (const auto set: sets) {
+			const HStringView set_view{set.data(), set.size()};
+			for (size_t pos = 0; pos <= text.size() + 1; pos += 7) {
+				CHECK_EQ(index(long_view.find_first_of(set_view, pos)), std_view.find_first_of(set, pos));
+				CHECK_EQ(index(long_view.find_first_not_of(set_view, pos)), std_view.find_first_not_of(set, pos));
+			}
+		}
+		// a long run of set members before the first miss
+		CHECK_EQ(index(long_view.find_first_not_of(HStringView{u8"GET /index.html200🐓\tkey=value;"})), text.size() - 1);
 	}
 
 	SUBCASE("contains & count") {
@@ -272,6 +307,79 @@ TEST_CASE("Test HStringView") {
 		CHECK_EQ(bad.trim_invalid_end(), trim_end);
 	}
 
+	SUBCASE("case-insensitive") {
+		HStringView header{u8"Content-Type"};
+
+		// iequals
+		CHECK(header.iequals(u8"content-type"));
+		CHECK(header.iequals(u8"CONTENT-TYPE"));
+		CHECK_FALSE(header.iequals(u8"content-typ"));
+		CHECK_FALSE(header.iequals(u8"content_type"));
+		CHECK(HStringView{}.iequals(u8""));
+		CHECK(HStringView{u8"Straße ΣΑΣ"}.iequals(u8"STRAßE σας"));
+		CHECK(HStringView{u8"\u212Aelvin"}.iequals(u8"kELVIN"));
+		CHECK_FALSE(HStringView{u8"Strasse"}.iequals(u8"Straße"));
+
+		// icompare
+		CHECK_EQ(header.icompare(u8"CONTENT-TYPE"), 0);
+		CHECK_LT(header.icompare(u8"content-typf"), 0);
+		CHECK_GT(header.icompare(u8"CONTENT-TYPd"), 0);
+		CHECK_LT(header.icompare(u8"content-type-options"), 0);
+		CHECK_GT(header.icompare(u8"content"), 0);
+		CHECK_LT(HStringView{u8"apple"}.icompare(u8"Banana"), 0);
+		CHECK_LT(HStringView{u8"ä"}.icompare(u8"Ö"), 0);
+
+		// long text goes through the vector blocks, mismatches in and after them
+		std::u8string long_lower = u8"the quick brown fox jumps over the lazy dog, the quick brown fox jumps over the lazy dog";
+		std::u8string long_upper = u8"THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG, THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG";
+		HStringView long_view{long_lower.data(), long_lower.size()};
+		CHECK(long_view.iequals({long_upper.data(), long_upper.size()}));
+		CHECK_EQ(long_view.icompare({long_upper.data(), long_upper.size()}), 0);
+		std::u8string long_other = long_upper;
+		long_other[40] = u8'!';
+		CHECK_FALSE(long_view.iequals({long_other.data(), long_other.size()}));
+		CHECK_GT(long_view.icompare({long_other.data(), long_other.size()}), 0);
+		long_other = long_upper;
+		long_other.back() = u8'_';
+		CHECK_FALSE(long_view.iequals({long_other.data(), long_other.size()}));
+
+		HStringView long_greek = u8"ΑΒΓΔΕΖΗΘΙΚΛΜΝΞΟΠΡΣΤΥΦΧΨΩ and some ascii after the greek letters to fill a block or two";
+		CHECK(long_greek.iequals(u8"αβγδεζηθικλμνξοπρστυφχψω AND SOME ASCII AFTER THE GREEK LETTERS TO FILL A BLOCK OR TWO"));
+
+		// ill-formed code units only match themselves
+		const char8_t bad_a[] = {u8'a', 0xFF, u8'b', 0};
+		const char8_t bad_b[] = {u8'A', 0xFF, u8'B', 0};
+		const char8_t bad_c[] = {u8'A', 0xFE, u8'B', 0};
+		CHECK(HStringView{bad_a}.iequals(bad_b));
+		CHECK_FALSE(HStringView{bad_a}.iequals(bad_c));
+		CHECK_NE(HStringView{bad_a}.icompare(bad_c), 0);
+		CHECK_FALSE(HStringView{bad_a}.iequals(u8"a\uFFFDb"));
+
+		// ifind
+		HStringView text{u8"Accept: text/html\r\nCONTENT-TYPE: text/plain\r\ncontent-length: 42"};
+		CHECK_EQ(text.ifind(u8"content-type").index(), 19);
+		CHECK_EQ(text.ifind(u8"Content-Length").index(), 45);
+		CHECK_EQ(text.ifind(u8"content", 20).index(), 45);
+		CHECK_EQ(text.ifind(u8"TEXT/").index(), 8);
+		CHECK_EQ(text.ifind(u8"").index(), 0);
+		CHECK_FALSE(text.ifind(u8"content-encoding").is_valid());
+		CHECK_FALSE(text.ifind(u8"accept", 1).is_valid());
+		CHECK_FALSE(text.ifind(u8"a", text.size() + 1).is_valid());
+
+		HStringView unicode_text{u8"鸡 Straße 🐓 ΣΟΦΊΑ \u212Aitchen σοφία"};
+		CHECK_FALSE(unicode_text.ifind(u8"STRASSE").is_valid());
+		CHECK_EQ(unicode_text.ifind(u8"STRAßE").index(), 4);
+		CHECK_EQ(unicode_text.ifind(u8"σοφία").index(), 17);
+		CHECK_EQ(unicode_text.ifind(u8"σοφία", 19).index(), 38);
+		CHECK_EQ(unicode_text.ifind(u8"kitchen").index(), 28);
+		CHECK_EQ(unicode_text.ifind(u8"🐓").index(), 12);
+
+		HStringView haystack{u8"0123456789abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz NeedLE"};
+		CHECK_EQ(haystack.ifind(u8"needle").index(), haystack.size() - 6);
+		CHECK_EQ(haystack.ifind(u8"XYZ0").index(), 33);
+		CHECK_FALSE(haystack.ifind(u8"XYZ0", 34).is_valid());
+	}
+
 	SUBCASE("partition") {
 		SUBCASE("view partition") {
 			// util
@@ -433,6 +541,58 @@ TEST_CASE("Test HStringView") {
 				3);
 			CHECK_EQ(count, 3);
 		}
+
+		SUBCASE("lazy split") {
+			const auto pieces = view.split_view(split_view);
+			static_assert(std::ranges::forward_range<decltype(pieces)>);
+			static_assert(std::ranges::borrowed_range<decltype(pieces)>);
+			CHECK(std::ranges::equal(pieces, split_result));
+			CHECK(std::ranges::equal(view.split_view(split_view, true), split_result_cull_empty));
+			CHECK(std::ranges::equal(view.split_view(split_view) | std::views::take(3), std::span{split_result, 3}));
+
+			std::vector<HStringView> collected;
+			CHECK_EQ(view.split(collected, u8","), std::ranges::distance(view.split_view(u8",")));
+			for (const HStringView text: {HStringView{}, HStringView{u8","}, HStringView{u8",,a,,b,"}, HStringView{u8"a"}}) {
+				for (const bool cull_empty: {false, true}) {
+					collected.clear();
+					text.split(collected, u8",", cull_empty);
+					CHECK(std::ranges::equal(text.split_view(u8",", cull_empty), collected));
+				}
+			}
+
+			// an empty delimiter does not split
+			CHECK(std::ranges::equal(view.split_view(u8""), std::array{view}));
+
+			auto sizes = HStringView{u8"a,bb,,ccc"}.split_view(u8",") | std::views::transform(&HStringView::size);
+			CHECK(std::ranges::equal(sizes, std::array{1, 2, 0, 3}));
+
+			// iteration stops without looking at the rest of the text
+			auto it = view.split_view(split_view).begin();
+			CHECK_EQ(*it, split_result[0]);
+			CHECK_EQ(*++it, split_result[1]);
+		}
+
+		SUBCASE("tokens") {
+			HStringView text{u8"  let\tx =\r\n 42;  "};
+			CHECK(std::ranges::equal(text.tokens(), std::array<HStringView, 4>{u8"let", u8"x", u8"=", u8"42;"}));
+			CHECK(std::ranges::equal(text.tokens(u8" ;="), std::array<HStringView, 3>{u8"let\tx", u8"\r\n", u8"42"}));
+			CHECK(text.tokens(u8" \t\r\n=;x4let2").empty());
+			CHECK(HStringView{}.tokens().empty());
+			CHECK(std::ranges::equal(HStringView{u8"🐓 鸡"}.tokens(), std::array<HStringView, 2>{u8"🐓", u8"鸡"}));
+		}
+
+		SUBCASE("lines") {
+			CHECK(std::ranges::equal(HStringView{u8"a\r\nbb\n\nccc"}.lines(), std::array<HStringView, 4>{u8"a", u8"bb", u8"", u8"ccc"}));
+			CHECK(std::ranges::equal(HStringView{u8"a\n\r\n"}.lines(), std::array<HStringView, 2>{u8"a", u8""}));
+			CHECK(std::ranges::equal(HStringView{u8"\n"}.lines(), std::array<HStringView, 1>{u8""}));
+			CHECK(std::ranges::equal(HStringView{u8"a\r"}.lines(), std::array<HStringView, 1>{u8"a"}));
+			CHECK(HStringView{}.lines().empty());
+
+			auto non_empty = HStringView{u8"x\n\n  y\n"}.lines()
+						   | std::views::transform([](HStringView line) { return line.trim(); })
+						   | std::views::filter([](HStringView line) { return !line.empty(); });
+			CHECK(std::ranges::equal(non_empty, std::array<HStringView, 2>{u8"x", u8"y"}));
+		}
 	}
 
 	SUBCASE("text index") {
@@ -30,6 +30,12 @@ elseif (is_os("IOS")) then
     add_defines("HANA_OS_IOS")
 end
 
+option("fmt_no_locale")
+    set_default(false)
+    set_showmenu(true)
+    set_description("Compile std::locale support (locale overloads and the 'L' spec) out of hana::fmt")
+option_end()
+
 default_unity_batch = 16
 
 includes("xmake/compile_flags.lua")